@@ -0,0 +1,43 @@
+// Six analog track occupancy sensors read by the background ADC scan engine (zero blocking loop)
+// Jørgen Bo Madsen / october 2026 / https://github.com/jebmdk
+
+#include <MTD2A.h>
+using namespace MTD2A_const;
+
+// Object name, 1 second LAST_TIME delay
+MTD2A_analog_input track[6] {
+  {"Track 1", 1000}, {"Track 2", 1000}, {"Track 3", 1000},
+  {"Track 4", 1000}, {"Track 5", 1000}, {"Track 6", 1000}
+};
+const byte TRACK_PINS[6] {A0, A1, A2, A3, A4, A5};
+
+MTD2A_adc_scan_entry adcScanTable[6];  // One scan channel per track
+
+// Benchmark: max MTD2A_loop_execute () time with analogRead () in the loop and with the ADC scan engine
+void benchmark (const __FlashStringHelper *benchmarkText) {
+  MTD2A::get_maxElapsedTimeUS ();  // Reset measurement
+  for (int loopCount = 0; loopCount < 100; loopCount++)
+    MTD2A_loop_execute ();
+  Serial.print (benchmarkText); Serial.print (MTD2A::get_maxElapsedTimeUS ()); Serial.println (F(" us max loop time"));
+}
+
+void setup() {
+  Serial.begin(9600);
+  while (!Serial) { delay(10); } // ESP32 Serial Monitor ready delay
+
+  MTD2A::set_globalDelayTimeMS (DELAY_1MS);  // 1 ms cadence: 6 * analogRead () is about 0.7 ms on AVR
+  for (byte index = 0; index < 6; index++) {
+    track[index].initialize (TRACK_PINS[index], 300, 20, INVERTED);  // Current sense: above threshold is occupied
+    track[index].set_debugPrint ();
+  }
+  benchmark (F("analogRead (): "));
+  MTD2A_globalAdcScan (adcScanTable, 6);
+  for (byte index = 0; index < 6; index++)
+    track[index].set_adcScan ();  // Conversion complete interrupt (AVR) round robin
+  benchmark (F("ADC scan    : "));
+  Serial.print (F("ADC scan rounds: ")); Serial.println (MTD2A::get_globalAdcScanCount ());
+}
+
+void loop() {
+  MTD2A_loop_execute ();  // Update the state (event) system
+} // Six analog track occupancy sensors read by the background ADC scan engine
@@ -0,0 +1,48 @@
+// Analog sensor (LDR, reflective IR or current sense) with threshold, hysteresis and oversampling
+// Jørgen Bo Madsen / october 2026 / https://github.com/jebmdk
+
+#include <MTD2A.h>
+using namespace MTD2A_const;
+
+MTD2A_analog_input  LDR_sensor ("LDR sensor", 2000);  // 2 seconds LAST_TIME delay, like MTD2A_binary_input
+MTD2A_binary_output red_LED    ("Red LED", 500);      // 0.5 second on
+
+// LDR to ground, 10 kOhm resistor to 5V. Shadow (train) = higher voltage.
+// Pin state HIGH at threshold + hysteresis, LOW at threshold - hysteresis. INVERTED: HIGH is active
+const uint16_t THRESHOLD  = 600;
+const uint16_t HYSTERESIS = 25;
+
+uint32_t printTimeMS = 0;
+
+void setup() {
+  Serial.begin(9600); 
+  while (!Serial) { delay(10); } // ESP32 Serial Monitor ready delay
+
+  byte LDR_PIN     = A0;  // Analog input pin
+  byte RED_LED_PIN = 9;   // Output Arduino board pin 9
+  LDR_sensor.initialize (LDR_PIN, THRESHOLD, HYSTERESIS, INVERTED);
+  LDR_sensor.set_debugPrint ();
+  red_LED.initialize (RED_LED_PIN);
+
+  // Benchmark: analogRead () cost per loop with 1 and 16 samples (about 112 us per sample on AVR)
+  for (byte samples = 1; samples <= MAX_OVERSAMPLING; samples += 15) {
+    LDR_sensor.set_oversampling (samples);
+    MTD2A_loop_execute ();
+    Serial.print (F("Oversampling ")); Serial.print (samples);
+    Serial.print (F(": ")); Serial.print (LDR_sensor.get_sampleTimeUS ()); Serial.println (F(" us per loop"));
+  }
+  LDR_sensor.set_oversampling (4);  // Mean of 4 samples per loop
+}
+
+void loop() {
+  if (LDR_sensor.get_phaseChange() == true  &&  LDR_sensor.get_phaseNumber() == FIRST_TIME_PHASE)
+    red_LED.activate ();
+
+  if (millis() - printTimeMS >= 1000) {
+    printTimeMS = millis();
+    Serial.print (F("analogValue: ")); Serial.print (LDR_sensor.get_analogValue ());
+    Serial.print (F("  sampleTimeUS: ")); Serial.println (LDR_sensor.get_sampleTimeUS ());
+  }
+
+  MTD2A_loop_execute ();  // Update the state (event) system
+} // Analog sensor with threshold, hysteresis and oversampling
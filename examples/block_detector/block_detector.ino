@@ -0,0 +1,46 @@
+// Block occupancy detection by track current (DCC or PWM) with windowed RMS and peak detection
+// Jørgen Bo Madsen / october 2026 / https://github.com/jebmdk
+
+#include <MTD2A.h>
+using namespace MTD2A_const;
+
+// Current sensor per block, e.g. ACS712 (output VCC/2 at zero current) or a current transformer with bias.
+// 2 seconds LAST_TIME delay: the block stays occupied while a dirty wheel loses contact.
+MTD2A_current_detector block[4] {
+  {"Block 1", 2000}, {"Block 2", 2000}, {"Block 3", 2000}, {"Block 4", 2000}
+};
+const byte BLOCK_PINS[4] {A0, A1, A2, A3};
+
+MTD2A_adc_scan_entry adcScanTable[4];  // One ADC scan channel per block
+
+// RMS level in ADC steps (10 bit: 4.9 mV). Occupied above THRESHOLD + HYSTERESIS, free below THRESHOLD - HYSTERESIS
+const uint16_t THRESHOLD  = 12;
+const uint16_t HYSTERESIS = 3;
+
+uint32_t printTimeMS = 0;
+
+void setup() {
+  Serial.begin(9600);
+  while (!Serial) { delay(10); } // ESP32 Serial Monitor ready delay
+
+  MTD2A_globalAdcScan (adcScanTable, 4);  // Before initialize (). Without a table: one analogRead () per loop (warning 134)
+  for (byte index = 0; index < 4; index++) {
+    // 20 ms window: one 50 Hz PWM period or about 100 DCC bits. Samples from the ADC scan engine
+    block[index].initialize (BLOCK_PINS[index], THRESHOLD, HYSTERESIS, DETECT_RMS, 20);
+    block[index].set_debugPrint ();
+  }
+  block[3].set_detectMode (DETECT_PEAK, 20);  // Peak detection for comparison
+}
+
+void loop() {
+  if (millis() - printTimeMS >= 1000) {
+    printTimeMS = millis();
+    for (byte index = 0; index < 4; index++) {
+      Serial.print (F("Level: ")); Serial.print (block[index].get_analogValue ());
+      Serial.print (F(" / ")); Serial.print (block[index].get_windowSamples ()); Serial.print (F(" samples   "));
+    }
+    Serial.println ();
+  }
+
+  MTD2A_loop_execute ();  // Update the state (event) system
+} // Block occupancy detection by track current
@@ -0,0 +1,40 @@
+// Timing parameters from a configuration block in EEPROM. Change them live from the Serial Monitor
+// Jørgen Bo Madsen / october 2026 / https://github.com/jebmdk
+// Boards with an EEPROM library (AVR, ESP32, ESP8266)
+
+#include <MTD2A.h>
+#include <EEPROM.h>
+using namespace MTD2A_const;
+
+MTD2A_binary_input  FC_51_sensor ("FC-51 sensor", 2000);  // Object index 0. Default 2 seconds LAST_TIME delay
+MTD2A_binary_output red_LED      ("Red LED", 500);        // Object index 1. Default 0.5 second on
+
+// Serial Monitor (Newline): "C objectIndex fieldId value". Reply "OK" or "ERROR number"
+//   C 1 5 1500  -> Red LED outputTimeMS (CONFIG_OUTPUT_TIME = 5) 1.5 seconds
+//   C 0 3 5000  -> FC-51 sensor delayTimeMS (CONFIG_DELAY_TIME = 3) 5 seconds
+//   C 1 1 10    -> Red LED pin 10 (CONFIG_PIN_NUMBER = 1) after restart
+// Fields are stored in EEPROM and applied at the next start before initialize ().
+
+void setup() {
+  Serial.begin(9600); 
+  while (!Serial) { delay(10); } // ESP32 Serial Monitor ready delay
+#if defined(ESP32) || defined(ESP8266)
+  EEPROM.begin(512);  // Flash emulated EEPROM. Before MTD2A_globalConfig () (EEPROM.length () is 0 until begin)
+#endif
+
+  MTD2A_globalConfig (0, 1);        // EEPROM address 0, configuration version 1 (blank EEPROM = defaults)
+  MTD2A_globalConfigPort (Serial);  // Live update of single fields
+
+  byte FC_51_PIN   = 2;  // Input Arduino board pin 2
+  byte RED_LED_PIN = 9;  // Output Arduino board pin 9 (unless CONFIG_PIN_NUMBER is set)
+  FC_51_sensor.initialize (FC_51_PIN);
+  red_LED.initialize      (RED_LED_PIN);
+  MTD2A_print_conf ();
+}
+
+void loop() {
+  if (FC_51_sensor.get_phaseChange() == true  &&  FC_51_sensor.get_phaseNumber() == FIRST_TIME_PHASE)
+    red_LED.activate ();
+
+  MTD2A_loop_execute ();  // Update the state (event) system and read configuration commands
+} // Timing parameters from a configuration block in EEPROM
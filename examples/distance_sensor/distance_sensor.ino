@@ -0,0 +1,47 @@
+// Non blocking ultrasonic distance sensors (HC-SR04) at the end of two sidings. No pulseIn ()
+// Jørgen Bo Madsen / october 2026 / https://github.com/jebmdk
+
+#include <MTD2A.h>
+using namespace MTD2A_const;
+
+// Stop a train 80 mm before the buffer stop. 1 second LAST_TIME delay for short distance dropouts
+MTD2A_distance_input siding1 {"Siding 1", 1000};
+MTD2A_distance_input siding2 {"Siding 2", 1000};
+MTD2A_binary_output  red_LED1 {"Red LED 1", 500};  // 0.5 second on
+MTD2A_binary_output  red_LED2 {"Red LED 2", 500};
+
+// Near below THRESHOLD_MM - HYSTERESIS_MM, far above THRESHOLD_MM + HYSTERESIS_MM
+const uint16_t THRESHOLD_MM  = 80;
+const uint16_t HYSTERESIS_MM = 10;
+
+uint32_t printTimeMS = 0;
+
+void setup() {
+  Serial.begin(9600);
+  while (!Serial) { delay(10); } // ESP32 Serial Monitor ready delay
+
+  // Trigger pin, echo pin. Echo: external interrupt pin, or any pin change interrupt pin on AVR (UNO / Nano: 2 - 13, A0 - A5)
+  siding1.initialize (7, 2, THRESHOLD_MM, HYSTERESIS_MM);
+  siding2.initialize (8, 4, THRESHOLD_MM, HYSTERESIS_MM);
+  red_LED1.initialize (10);
+  red_LED2.initialize (11);
+  siding1.set_debugPrint ();
+  siding2.set_debugPrint ();
+}
+
+void loop() {
+  // The sensors ping one at a time (no crosstalk). Distance updates every 40 - 140 ms per sensor
+  if (siding1.get_phaseChange() == true  &&  siding1.get_phaseNumber() == FIRST_TIME_PHASE)
+    red_LED1.activate ();
+  if (siding2.get_phaseChange() == true  &&  siding2.get_phaseNumber() == FIRST_TIME_PHASE)
+    red_LED2.activate ();
+
+  if (millis() - printTimeMS >= 1000) {
+    printTimeMS = millis();
+    Serial.print (F("Siding 1: ")); Serial.print (siding1.get_distanceMM ()); Serial.print (F(" mm   "));
+    Serial.print (F("Siding 2: ")); Serial.print (siding2.get_distanceMM ()); Serial.print (F(" mm   "));
+    Serial.print (F("Max loop time: ")); Serial.print (MTD2A::get_maxElapsedTimeUS ()); Serial.println (F(" us"));
+  }
+
+  MTD2A_loop_execute ();  // Update the state (event) system
+} // Non blocking ultrasonic distance sensors
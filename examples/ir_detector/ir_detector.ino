@@ -0,0 +1,47 @@
+// Modulated IR train detection. Not fooled by ambient and layout lighting (synchronous detection)
+// Jørgen Bo Madsen / october 2026 / https://github.com/jebmdk
+
+#include <MTD2A.h>
+using namespace MTD2A_const;
+
+// FC-51 or TCRT5000 module with the IR LED wired to an output pin (remove the LED resistor link to VCC),
+// or a bare IR LED (with resistor) and a phototransistor to ground (INPUT_PULLUP).
+// The two sensors use orthogonal codes and can see each other's LED without false detection.
+MTD2A_ir_input      IR_sensor1 ("IR sensor 1", 500);  // 0.5 second LAST_TIME delay
+MTD2A_ir_input      IR_sensor2 ("IR sensor 2", 500);
+MTD2A_binary_output red_LED    ("Red LED", 500);      // 0.5 second on
+
+MTD2A_ir_channel irChannels[2];  // One demodulator channel per MTD2A_ir_input
+
+// Signal level in percent of a perfect reflection. Present at THRESHOLD + HYSTERESIS, free at THRESHOLD - HYSTERESIS
+const uint8_t THRESHOLD  = 40;
+const uint8_t HYSTERESIS = 10;
+
+uint32_t printTimeMS = 0;
+
+void setup() {
+  Serial.begin(9600);
+  while (!Serial) { delay(10); } // ESP32 Serial Monitor ready delay
+
+  MTD2A_globalIrChannels (irChannels, 2);  // Before initialize ()
+  // IR LED pin, receiver pin. Receiver LOW on IR light (NORMAL)
+  IR_sensor1.initialize (6, 2, THRESHOLD, HYSTERESIS);
+  IR_sensor2.initialize (7, 3, THRESHOLD, HYSTERESIS);
+  red_LED.initialize (9);
+  IR_sensor1.set_debugPrint ();
+  IR_sensor2.set_debugPrint ();
+}
+
+void loop() {
+  if ((IR_sensor1.get_phaseChange() == true  &&  IR_sensor1.get_phaseNumber() == FIRST_TIME_PHASE)  ||
+      (IR_sensor2.get_phaseChange() == true  &&  IR_sensor2.get_phaseNumber() == FIRST_TIME_PHASE))
+    red_LED.activate ();
+
+  if (millis() - printTimeMS >= 1000) {
+    printTimeMS = millis();
+    Serial.print (F("Signal 1: ")); Serial.print (IR_sensor1.get_signalLevel ()); Serial.print (F(" %   "));
+    Serial.print (F("Signal 2: ")); Serial.print (IR_sensor2.get_signalLevel ()); Serial.println (F(" %"));
+  }
+
+  MTD2A_loop_execute ();  // Update the state (event) system
+} // Modulated IR train detection
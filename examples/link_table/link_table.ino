@@ -0,0 +1,38 @@
+// Sensor, LED and timer wired together with a link table (no code in loop)
+// Jørgen Bo Madsen / october 2026 / https://github.com/jebmdk
+
+#include <MTD2A.h>
+using namespace MTD2A_const;
+
+MTD2A_binary_input  FC_51_sensor ("FC-51 sensor", 2000); // 2 seconds LAST_TIME delay
+MTD2A_binary_output red_LED      ("Red LED", 3000);      // 3 seconds on
+MTD2A_timer         wait_timer   ("Wait timer", 5000);   // 5 seconds
+MTD2A_binary_output green_LED    ("Green LED", 1000);    // 1 second on
+
+MTD2A_link_entry linkTable[4];  // One entry per MTD2A_link
+
+void setup() {
+  Serial.begin(9600); 
+  while (!Serial) { delay(10); } // ESP32 Serial Monitor ready delay
+
+  byte FC_51_PIN     = 2;   // Input Arduino board pin 2
+  byte RED_LED_PIN   = 9;   // Output Arduino board pin 9
+  byte GREEN_LED_PIN = 10;  // Output Arduino board pin 10
+  FC_51_sensor.initialize (FC_51_PIN);
+  red_LED.initialize      (RED_LED_PIN);
+  green_LED.initialize    (GREEN_LED_PIN);
+
+  MTD2A_globalLink (linkTable, 4);
+  // Sensor activated: red LED on. Red LED off: start timer. Timer stopped: green LED on
+  MTD2A_link (FC_51_sensor, FIRST_TIME_PHASE, red_LED,    LINK_ACTIVATE);
+  MTD2A_link (red_LED,      COMPLETE_PHASE,   wait_timer, LINK_ACTIVATE);
+  MTD2A_link (wait_timer,   STOP_TIMER,       green_LED,  LINK_ACTIVATE);
+  // New train while waiting: reset timer
+  MTD2A_link (FC_51_sensor, FIRST_TIME_PHASE, wait_timer, LINK_RESET);
+
+  MTD2A_globalDebugPrint ();
+}
+
+void loop() {
+  MTD2A_loop_execute ();  // Update the state (event) system and execute links
+} // Sensor, LED and timer wired together with a link table
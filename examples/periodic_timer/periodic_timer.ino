@@ -0,0 +1,55 @@
+// Periodic (auto reload) timers with expiry callback and overrun count
+// Jørgen Bo Madsen / october 2026 / https://github.com/jebmdk
+
+// A periodic timer reloads from its own deadline, not from the loop that noticed the expiry: no drift.
+// Each period ends with a STOP_TIMER phase change (one loop) and the timer continues ACTIVE until timer (STOP_TIMER).
+// get_overrunCount () counts whole periods missed when the loop was late (blocking code).
+
+#include <MTD2A.h>
+using namespace MTD2A_const;
+
+const uint8_t LED_PIN = 8;
+
+MTD2A_timer blinkTimer  ("Blink timer",  250);  // 0.25 second
+MTD2A_timer reportTimer ("Report timer", 5000); // 5 seconds
+
+MTD2A_callback_entry callbackTable[1];  // One entry per object with a callback
+
+bool     ledState    = LOW;
+uint16_t reportCount = 0;
+
+// Called at the expiry of each period (same loop as the phase change)
+void blink_expire (const uint8_t phaseNumber, void *callbackContext) {
+  (void)phaseNumber;
+  bool *blinkState = static_cast<bool*>(callbackContext);
+  *blinkState = !*blinkState;
+  digitalWrite(LED_PIN, *blinkState);
+}
+
+void setup() {
+  Serial.begin(9600);
+  while (!Serial) { delay(10); } // ESP32 Serial Monitor ready delay
+  pinMode(LED_PIN, OUTPUT);
+
+  MTD2A_globalCallback (callbackTable, 1);
+  blinkTimer.set_periodic ();
+  blinkTimer.set_callback (blink_expire, &ledState, (1 << STOP_TIMER));
+  blinkTimer.timer (START_TIMER);
+
+  reportTimer.set_periodic ();
+  reportTimer.timer (START_TIMER);
+}
+
+void loop() {
+  // Polling instead of callback
+  if (reportTimer.get_phaseChange() == true  &&  reportTimer.get_phaseNumber() == STOP_TIMER) {
+    reportCount++;
+    Serial.print (F("Blinks: "));            Serial.print (blinkTimer.get_phaseCount (STOP_TIMER));
+    Serial.print (F("  Missed periods: "));  Serial.println (blinkTimer.get_overrunCount ());
+    // Every third report blocks the loop for 0.6 second: 2 blink periods are missed, the blink rhythm is kept
+    if (reportCount % 3 == 0)
+      delay(600);
+  }
+
+  MTD2A_loop_execute ();  // Update the state (event) system
+} // Periodic timers
@@ -0,0 +1,36 @@
+// Sensor activates a LED from a phase change callback (no polling in loop)
+// Jørgen Bo Madsen / october 2026 / https://github.com/jebmdk
+
+#include <MTD2A.h>
+using namespace MTD2A_const;
+
+MTD2A_binary_input  FC_51_sensor ("FC-51 sensor", 2000); // 2 seconds LAST_TIME delay
+MTD2A_binary_output red_LED      ("Red LED", 3000);      // 3 seconds on
+
+MTD2A_callback_entry callbackTable[1];  // One entry per object with a callback
+
+// Called by MTD2A_loop_execute () in the same loop as the phase change
+void sensor_event (const uint8_t phaseNumber, void *callbackContext) {
+  MTD2A_binary_output *LED = (MTD2A_binary_output *)callbackContext;
+  if (phaseNumber == FIRST_TIME_PHASE)
+    LED->activate ();
+  else
+    Serial.println("Sensor complete");
+}
+
+void setup() {
+  Serial.begin(9600); 
+  while (!Serial) { delay(10); } // ESP32 Serial Monitor ready delay
+
+  byte FC_51_PIN   = 2;  // Input Arduino board pin 2
+  byte RED_LED_PIN = 9;  // Output Arduino board pin 9
+  FC_51_sensor.initialize (FC_51_PIN);
+  red_LED.initialize      (RED_LED_PIN);
+  MTD2A_globalCallback (callbackTable, 1);
+  // Only FIRST_TIME_PHASE and COMPLETE_PHASE
+  FC_51_sensor.set_callback (sensor_event, &red_LED, (1 << FIRST_TIME_PHASE) | (1 << COMPLETE_PHASE));
+}
+
+void loop() {
+  MTD2A_loop_execute ();  // Update the state (event) system
+} // Sensor activates a LED from a phase change callback
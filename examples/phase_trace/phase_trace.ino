@@ -0,0 +1,32 @@
+// Phase changes of a sensor and a LED recorded in a binary trace buffer and printed a few events per loop
+// Jørgen Bo Madsen / october 2026 / https://github.com/jebmdk
+
+#include <MTD2A.h>
+using namespace MTD2A_const;
+
+MTD2A_binary_input  FC_51_sensor ("FC-51 sensor", 2000); // 2 seconds LAST_TIME delay
+MTD2A_binary_output red_LED      ("Red LED", 3000);      // 3 seconds on
+
+MTD2A_trace_event traceBuffer[16];  // 16 events. Events are lost when the buffer is full
+
+void setup() {
+  Serial.begin(9600); 
+  while (!Serial) { delay(10); } // ESP32 Serial Monitor ready delay
+
+  byte FC_51_PIN   = 2;  // Input Arduino board pin 2
+  byte RED_LED_PIN = 9;  // Output Arduino board pin 9
+  FC_51_sensor.initialize (FC_51_PIN);
+  red_LED.initialize      (RED_LED_PIN);
+
+  MTD2A_globalTraceBuffer (traceBuffer, 16);
+  MTD2A_globalTrace (TRACE_TEXT, 2);  // "tickMS name: [phase]". At most 2 events printed per loop
+  MTD2A_globalDebugPrint ();
+}
+
+void loop() {
+  MTD2A_loop_execute ();  // Update the state (event) system and print trace events
+  if (FC_51_sensor.get_phaseChange() == true  &&  FC_51_sensor.get_phaseNumber() == FIRST_TIME_PHASE)
+    red_LED.activate ();
+  if (MTD2A::get_reset_traceLostCount () > 0)
+    Serial.println (F("Trace events lost"));
+} // Phase trace
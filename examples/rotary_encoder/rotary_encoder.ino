@@ -0,0 +1,45 @@
+// Rotary encoder throttle knob. Position mapped through a PWM curve to a motor driver
+// Jørgen Bo Madsen / october 2026 / https://github.com/jebmdk
+
+#include <MTD2A.h>
+using namespace MTD2A_const;
+
+// KY-040 or EC11 encoder: A and B to interrupt pins (Uno: 2 and 3, or any pin change interrupt pin), C to ground.
+// The encoder push button can be read with a MTD2A_binary_input. Motor driver PWM input (L298N ENA) on pin 9. LED on pin 8.
+MTD2A_encoder_input throttle ("Throttle", 1000);           // COMPLETE_PHASE 1 second after the last detent
+MTD2A_binary_output motor    ("Motor", 0, 0, 0, P_W_M);    // PWM output, no timers
+MTD2A_binary_output stop_LED ("Stop LED", 200);            // Flash when the knob stops
+
+const int32_t SPEED_STEPS = 30;   // 30 detents from stop to full speed
+
+void setup() {
+  Serial.begin(9600);
+  while (!Serial) { delay(10); } // ESP32 Serial Monitor ready delay
+
+  motor.initialize (9);
+  stop_LED.initialize (8);
+  // Pin A, pin B, steps per detent (full quadrature cycle per detent)
+  throttle.initialize (2, 3, 4);
+  throttle.set_range (0, SPEED_STEPS);
+  // Start moving at PWM 60 (motor friction) and accelerate exponentially to full speed
+  throttle.set_target (motor, RISING_B05, 60, 255);
+  throttle.set_debugPrint ();
+}
+
+void loop() {
+  if (throttle.get_phaseChange() == true  &&  throttle.get_phaseNumber() == COMPLETE_PHASE) {
+    stop_LED.activate ();
+    Serial.print (F("Position: ")); Serial.print (throttle.get_position ());
+    Serial.print (F("  PWM: "));    Serial.println (motor.get_pinOutputValue ());
+  }
+  if (throttle.get_phaseNumber() == TURN_PHASE  &&  throttle.get_velocity () != 0) {
+    // Velocity in detents per second (negative = counter clockwise)
+    static uint32_t printTimeMS = 0;
+    if (millis() - printTimeMS >= 250) {
+      printTimeMS = millis();
+      Serial.print (F("Velocity: ")); Serial.println (throttle.get_velocity ());
+    }
+  }
+
+  MTD2A_loop_execute ();  // Update the state (event) system
+} // Rotary encoder throttle knob
@@ -0,0 +1,59 @@
+// Byte code script: Blink a LED from a script and measure the interpreter (instructions per loop)
+// Jørgen Bo Madsen / october 2026 / https://github.com/jebmdk
+
+#include <MTD2A.h>
+using namespace MTD2A_const;
+
+MTD2A_binary_output blink_LED  ("Blink LED", 200);  // Object index 0 (instantiation order)
+MTD2A_script        blink_show ("Blink show", 8);   // Max 8 instructions per loop
+MTD2A_script        benchmark  ("Benchmark", 255);  // Max 255 instructions per loop
+
+// extras/MTD2A_script_assembler.py --c-array
+//         LOAD r0, 5          ; 5 blinks
+// blink:  ACT  0, ACTIVATE    ; Blink LED
+//         WAIT 1000
+//         ADDI r0, -1
+//         JNZ  r0, blink
+//         END
+const uint8_t blink_script[] PROGMEM {
+  0x01, 0x00, 0x05, 0x00, 0x06, 0x00, 0x01, 0x00, 0x0C, 0xE8, 0x03, 0x05,
+  0x00, 0xFF, 0x0A, 0x00, 0x04, 0x00, 0x00
+};
+
+// loop:   ADDI r1, 1
+//         JMP  loop
+const uint8_t benchmark_script[] PROGMEM {
+  0x05, 0x01, 0x01, 0x08, 0x00, 0x00
+};
+
+void setup() {
+  Serial.begin(9600); 
+  while (!Serial) { delay(10); } // ESP32 Serial Monitor ready delay
+
+  byte BLINK_LED_PIN = 9;  // Output Arduino board pin 9
+  blink_LED.initialize  (BLINK_LED_PIN);
+  blink_show.initialize (blink_script, sizeof(blink_script), SCRIPT_FLASH);
+  blink_show.set_debugPrint ();
+  blink_show.start ();
+  benchmark.initialize (benchmark_script, sizeof(benchmark_script), SCRIPT_FLASH);
+  benchmark.start ();
+  // Upload a new blink script to EEPROM (boards with an EEPROM library): blink_show.upload_EEPROM (Serial);
+}
+
+void loop() {
+  static uint32_t printTimeMS {0};
+  static uint32_t lastCount {0};
+  MTD2A_loop_execute ();  // Update the state (event) system and run the scripts
+
+  if (millis() - printTimeMS >= 1000) {
+    printTimeMS = millis();
+    uint32_t instructionCount = benchmark.get_instructionCount ();
+    Serial.print  (F("Instructions per second: "));
+    Serial.print  (instructionCount - lastCount);
+    Serial.print  (F("  per loop: "));
+    Serial.print  (benchmark.get_tickSteps ());
+    Serial.print  (F("  overrun: "));
+    Serial.println(MTD2A::get_timeOverrunCount ());
+    lastCount = instructionCount;
+  }
+} // Byte code script
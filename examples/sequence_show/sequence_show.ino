@@ -0,0 +1,52 @@
+// Railway crossing light show as a time line (sequence step table in flash memory)
+// Jørgen Bo Madsen / october 2026 / https://github.com/jebmdk
+
+#include <MTD2A.h>
+using namespace MTD2A_const;
+
+MTD2A_binary_input  FC_51_sensor  ("FC-51 sensor", 5000); // 5 seconds LAST_TIME delay
+MTD2A_binary_output left_red_LED  ("Left red LED",  500); // 0.5 second on
+MTD2A_binary_output right_red_LED ("Right red LED", 500); // 0.5 second on
+MTD2A_binary_output boom_servo    ("Boom servo", 0, 0, 0, P_W_M);
+MTD2A_sequence      crossing_show ("Crossing show");
+
+// offsetMS (sorted), target object, action, value (LINK_WRITE). Stored in flash memory (no RAM)
+const MTD2A_sequence_step crossing_steps[] PROGMEM {
+  {    0, &left_red_LED,  LINK_ACTIVATE, 0},
+  {  500, &right_red_LED, LINK_ACTIVATE, 0},
+  { 1000, &left_red_LED,  LINK_ACTIVATE, 0},
+  { 1000, &boom_servo,    LINK_WRITE,   64},  // Lower boom
+  { 1500, &right_red_LED, LINK_ACTIVATE, 0},
+  { 2000, &boom_servo,    LINK_WRITE,  128},  // Boom down
+};
+
+void setup() {
+  Serial.begin(9600); 
+  while (!Serial) { delay(10); } // ESP32 Serial Monitor ready delay
+
+  byte FC_51_PIN         = 2;  // Input Arduino board pin 2
+  byte LEFT_RED_LED_PIN  = 9;  // Output Arduino board pin 9
+  byte RIGHT_RED_LED_PIN = 10; // Output Arduino board pin 10
+  byte BOOM_SERVO_PIN    = 11; // Output Arduino board pin 11 (PWM)
+  FC_51_sensor.initialize  (FC_51_PIN);
+  left_red_LED.initialize  (LEFT_RED_LED_PIN);
+  right_red_LED.initialize (RIGHT_RED_LED_PIN);
+  boom_servo.initialize    (BOOM_SERVO_PIN);
+
+  crossing_show.initialize (crossing_steps, sizeof(crossing_steps) / sizeof(crossing_steps[0]), FLASH_TABLE);
+  crossing_show.set_loopMode (ENABLE, 2500);  // Blink until the train has passed (2.5 seconds cycle)
+  crossing_show.set_debugPrint ();
+}
+
+void loop() {
+  if (FC_51_sensor.get_phaseChange() == true) {
+    if (FC_51_sensor.get_phaseNumber() == FIRST_TIME_PHASE)
+      crossing_show.start ();
+    if (FC_51_sensor.get_phaseNumber() == COMPLETE_PHASE) {
+      crossing_show.reset ();
+      boom_servo.set_pinWriteValue (0);  // Raise boom
+    }
+  }
+
+  MTD2A_loop_execute ();  // Update the state (event) system and the sequence
+} // Railway crossing light show as a time line
@@ -0,0 +1,49 @@
+// Train direction, speed and length from two sensors
+// Jørgen Bo Madsen / october 2026 / https://github.com/jebmdk
+
+#include <MTD2A.h>
+using namespace MTD2A_const;
+
+MTD2A_binary_input  FC_51_left   ("FC 51 left",  1000); // 1 second LAST_TIME delay (gaps between wagons)
+MTD2A_binary_input  FC_51_right  ("FC 51 right", 1000); // 1 second LAST_TIME delay (gaps between wagons)
+
+MTD2A_speed_trap    speed_trap   ("Speed trap", 300, 10000); // 300 mm between sensors, 10 seconds timeout
+
+void setup() {
+  Serial.begin(9600); 
+  while (!Serial) { delay(10); } // ESP32 Serial Monitor ready delay
+  
+  byte FC_51_LEFT_PIN  = 2;  // Input Arduino board pin 2
+  byte FC_51_RIGHT_PIN = 3;  // Input Arduino board pin 3
+  FC_51_left.initialize  (FC_51_LEFT_PIN);
+  FC_51_right.initialize (FC_51_RIGHT_PIN);
+  // Optional: microsecond time stamps (interrupt pins 2 and 3 on Arduino Uno and Nano)
+  FC_51_left.set_microTiming  ();
+  FC_51_right.set_microTiming ();
+
+  speed_trap.initialize (FC_51_left, FC_51_right);
+  speed_trap.set_debugPrint ();
+}
+
+void loop() {
+  if (speed_trap.get_phaseChange() == true) {
+    switch (speed_trap.get_phaseNumber()) {
+      case ENTRY_PHASE:
+        if (speed_trap.get_direction() == LEFT_TO_RIGHT) 
+          Serial.println("Moving right");
+        else
+          Serial.println("Moving left");
+      break;
+      case SPEED_PHASE:
+        Serial.print("H0 scale speed km/h: ");
+        Serial.println(speed_trap.get_scaleSpeedKMH(87));
+      break;
+      case LENGTH_PHASE:
+        Serial.print("Train length mm: ");
+        Serial.println(speed_trap.get_trainLengthMM());
+      break;
+    }
+  }
+
+  MTD2A_loop_execute ();  // Update the state (event) system
+} // Train direction, speed and length from two sensors
@@ -0,0 +1,47 @@
+// Many software timers with the hierarchical timing wheel engine
+// Jørgen Bo Madsen / october 2026 / https://github.com/jebmdk
+
+// The timing wheel is selected when the library is compiled (it changes the layout of every MTD2A_timer):
+// PlatformIO build_flags = -DMTD2A_TIMER_WHEEL=1, arduino-cli --build-property "compiler.cpp.extra_flags=-DMTD2A_TIMER_WHEEL=1",
+// or #define MTD2A_TIMER_WHEEL 1 in MTD2A_base.h. Without it the sketch runs on the default engine (same results, more loop time)
+// Running timers then cost nothing per loop until they expire. Remaining and elapsed time are calculated on demand.
+
+#include <MTD2A.h>
+using namespace MTD2A_const;
+
+const uint8_t TIMER_COUNT = 48;     // ESP32: 200 and more (max 255 MTD2A objects)
+MTD2A_timer   timers[TIMER_COUNT];  // "Object name" and no count down time (set below)
+
+uint32_t expireCount = 0;
+uint32_t loopCount   = 0;
+uint32_t printTimeMS = 0;
+
+void setup() {
+  Serial.begin(9600);
+  while (!Serial) { delay(10); } // ESP32 Serial Monitor ready delay
+
+  // Count down times from 0.1 to 1.8 seconds
+  for (uint8_t index = 0; index < TIMER_COUNT; index++)
+    timers[index].timer (START_TIMER, 100 + index * 37);
+}
+
+void loop() {
+  for (uint8_t index = 0; index < TIMER_COUNT; index++) {
+    if (timers[index].get_phaseChange() == true  &&  timers[index].get_phaseNumber() == STOP_TIMER) {
+      expireCount++;
+      timers[index].timer (START_TIMER);
+    }
+  }
+  loopCount++;
+
+  if (millis() - printTimeMS >= 5000) {
+    printTimeMS = millis();
+    Serial.print (F("Expired: "));  Serial.print (expireCount);
+    Serial.print (F("  Loops: "));  Serial.print (loopCount);
+    Serial.print (F("  Timer 0 remaining: ")); Serial.println (timers[0].get_remainTimeMS ());
+    expireCount = 0;
+    loopCount   = 0;
+  }
+
+  MTD2A_loop_execute ();  // Update the state (event) system
+} // Many software timers
@@ -0,0 +1,47 @@
+// Warm restart: A boom and a timer continue mid-phase after a watchdog reset instead of starting over
+// Jørgen Bo Madsen / october 2026 / https://github.com/jebmdk
+
+#include <MTD2A.h>
+#if defined(__AVR__)
+  #include <avr/wdt.h>
+#endif
+using namespace MTD2A_const;
+
+MTD2A_binary_output boom_servo  ("Boom servo", 10000, 0, 0, P_W_M, 128, 0); // 10 seconds boom down
+MTD2A_timer         crossing_TM ("Crossing timer", 15000);                   // 15 seconds crossing closed
+
+MTD2A_warm_entry warmTable[2] MTD2A_NOINIT;  // One entry per object. Uninitialized RAM: kept at a watchdog reset
+
+void setup() {
+  Serial.begin(9600); 
+  while (!Serial) { delay(10); } // ESP32 Serial Monitor ready delay
+
+  byte BOOM_SERVO_PIN = 11;  // Output Arduino board pin 11 (PWM)
+  boom_servo.initialize (BOOM_SERVO_PIN);
+
+  MTD2A_globalWarmRestart (warmTable, 2, ENABLE);  // After initialize (): Resume ACTIVE objects (0 = cold start)
+  if (MTD2A::get_globalWarmRestart () == 0) {
+    boom_servo.activate ();
+    crossing_TM.timer (START_TIMER);
+    Serial.println (F("Cold start"));
+  }
+  else {
+    Serial.print (F("Warm restart, objects resumed: "));
+    Serial.println (MTD2A::get_globalWarmRestart ());
+  }
+#if defined(__AVR__)
+  wdt_enable (WDTO_500MS);
+#endif
+}
+
+void loop() {
+  MTD2A_loop_execute ();  // Update the state (event) system and save the object states
+  // Send 'h' from the Serial Monitor to hang the loop: The watchdog resets the board
+  if (Serial.available() > 0  &&  Serial.read() == 'h')
+    while (true) {}
+#if defined(__AVR__)
+  wdt_reset ();
+#endif
+  if (crossing_TM.get_phaseChange() == true  &&  crossing_TM.get_phaseNumber() == STOP_TIMER)
+    Serial.println (F("Crossing open"));
+} // Warm restart
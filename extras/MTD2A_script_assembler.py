@@ -0,0 +1,193 @@
+#!/usr/bin/env python3
+"""
+MTD2A_script_assembler.py - Assemble MTD2A_script text to byte code
+
+Usage:
+  python3 MTD2A_script_assembler.py crossing.txt --c-array           # const uint8_t script[] PROGMEM {...};
+  python3 MTD2A_script_assembler.py crossing.txt -o crossing.bin      # EEPROM image (header + code)
+  python3 MTD2A_script_assembler.py crossing.txt --upload /dev/ttyUSB0 --baud 115200
+
+Upload requires pyserial (pip install pyserial) and a sketch calling
+  script.upload_EEPROM (Serial);
+
+Source text: One instruction per line, "; comment", "label:". Registers r0 - r7.
+Objects are MTD2A object indexes (instantiation order, first object = 0).
+
+  END                       LOAD  r, value         LOADL r, value
+  MOV   r, s                ADD   r, s             ADDI  r, value (-128 - 127)
+  ACT   object, action [, value]   (action: ACTIVATE RESET STOP PAUSE WRITE or number)
+  GET   r, object, field           (field: PHASE STATE CHANGE PIN TIME ERROR)
+  JMP   label               JZ    r, label         JNZ   r, label
+  JEQ   r, value, label     WAIT  ms               WAITR r
+  YIELD
+
+EEPROM image (multi byte values LSB first):
+  0xA7, code length (uint16), CRC-16/CCITT-FALSE of the code (uint16), code
+"""
+
+import argparse
+import struct
+import sys
+
+IMAGE_MAGIC = 0xA7
+
+# name: (opcode, operand types). r = register, b = byte, s = signed byte, w = word,
+# l = long, a = address (label), o = object, c = action, f = field
+INSTRUCTIONS = {
+    "END":   (0x00, ""),
+    "LOAD":  (0x01, "rw"),
+    "LOADL": (0x02, "rl"),
+    "MOV":   (0x03, "rr"),
+    "ADD":   (0x04, "rr"),
+    "ADDI":  (0x05, "rs"),
+    "ACT":   (0x06, "ocb"),
+    "GET":   (0x07, "rof"),
+    "JMP":   (0x08, "a"),
+    "JZ":    (0x09, "ra"),
+    "JNZ":   (0x0A, "ra"),
+    "JEQ":   (0x0B, "rba"),
+    "WAIT":  (0x0C, "w"),
+    "WAITR": (0x0D, "r"),
+    "YIELD": (0x0E, ""),
+}
+OPERAND_SIZE = {"r": 1, "b": 1, "s": 1, "w": 2, "l": 4, "a": 2, "o": 1, "c": 1, "f": 1}
+ACTIONS = {"ACTIVATE": 1, "RESET": 2, "STOP": 3, "PAUSE": 4, "WRITE": 5}
+FIELDS = {"PHASE": 0, "STATE": 1, "CHANGE": 2, "PIN": 3, "TIME": 4, "ERROR": 5}
+
+
+class AssemblerError(Exception):
+    pass
+
+
+def crc16_ccitt(data, crc=0xFFFF):
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def parse_lines(text):
+    """Yields (line number, label or None, mnemonic or None, operands)."""
+    for number, line in enumerate(text.splitlines(), 1):
+        line = line.split(";", 1)[0].strip()
+        label = None
+        if ":" in line:
+            label, line = (part.strip() for part in line.split(":", 1))
+        if not line:
+            yield number, label, None, []
+            continue
+        mnemonic, _, rest = line.partition(" ")
+        operands = [operand.strip() for operand in rest.split(",")] if rest.strip() else []
+        yield number, label, mnemonic.upper(), operands
+
+
+def number(text, low, high):
+    value = int(text, 0)
+    if not low <= value <= high:
+        raise AssemblerError("value %s out of range (%d - %d)" % (text, low, high))
+    return value
+
+
+def encode(kind, text, labels):
+    upper = text.upper()
+    if kind == "r":
+        if not (upper.startswith("R") and upper[1:].isdigit() and int(upper[1:]) < 8):
+            raise AssemblerError("register expected (r0 - r7): %s" % text)
+        return bytes([int(upper[1:])])
+    if kind == "c":
+        return bytes([ACTIONS[upper] if upper in ACTIONS else number(text, 0, 255)])
+    if kind == "f":
+        return bytes([FIELDS[upper] if upper in FIELDS else number(text, 0, 255)])
+    if kind in "bo":
+        return bytes([number(text, 0, 255)])
+    if kind == "s":
+        return struct.pack("<b", number(text, -128, 127))
+    if kind == "w":
+        return struct.pack("<H", number(text, 0, 0xFFFF))
+    if kind == "l":
+        return struct.pack("<I", number(text, -0x80000000, 0xFFFFFFFF) & 0xFFFFFFFF)
+    if text not in labels:
+        raise AssemblerError("unknown label: %s" % text)
+    return struct.pack("<H", labels[text])
+
+
+def assemble(text):
+    lines = list(parse_lines(text))
+    # Pass 1: Label addresses
+    labels, address = {}, 0
+    for number_, label, mnemonic, operands in lines:
+        if label:
+            labels[label] = address
+        if mnemonic:
+            if mnemonic not in INSTRUCTIONS:
+                raise AssemblerError("line %d: unknown instruction %s" % (number_, mnemonic))
+            address += 1 + sum(OPERAND_SIZE[kind] for kind in INSTRUCTIONS[mnemonic][1])
+    # Pass 2: Code
+    code = bytearray()
+    for number_, label, mnemonic, operands in lines:
+        if not mnemonic:
+            continue
+        opcode, kinds = INSTRUCTIONS[mnemonic]
+        if mnemonic == "ACT" and len(operands) == 2:
+            operands.append("0")
+        if len(operands) != len(kinds):
+            raise AssemblerError("line %d: %s expects %d operands" % (number_, mnemonic, len(kinds)))
+        code.append(opcode)
+        try:
+            for kind, operand in zip(kinds, operands):
+                code += encode(kind, operand, labels)
+        except (AssemblerError, ValueError) as error:
+            raise AssemblerError("line %d: %s" % (number_, error))
+    if len(code) > 0xFFFF:
+        raise AssemblerError("script too large (%d bytes)" % len(code))
+    return bytes(code)
+
+
+def image(code):
+    return struct.pack("<BHH", IMAGE_MAGIC, len(code), crc16_ccitt(code)) + code
+
+
+def c_array(code, name):
+    rows = [", ".join("0x%02X" % byte for byte in code[i:i + 12]) for i in range(0, len(code), 12)]
+    return "const uint8_t %s[] PROGMEM {\n  %s\n};  // %d bytes\n" % (name, ",\n  ".join(rows), len(code))
+
+
+def upload(port, baud, data):
+    import serial  # pyserial
+    with serial.Serial(port, baud, timeout=10) as connection:
+        connection.write(data)
+        connection.flush()
+        reply = connection.readline().decode(errors="replace").strip()
+    print(reply or "No reply (timeout)", file=sys.stderr)
+    return reply.endswith("OK")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Assemble MTD2A_script byte code")
+    parser.add_argument("source", help="Script text file or - for stdin")
+    parser.add_argument("-o", "--output", help="Write EEPROM image (binary)")
+    parser.add_argument("--c-array", action="store_true", help="Print C array (PROGMEM)")
+    parser.add_argument("--name", default="script", help="C array name")
+    parser.add_argument("--upload", metavar="PORT", help="Upload EEPROM image to serial port")
+    parser.add_argument("--baud", type=int, default=115200)
+    args = parser.parse_args()
+
+    text = sys.stdin.read() if args.source == "-" else open(args.source).read()
+    try:
+        code = assemble(text)
+    except AssemblerError as error:
+        sys.exit("%s: %s" % (args.source, error))
+    if args.output:
+        with open(args.output, "wb") as output:
+            output.write(image(code))
+    if args.upload:
+        if not upload(args.upload, args.baud, image(code)):
+            sys.exit(1)
+    if args.c_array or not (args.output or args.upload):
+        sys.stdout.write(c_array(code, args.name))
+
+
+if __name__ == "__main__":
+    main()
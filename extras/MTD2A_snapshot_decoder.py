@@ -0,0 +1,170 @@
+#!/usr/bin/env python3
+"""
+MTD2A_snapshot_decoder.py - Decode MTD2A binary snapshot frames to CSV or JSON
+
+Sketch:
+  MTD2A_globalSnapshot (Serial, 100, 10);  // Every 100 ms, full snapshot every 10th
+
+Usage:
+  python3 MTD2A_snapshot_decoder.py /dev/ttyUSB0 --baud 115200 [--json]
+  python3 MTD2A_snapshot_decoder.py capture.bin [--json]
+  cat capture.bin | python3 MTD2A_snapshot_decoder.py - [--json]
+
+Serial ports require pyserial (pip install pyserial).
+
+Frame (multi byte values LSB first):
+  0xA6 0x5A, length (uint16), frame type (0 = full, 1 = delta), sequence (uint8),
+  globalSyncTimeMS (uint32), timeOverrunCount (uint16), objectCount (uint8), recordCount (uint8),
+  records: objectIndex, objectType, phaseNumber, stateFlags, errorNumber, pinNumber, pinValue, timeMS (uint32),
+  CRC-16/CCITT-FALSE of length to last record (uint16)
+
+Delta frames only contain objects that changed since the previous frame. The decoder keeps
+the last known state of every object and outputs the complete table after each frame.
+A gap in the sequence numbers (lost frame) discards delta frames until the next full frame.
+
+timeMS: Times are globalSyncTimeMS values, so unchanged objects are not resent every frame.
+binary_input = FIRST_TIME_PHASE start, binary_output = phase start, timer = deadline while running
+(else remaining time), sequence = start in RUN_PHASE (else elapsed time), encoder_input = last detent.
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+SYNC = b"\xA6\x5A"
+HEADER = struct.Struct("<BBIHBB")      # type, sequence, syncTimeMS, overrunCount, objectCount, recordCount
+RECORD = struct.Struct("<BBBBBBBI")    # objectIndex, objectType, phase, flags, error, pin, pinValue, timeMS
+OBJECT_TYPES = {1: "binary_input", 2: "binary_output", 3: "timer", 4: "speed_trap", 5: "sequence", 6: "script",
+                7: "analog_input", 8: "current_detector", 9: "distance_input",
+                10: "ir_input", 11: "encoder_input"}
+CSV_FIELDS = ["syncTimeMS", "sequence", "object", "type", "phase", "processState",
+              "phaseChange", "error", "pin", "pinValue", "timeMS"]
+
+
+def crc16_ccitt(data, crc=0xFFFF):
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+class SnapshotDecoder:
+    def __init__(self):
+        self.buffer = bytearray()
+        self.objects = {}
+        self.synced = False    # Delta frames are applied after the first full frame
+        self.sequence = None   # Sequence number of the last applied frame
+        self.crc_errors = 0
+
+    def feed(self, data):
+        """Add received bytes. Yields (header, objects) for every valid frame."""
+        self.buffer += data
+        while True:
+            start = self.buffer.find(SYNC)
+            if start < 0:
+                del self.buffer[:-1]
+                return
+            del self.buffer[:start]
+            if len(self.buffer) < 4:
+                return
+            length = self.buffer[2] | (self.buffer[3] << 8)
+            total = 2 + 2 + length + 2
+            if len(self.buffer) < total:
+                return
+            frame = bytes(self.buffer[:total])
+            crc = frame[-2] | (frame[-1] << 8)
+            if length < HEADER.size or crc16_ccitt(frame[2:-2]) != crc:
+                # Not a frame (or corrupted). Skip the sync and search again
+                self.crc_errors += 1
+                del self.buffer[:2]
+                continue
+            del self.buffer[:total]
+            result = self.decode(frame[4:-2])
+            if result is not None:
+                yield result
+
+    def decode(self, payload):
+        frame_type, sequence, sync_ms, overruns, object_count, record_count = HEADER.unpack_from(payload)
+        if len(payload) != HEADER.size + record_count * RECORD.size:
+            self.crc_errors += 1
+            return None
+        if frame_type == 0:
+            self.objects = {}
+            self.synced = True
+        elif self.synced and sequence != (self.sequence + 1) & 0xFF:
+            # Lost frame: Its changes are missing. Wait for the next full frame
+            self.synced = False
+        if not self.synced:
+            return None
+        self.sequence = sequence
+        for offset in range(HEADER.size, len(payload), RECORD.size):
+            index, obj_type, phase, flags, error, pin, pin_value, time_ms = RECORD.unpack_from(payload, offset)
+            self.objects[index] = {
+                "object": index,
+                "type": OBJECT_TYPES.get(obj_type, obj_type),
+                "phase": phase,
+                "processState": flags & 1,
+                "phaseChange": (flags >> 1) & 1,
+                "error": error,
+                "pin": None if pin == 255 else pin,
+                "pinValue": pin_value,
+                "timeMS": time_ms,
+            }
+        header = {
+            "syncTimeMS": sync_ms,
+            "sequence": sequence,
+            "full": frame_type == 0,
+            "timeOverrunCount": overruns,
+            "objectCount": object_count,
+            "changed": record_count,
+        }
+        return header, [self.objects[k] for k in sorted(self.objects)]
+
+
+def open_input(name, baud):
+    if name == "-":
+        return sys.stdin.buffer
+    try:
+        return open(name, "rb")
+    except OSError:
+        import serial  # pyserial
+        return serial.Serial(name, baud, timeout=0.1)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode MTD2A binary snapshot frames")
+    parser.add_argument("input", help="Serial port, capture file or - for stdin")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--json", action="store_true", help="One JSON object per frame (default CSV)")
+    args = parser.parse_args()
+
+    source = open_input(args.input, args.baud)
+    decoder = SnapshotDecoder()
+    if not args.json:
+        print(",".join(CSV_FIELDS))
+    try:
+        while True:
+            data = source.read(256)
+            if not data:
+                if hasattr(source, "in_waiting"):
+                    continue
+                break
+            for header, objects in decoder.feed(data):
+                if args.json:
+                    print(json.dumps(dict(header, objects=objects)))
+                else:
+                    for obj in objects:
+                        row = dict(obj, syncTimeMS=header["syncTimeMS"], sequence=header["sequence"])
+                        print(",".join("" if row[f] is None else str(row[f]) for f in CSV_FIELDS))
+                sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+    if decoder.crc_errors:
+        print("CRC errors: %d" % decoder.crc_errors, file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -38,7 +38,16 @@
 #include "MTD2A_base.h"
 #include "MTD2A_timer.h"
 #include "MTD2A_binary_input.h"
+#include "MTD2A_analog_input.h"
+#include "MTD2A_current_detector.h"
+#include "MTD2A_distance_input.h"
+#include "MTD2A_ir_input.h"
+#include "MTD2A_encoder_input.h"
 #include "MTD2A_binary_output.h"
+#include "MTD2A_speed_trap.h"
+#include "MTD2A_print_buffer.h"
+#include "MTD2A_sequence.h"
+#include "MTD2A_script.h"
 
 
 #endif
\ No newline at end of file
@@ -0,0 +1,200 @@
+/*
+ ******************************************************************************
+ * @file    MTD2A_analog_input.cpp
+ * @author  Joergen Bo Madsen
+ * @version 1.0.0
+ * @date    18. October 2026
+ * @brief   functions for MTD2A_analog_input.h (Model Train Detection And Action)
+ *
+ * Supporting a vast variety of input sensors and output devices
+ * Simple to use to build complex solutions
+ * Non blocking, simple, yet efficient event-driven state machine
+ * Comprehensive control, state and debug information
+ */
+
+
+#include "Arduino.h"
+#include "MTD2A_base.h"
+#include "MTD2A_binary_input.h"
+#include "MTD2A_analog_input.h"
+
+
+// Specific global constants from MTD2A_analog_input.h (MTD2A_const.h)
+constexpr uint8_t MTD2A_analog_input::MAX_OVERSAMPLING;
+
+
+// Constructor
+MTD2A_analog_input::MTD2A_analog_input
+  (
+    const char    *setObjectName,
+    const uint32_t setDelayTimeMS,
+    const bool     setFirstOrLast,
+    const bool     setTimeOrMono,
+    const uint32_t setPinBlockMS
+  )
+  : MTD2A_binary_input (setObjectName, setDelayTimeMS, setFirstOrLast, setTimeOrMono, setPinBlockMS)
+  {
+    pinType = INPUT;
+  }
+// MTD2A_analog_input
+
+
+// Constructor F("Object name")
+MTD2A_analog_input::MTD2A_analog_input
+  (const __FlashStringHelper *setObjectName, const uint32_t setDelayTimeMS, const bool setFirstOrLast, const bool setTimeOrMono, const uint32_t setPinBlockMS)
+  : MTD2A_analog_input ((const char *)nullptr, setDelayTimeMS, setFirstOrLast, setTimeOrMono, setPinBlockMS)
+  {
+    MTD2A_set_object_name(setObjectName);
+  }
+// MTD2A_analog_input
+
+
+void MTD2A_analog_input::initialize (const uint8_t &setPinNumber, const uint16_t &setThreshold, const uint16_t &setHysteresis, const bool &setPinNomalOrInverted) {
+  // Check for instantiated object error
+  delayTimeMS = check_set_time (delayTimeMS);
+  pinBlockMS  = check_set_time (pinBlockMS);
+  // Configuration block (MTD2A_globalConfig) overrides the arguments
+  threshold  = (uint16_t)MTD2A_config_value (CONFIG_THRESHOLD,  setThreshold);
+  hysteresis = (uint16_t)MTD2A_config_value (CONFIG_HYSTERESIS, setHysteresis);
+  const uint8_t configPinNumber = (uint8_t)MTD2A_config_value (CONFIG_PIN_NUMBER, setPinNumber);
+  errorNumber = MTD2A_reserve_and_check_pin (configPinNumber, ANALOG_FLAG_1 | INPUT_FLAG_2);
+  if (errorNumber == 0) {
+    pinReadToggl = ENABLE;
+    pinNumber = configPinNumber;
+    pinReadMode = (bool)MTD2A_config_value (CONFIG_PIN_MODE, setPinNomalOrInverted);
+    // Start inactive until the first value is compared
+    analogState = (pinReadMode == NORMAL) ? HIGH : LOW;
+    pinType = INPUT;
+    pinMode(pinNumber, pinType);
+  }
+  else {
+    print_error_text (errorNumber);
+    pinReadToggl = DISABLE;
+    pinNumber    = PIN_ERROR_NO;
+  }
+} // initialize
+
+
+void MTD2A_analog_input::set_threshold (const uint16_t &setThreshold, const uint16_t &setHysteresis) {
+  threshold  = setThreshold;
+  hysteresis = setHysteresis;
+} // set_threshold
+
+
+void MTD2A_analog_input::set_oversampling (const uint8_t &setOversampling) {
+  if (setOversampling == 0  ||  setOversampling > MAX_OVERSAMPLING) {
+    print_error_text (162);
+    oversampling = MAX_OVERSAMPLING;
+  }
+  else {
+    oversampling = setOversampling;
+  }
+} // set_oversampling
+
+
+void MTD2A_analog_input::set_adcScan (const bool &setEnableOrDisable) {
+  if (setEnableOrDisable == ENABLE) {
+    if (adcSlot == PIN_ERROR_NO) {
+      uint8_t attachErrorNumber = MTD2A_adc_scan_attach (pinNumber, adcSlot);
+      if (attachErrorNumber == 0)
+        adcScanStart = get_globalAdcScanCount ();
+      else
+        print_error_text (attachErrorNumber);
+    }
+  }
+  else {
+    if (adcSlot != PIN_ERROR_NO)
+      MTD2A_adc_scan_detach (adcSlot);
+  }
+} // set_adcScan
+
+
+//  Getters ----------------------------------------------------------------------------
+
+
+uint16_t const &MTD2A_analog_input::get_analogValue () const {
+  return analogValue;
+}
+
+
+uint32_t const &MTD2A_analog_input::get_sampleTimeUS () const {
+  return sampleTimeUS;
+}
+
+
+bool MTD2A_analog_input::get_adcScan () const {
+  return (adcSlot != PIN_ERROR_NO);
+}
+
+
+//  Private ----------------------------------------------------------------------------
+
+
+bool MTD2A_analog_input::loop_fast_read () {
+  const uint32_t sampleStartUS = micros();
+  const bool newValue = loop_fast_value ();
+  sampleTimeUS = micros() - sampleStartUS;
+  // Comparator with hysteresis. Written without subtraction to avoid wrap around near 0
+  if (newValue) {
+    if ((uint32_t)analogValue >= (uint32_t)threshold + hysteresis)
+      analogState = HIGH;
+    else if ((uint32_t)analogValue + hysteresis <= threshold)
+      analogState = LOW;
+  }
+  return analogState;
+} // loop_fast_read
+
+
+bool MTD2A_analog_input::loop_fast_value () {
+  // Current detector overrides with windowed RMS or peak (MTD2A_current_detector)
+  if (adcSlot != PIN_ERROR_NO) {
+    // Two complete scan rounds after attach before the buffer holds this channel
+    if ((uint16_t)(get_globalAdcScanCount () - adcScanStart) < 2)
+      return false;
+    analogValue = MTD2A_adc_scan_value (adcSlot);
+  }
+  else {
+    // 16 samples * 4095 (12 bit ESP32) fits in uint16_t
+    uint16_t sampleSum {0};
+    for (uint8_t sampleIndex = 0; sampleIndex < oversampling; sampleIndex++)
+      sampleSum += (uint16_t)analogRead(pinNumber);
+    analogValue = sampleSum / oversampling;
+  }
+  return true;
+} // loop_fast_value
+
+
+#if MTD2A_OBJECT_STATE > 0
+void MTD2A_analog_input::MTD2A_snapshot_state (MTD2A_snapshot_record &snapshotRecord) const {
+  // pinValue: analogValue / 4 (0 - 255). timeMS as binary_input
+  MTD2A_binary_input::MTD2A_snapshot_state (snapshotRecord);
+  snapshotRecord.objectType = SNAPSHOT_ANALOG;
+  snapshotRecord.pinValue   = (analogValue >> 2) > MAX_BYTE_VALUE ? MAX_BYTE_VALUE : (uint8_t)(analogValue >> 2);
+} // MTD2A_snapshot_state
+#endif
+
+
+#if MTD2A_CONFIG > 0
+bool MTD2A_analog_input::MTD2A_config_field (const uint8_t &fieldId, const uint32_t &fieldValue, const bool &applyField) {
+  // Values are validated by MTD2A_config_check ()
+  switch (fieldId) {
+    case CONFIG_THRESHOLD:  if (applyField) threshold  = (uint16_t)fieldValue; return true;
+    case CONFIG_HYSTERESIS: if (applyField) hysteresis = (uint16_t)fieldValue; return true;
+  }
+  return MTD2A_binary_input::MTD2A_config_field (fieldId, fieldValue, applyField);
+} // MTD2A_config_field
+#endif
+
+
+void MTD2A_analog_input::print_conf () {
+#if MTD2A_LOG_LEVEL >= MTD2A_LOG_DEBUG
+  MTD2A_binary_input::print_conf ();
+  PortPrintln(F("MTD2A_analog_input: "));
+  PortPrint  (F("  threshold    : ")); PortPrintln(threshold);
+  PortPrint  (F("  hysteresis   : ")); PortPrintln(hysteresis);
+  PortPrint  (F("  oversampling : ")); PortPrintln(oversampling);
+  PortPrint  (F("  adcScan      : ")); MTD2A_print_enable_disable (adcSlot != PIN_ERROR_NO);
+  PortPrint  (F("  analogValue  : ")); PortPrintln(analogValue);
+  PortPrint  (F("  sampleTimeUS : ")); PortPrintln(sampleTimeUS);
+#endif
+} // print_conf
@@ -0,0 +1,185 @@
+/*
+ ******************************************************************************
+ * @file    MTD2A_analog_input.h
+ * @author  Joergen Bo Madsen
+ * @version 1.0.0
+ * @date    18. October 2026
+ * @brief   Analog threshold input with hysteresis and oversampling (binary_input state machine)
+ *
+ * Supporting a vast variety of input sensors and output devices
+ * Simple to use to build complex solutions
+ * Non blocking, simple, yet efficient event-driven state machine
+ * Comprehensive control, state and debug information
+ */
+
+
+
+#ifndef _MTD2A_analog_input_H_
+#define _MTD2A_analog_input_H_
+
+
+#include "Arduino.h"
+#include "MTD2A_base.h"
+#include "MTD2A_binary_input.h"
+
+
+// Comparator (pin state) from the mean of oversampling analogRead () samples, or the ADC scan engine value (set_adcScan):
+//   HIGH when analogValue >= threshold + hysteresis
+//   LOW  when analogValue <= threshold - hysteresis
+//   Unchanged inside the band.
+// NORMAL: LOW (below threshold) is active. INVERTED: HIGH (above threshold) is active, e.g. current sense detectors.
+// Phases, timers, debounce, links and counters are the binary_input ones.
+
+
+class MTD2A_analog_input: public MTD2A_binary_input
+{
+  friend class MTD2A_current_detector;
+
+  private:
+    // Specific global constants from MTD2A_analog_input.h (MTD2A_const.h)
+    static constexpr uint8_t  MAX_OVERSAMPLING {MTD2A_const::MAX_OVERSAMPLING};
+
+    // Arguments
+    uint16_t threshold     {512};            // initialize () and set_threshold () default argument
+    uint16_t hysteresis    {16};             // initialize () and set_threshold () default argument
+    uint8_t  oversampling  {1};              // set_oversampling () {1 - 16} analogRead () samples per loop
+    // State
+    uint16_t analogValue   {0};              // get_analogValue () Mean of the samples in the last loop
+    bool     analogState   {HIGH};           // Comparator state with hysteresis
+    uint32_t sampleTimeUS  {0};              // get_sampleTimeUS () Time used by analogRead () in the last loop
+    // ADC scan engine
+    uint8_t  adcSlot       {PIN_ERROR_NO};   // set_adcScan () Scan channel slot
+    uint16_t adcScanStart  {0};              // Scan round count when attached
+
+  public:
+    // Constructor initializers
+
+    /**
+     * @class MTD2A_analog_input
+     * @brief Create object and set configuration parameters or use defaults
+     * @param ( "Object Name", delayTimeMS, {FIRST_TRIGGER | LAST_TRIGGER}, {TIME_DELAY | MONO_STABLE}, pinBlocTimeMS );
+     * @param delayTimeMS & pinblockTimeMS {0 - 4294967295} milliseconds
+     * @return none
+     */
+    MTD2A_analog_input (
+      const char    *setObjectName  = "Object name",
+      const uint32_t setDelayTimeMS = 0,
+      const bool     setFirstOrLast = LAST_TRIGGER,
+      const bool     setTimeOrMono  = TIME_DELAY,
+      const uint32_t setPinBlockMS  = 0
+    );
+    // F("Object name") flash memory name (only legal inside functions). Names are not copied, see set_objectName ()
+    MTD2A_analog_input (
+      const __FlashStringHelper *setObjectName,
+      const uint32_t setDelayTimeMS = 0,
+      const bool     setFirstOrLast = LAST_TRIGGER,
+      const bool     setTimeOrMono  = TIME_DELAY,
+      const uint32_t setPinBlockMS  = 0
+    );
+
+    // Destructor (globalObjectCount is decremented by ~MTD2A_binary_input)
+    ~MTD2A_analog_input () {
+      if (adcSlot != PIN_ERROR_NO)
+        MTD2A_adc_scan_detach (adcSlot);
+    };
+
+  public: // Functions
+    /**
+     * @brief Initalize analog pin, threshold and hysteresis. If illigal pin configuration, pin reading is disabled!
+     * @name object_name.initialize
+     * @param ( {A0 - A(NUM_ANALOG_INPUTS - 1) | 255}, threshold {0 - 65535}, hysteresis {0 - 65535}, {NORMAL | INVERTED} );
+     * @return none
+     */
+    void initialize (const uint8_t &setPinNumber = PIN_ERROR_NO, const uint16_t &setThreshold = 512, const uint16_t &setHysteresis = 16, const bool &setPinNomalOrInverted = NORMAL);
+
+
+    /*
+     * @brief print configuration parameters, timers and state logic.
+     * @name object_name.print_conf ();
+     * @param none
+     * @return none
+     */
+    void print_conf ();
+
+
+    // Setters -----------------------------------------------
+
+
+    /**
+     * @brief Set threshold and hysteresis. Pin state goes HIGH at threshold + hysteresis and LOW at threshold - hysteresis.
+     * @name object_name.set_threshold
+     * @param ( threshold {0 - 65535}, hysteresis {0 - 65535} );
+     * @return none
+     */
+    void set_threshold (const uint16_t &setThreshold, const uint16_t &setHysteresis = 16);
+
+
+    /**
+     * @brief Number of analogRead () samples per loop. The mean value is compared with the threshold.
+     * @name object_name.set_oversampling
+     * @param ( {1 - 16} samples );
+     * @return none
+     */
+    void set_oversampling (const uint8_t &setOversampling = 4);
+
+
+    /**
+     * @brief Read the pin from the background ADC scan engine (zero blocking) instead of analogRead () in the loop.
+     * @brief AVR: Conversion complete interrupt. Do not use analogRead () elsewhere meanwhile. Other boards: one analogRead () per loop, round robin.
+     * @brief Requires a scan table in the sketch (MTD2A_globalAdcScan). Otherwise warning 134 and analogRead () in the loop.
+     * @name object_name.set_adcScan
+     * @param ( {ENABLE | DISABLE} );
+     * @return none
+     */
+    void set_adcScan (const bool &setEnableOrDisable = ENABLE);
+
+
+    // Getters -----------------------------------------------
+
+
+    /**
+     * @brief Get filtered analog value (mean of the samples in the last loop)
+     * @name object_name.get_analogValue ();
+     * @param none
+     * @return uint16_t {0 - 1023} AVR, {0 - 4095} ESP32
+     */
+    uint16_t const &get_analogValue () const;
+
+
+    /**
+     * @brief Get time used by analogRead () in the last loop (all samples)
+     * @name object_name.get_sampleTimeUS ();
+     * @param none
+     * @return uint32_t Microseconds
+     */
+    uint32_t const &get_sampleTimeUS () const;
+
+
+    /**
+     * @brief Get ADC scan state
+     * @name object_name.get_adcScan ();
+     * @param none
+     * @return bool {ENABLE | DISABLE}
+     */
+    bool get_adcScan () const;
+
+
+  private: // Functions
+
+    // Pin change interrupt and edge timing do not apply to analog readings
+    using MTD2A_binary_input::set_pinInterrupt;
+    using MTD2A_binary_input::set_microTiming;
+
+    bool     loop_fast_read () override;
+    virtual bool loop_fast_value ();
+#if MTD2A_OBJECT_STATE > 0
+    void     MTD2A_snapshot_state (MTD2A_snapshot_record &snapshotRecord) const override;
+#endif
+#if MTD2A_CONFIG > 0
+    bool     MTD2A_config_field   (const uint8_t &fieldId, const uint32_t &fieldValue, const bool &applyField) override;
+#endif
+
+}; // class MTD2A_analog_input
+
+
+#endif
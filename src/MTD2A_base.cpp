@@ -33,12 +33,34 @@
 #include "Arduino.h"
 #include "MTD2A_const.h"
 #include "MTD2A_base.h"
+#include "MTD2A_base_isr.h"
+#include "MTD2A_print_buffer.h"
+#include "MTD2A_timer.h"
+#if MTD2A_CONFIG > 0
+  #include "EEPROM.h"
+#endif
 
 
 // MTD2A static initializers (c++11 thus not class inline)
 bool     MTD2A::globalDebugPrint  {DISABLE};
 bool     MTD2A::globalErrorPrint  {ENABLE};
 uint8_t  MTD2A::globalObjectCount {0};
+#if MTD2A_LOG_LEVEL > MTD2A_LOG_NONE
+  Print *MTD2A::globalPrintPort   {&Serial};
+#else
+  Print *MTD2A::globalPrintPort   {nullptr}; // No print code. Serial is not linked unless the sketch sets a port
+#endif
+MTD2A_print_buffer *MTD2A::globalPrintBuffer {nullptr};
+uint8_t  MTD2A::globalTraceMode   {TRACE_OFF};
+uint8_t  MTD2A::globalTraceDrain  {1};
+uint16_t MTD2A::traceLostCount    {0};
+Print   *MTD2A::globalSnapshotPort {nullptr};
+uint16_t MTD2A::globalSnapshotMS  {0};
+uint8_t  MTD2A::globalSnapshotFull {10};
+uint32_t MTD2A::snapshotTimeMS    {0};
+uint8_t  MTD2A::snapshotSequence  {0};
+bool     MTD2A::globalWarmRestart {DISABLE};
+uint8_t  MTD2A::warmRestartCount  {0};
 //
 uint32_t MTD2A::globalSyncTimeMS  {0};
 uint8_t  MTD2A::globalDelayTimeMS {DELAY_10MS};
@@ -55,6 +77,115 @@ uint32_t MTD2A::beginTimeUS       {0};
 MTD2A   *MTD2A::begin {nullptr};
 MTD2A   *MTD2A::end   {nullptr};
 
+// Pin change interrupt dirty bitmap (one bit per pin change handle) and edge counters (MTD2A_base_isr.h)
+using MTD2A_isr::PIN_DIRTY_BYTES;
+using MTD2A_isr::pinDirtyMap;
+using MTD2A_isr::pinEdgeCount;
+volatile uint8_t MTD2A_isr::pinDirtyMap[PIN_DIRTY_BYTES]      {0};
+volatile uint8_t MTD2A_isr::pinEdgeCount[PIN_DIRTY_BYTES * 8] {0};
+void (*MTD2A_isr::isrSlotDetach) (const uint8_t &detachPinNumber, uint8_t &isrSlot) {nullptr};
+void (*MTD2A_isr::pinChangeDetach) (const uint8_t &detachPinNumber, const uint8_t &pinChangeHandle) {nullptr};
+void (*MTD2A_isr::irSamplePoll) () {nullptr};
+
+// ADC scan channels. The engine and the AVR ADC vector are in MTD2A_base_adc_scan.cpp (linked by set_globalAdcScan ())
+volatile MTD2A_adc_scan_entry *MTD2A_isr::adcScanTable {nullptr};
+uint8_t           MTD2A_isr::adcScanSize  {0};
+volatile uint16_t MTD2A_isr::adcScanMask  {0};
+volatile uint8_t  MTD2A_isr::adcScanFront {0};
+volatile uint16_t MTD2A_isr::adcScanCount {0};
+uint8_t (*MTD2A_isr::adcScanAttach) (const uint8_t &attachPinNumber, uint8_t &adcSlot) {nullptr};
+void    (*MTD2A_isr::adcScanPoll)   () {nullptr};
+using MTD2A_isr::adcScanTable;
+using MTD2A_isr::adcScanSize;
+using MTD2A_isr::adcScanMask;
+using MTD2A_isr::adcScanFront;
+
+// Binary trace ring buffer (MTD2A_globalTraceBuffer)
+#if MTD2A_TRACE > 0
+  static MTD2A_trace_event *traceBuffer {nullptr};
+  static uint8_t traceSize  {0};
+  static uint8_t traceHead  {0};
+  static uint8_t traceTail  {0};
+  static uint8_t traceCount {0};
+#endif
+
+
+// Phase change callback table (MTD2A_globalCallback)
+static MTD2A_callback_entry *callbackTable {nullptr};
+static uint8_t callbackSize  {0};
+static uint8_t callbackCount {0};
+
+
+// Loop hooks. Set by the setters, so sketches not using the feature do not link its loop code
+static void (*traceDrainHook)    ()                  {nullptr};
+static void (*warmSaveHook)      (MTD2A *warmObject) {nullptr};
+static void (*configCommandHook) ()                  {nullptr};
+
+
+// Snapshot frame in progress. Written in parts by MTD2A_snapshot_drain ()
+static constexpr uint8_t SNAPSHOT_RECORD_BYTES {1 + 6 + 4};
+static constexpr uint8_t SNAPSHOT_HEADER_BYTES {1 + 1 + 4 + 2 + 1 + 1};
+#if MTD2A_SNAPSHOT > 0
+  static constexpr uint8_t SNAPSHOT_IDLE {0}, SNAPSHOT_RECORDS {1}, SNAPSHOT_CHECK {2};
+  static uint8_t  snapshotBytes[2 + 2 + SNAPSHOT_HEADER_BYTES];  // Header, record or CRC bytes
+  static uint8_t  snapshotLength  {0};              // Bytes in snapshotBytes
+  static uint8_t  snapshotOffset  {0};              // Bytes of snapshotBytes written
+  static uint8_t  snapshotRecords {0};              // Records left in the frame
+  static uint8_t  snapshotStage   {SNAPSHOT_IDLE};
+  static bool     snapshotFrame   {false};          // Full snapshot (all objects)
+  static uint16_t snapshotCRC     {0xFFFF};
+  static MTD2A   *snapshotObject  {nullptr};        // Next object to serialize
+#endif
+
+
+// Link table (MTD2A_globalLink)
+#if MTD2A_LINK > 0
+  static MTD2A_link_entry *linkTable {nullptr};
+  static uint8_t linkSize    {0};
+  static uint8_t linkCount   {0};
+  static bool    linkPending {false};  // Any entry pending
+#endif
+
+
+// Warm restart area in uninitialized RAM (not cleared by a watchdog, software or brown-out reset)
+// Entries in the sketch (MTD2A_globalWarmRestart), header in the library
+#if MTD2A_WARM > 0
+  static constexpr uint16_t WARM_MAGIC {0x4D57};
+  struct MTD2A_warm_header {
+    uint16_t warmMagic;
+    uint8_t  objectCount;
+    uint8_t  headerCheck;  // ~objectCount ^ warmSize
+    uint32_t saveTimeMS;   // globalSyncTimeMS of the last save (clock of the entry times)
+  };
+  static MTD2A_warm_header warmHeader MTD2A_NOINIT;
+  static MTD2A_warm_entry *warmTable {nullptr};
+  static uint8_t warmSize {0};
+
+  static uint8_t warm_check (const MTD2A_warm_entry &warmEntry, const uint8_t &objectType, const uint8_t &objectIndex) {
+    uint8_t checkValue = (uint8_t)(0x5A ^ objectType ^ (objectIndex << 4) ^ warmEntry.phaseNumber ^ warmEntry.stateFlags ^ warmEntry.pinValue);
+    for (uint8_t byteIndex {0}; byteIndex < 4; byteIndex++)
+      checkValue = (uint8_t)((checkValue << 1 | checkValue >> 7) ^ (uint8_t)(warmEntry.timeMS >> (byteIndex * 8)));
+    return checkValue;
+  }
+#endif
+
+
+// Configuration block (EEPROM or flash table)
+#if MTD2A_CONFIG > 0
+  static constexpr uint8_t CONFIG_MAGIC  {0xA8};
+  static constexpr uint8_t CONFIG_HEADER {6};  // Magic, version, recordCount (uint16_t), CRC-16 (uint16_t)
+  static constexpr uint8_t CONFIG_RECORD {6};  // objectIndex, fieldId, fieldValue (uint32_t)
+  static const MTD2A_config_record *configTable {nullptr};  // Flash table or nullptr (EEPROM)
+  static uint16_t configAddress {0};
+  static uint16_t configCount   {0};
+  static uint8_t  configVersion {0};
+  static bool     configEEPROM  {false};
+  // Serial command line
+  static Stream  *configPort    {nullptr};
+  static char     configLine[24];
+  static uint8_t  configLength  {0};
+#endif
+
 
 // Global constants from MTD2A_base.h (MTD2A_const.h)
 constexpr bool     MTD2A::ENABLE;
@@ -70,10 +201,45 @@ constexpr bool     MTD2A::P_W_M;
 constexpr uint8_t  MTD2A::DELAY_10MS;
 constexpr uint8_t  MTD2A::DELAY_5MS;
 constexpr uint8_t  MTD2A::DELAY_1MS;
+constexpr uint8_t  MTD2A::TRACE_OFF;
+constexpr uint8_t  MTD2A::TRACE_TEXT;
+constexpr uint8_t  MTD2A::TRACE_RAW;
+constexpr uint8_t  MTD2A::ALL_PHASES;
+constexpr uint8_t  MTD2A::LINK_ACTIVATE;
+constexpr uint8_t  MTD2A::LINK_RESET;
+constexpr uint8_t  MTD2A::LINK_STOP;
+constexpr uint8_t  MTD2A::LINK_PAUSE;
+constexpr uint8_t  MTD2A::LINK_WRITE;
+constexpr uint8_t  MTD2A::CONFIG_PIN_NUMBER;
+constexpr uint8_t  MTD2A::CONFIG_PIN_MODE;
+constexpr uint8_t  MTD2A::CONFIG_DELAY_TIME;
+constexpr uint8_t  MTD2A::CONFIG_BLOCK_TIME;
+constexpr uint8_t  MTD2A::CONFIG_OUTPUT_TIME;
+constexpr uint8_t  MTD2A::CONFIG_BEGIN_DELAY;
+constexpr uint8_t  MTD2A::CONFIG_END_DELAY;
+constexpr uint8_t  MTD2A::CONFIG_BEGIN_VALUE;
+constexpr uint8_t  MTD2A::CONFIG_END_VALUE;
+constexpr uint8_t  MTD2A::CONFIG_PWM_CURVE;
+constexpr uint8_t  MTD2A::CONFIG_COUNT_DOWN;
+constexpr uint8_t  MTD2A::CONFIG_DISTANCE;
+constexpr uint8_t  MTD2A::CONFIG_TIME_OUT;
+constexpr uint8_t  MTD2A::CONFIG_THRESHOLD;
+constexpr uint8_t  MTD2A::CONFIG_HYSTERESIS;
 //
 constexpr uint8_t  MTD2A::MAX_BYTE_VALUE;
 constexpr uint8_t  MTD2A::PIN_ERROR_NO;
 constexpr uint8_t  MTD2A::NO_PRINT_PIN;
+constexpr uint8_t  MTD2A::SNAPSHOT_INPUT;
+constexpr uint8_t  MTD2A::SNAPSHOT_OUTPUT;
+constexpr uint8_t  MTD2A::SNAPSHOT_TIMER;
+constexpr uint8_t  MTD2A::SNAPSHOT_SPEED_TRAP;
+constexpr uint8_t  MTD2A::SNAPSHOT_SEQUENCE;
+constexpr uint8_t  MTD2A::SNAPSHOT_SCRIPT;
+constexpr uint8_t  MTD2A::SNAPSHOT_ANALOG;
+constexpr uint8_t  MTD2A::SNAPSHOT_CURRENT;
+constexpr uint8_t  MTD2A::SNAPSHOT_DISTANCE;
+constexpr uint8_t  MTD2A::SNAPSHOT_IR;
+constexpr uint8_t  MTD2A::SNAPSHOT_ENCODER;
 
 
 void MTD2A::set_globalDebugPrint (const bool &setEnableOrDisable) {
@@ -100,11 +266,259 @@ void MTD2A::set_globalDelayTimeMS (const uint8_t &setGlobalDelayTimeMS) {
 } // set_globalDelayTimeMS
 
 
+void MTD2A::set_objectName (const char *setObjectName, const bool &copyObjectName) {
+  MTD2A_set_object_name (setObjectName, copyObjectName);
+}
+void MTD2A::set_objectName (const __FlashStringHelper *setObjectName) {
+  MTD2A_set_object_name (setObjectName);
+} // set_objectName
+
+
+void MTD2A::set_callback (callback_type setCallback, void *setCallbackContext, const uint8_t &setPhaseMask) {
+  uint8_t callbackIndex {0};
+  while (callbackIndex < callbackCount  &&  callbackTable[callbackIndex].callbackObject != this)
+    callbackIndex++;
+  if (setCallback == nullptr) {
+    // Remove. The last entry takes its place
+    if (callbackIndex < callbackCount) {
+      callbackCount--;
+      callbackTable[callbackIndex] = callbackTable[callbackCount];
+    }
+    return;
+  }
+  if (callbackIndex >= callbackSize) {
+    if (globalDebugPrint == ENABLE ||  globalErrorPrint == ENABLE) {
+      MTD2A_print_object_name ();
+      MTD2A_print_error_text (true, 32, NO_PRINT_PIN);
+    }
+    return;
+  }
+  callbackTable[callbackIndex] = {this, setCallback, setCallbackContext, setPhaseMask};
+  if (callbackIndex == callbackCount)
+    callbackCount++;
+} // set_callback
+
+
+void MTD2A::set_globalCallback (MTD2A_callback_entry *setCallbackTable, const uint8_t &setCallbackSize) {
+  callbackTable = setCallbackTable;
+  callbackSize  = (setCallbackTable != nullptr) ? setCallbackSize : 0;
+  callbackCount = 0;
+} // set_globalCallback
+
+
+void MTD2A::set_globalPrintPort (Print &setPrintPort) {
+  globalPrintPort = &setPrintPort;
+} // set_globalPrintPort
+
+
+void MTD2A::set_globalTrace (const uint8_t &setTraceMode, const uint8_t &setDrainEvents) {
+#if MTD2A_TRACE > 0
+  // No trace buffer. Keep TRACE_OFF, so phase text is still printed
+  if (traceSize > 0  &&  setTraceMode <= TRACE_RAW)
+    globalTraceMode = setTraceMode;
+  if (setDrainEvents > 0)
+    globalTraceDrain = setDrainEvents;
+#else
+  (void)setTraceMode;
+  (void)setDrainEvents;
+#endif
+} // set_globalTrace
+
+
+void MTD2A::set_globalTraceBuffer (MTD2A_trace_event *setTraceBuffer, const uint8_t &setTraceSize) {
+#if MTD2A_TRACE > 0
+  traceBuffer = setTraceBuffer;
+  traceSize   = (setTraceBuffer != nullptr) ? setTraceSize : 0;
+  traceHead   = 0;
+  traceTail   = 0;
+  traceCount  = 0;
+  if (traceSize == 0)
+    globalTraceMode = TRACE_OFF;
+  traceDrainHook = MTD2A_trace_drain;
+#else
+  (void)setTraceBuffer;
+  (void)setTraceSize;
+#endif
+} // set_globalTraceBuffer
+
+
+void MTD2A::set_globalSnapshot (Print &setSnapshotPort, const uint16_t &setIntervalMS, const uint8_t &setFullEvery) {
+  globalSnapshotPort = &setSnapshotPort;
+  globalSnapshotMS   = setIntervalMS;
+  if (setFullEvery > 0)
+    globalSnapshotFull = setFullEvery;
+  // First snapshot is a full snapshot
+  snapshotSequence = 0;
+  snapshotTimeMS   = globalSyncTimeMS;
+} // set_globalSnapshot
+
+
+void MTD2A::set_link (MTD2A &setSourceObject, const uint8_t &setSourcePhase, MTD2A &setTargetObject, const uint8_t &setLinkAction, const uint8_t &setActionValue) {
+  uint8_t linkError {0};
+#if MTD2A_LINK > 0
+  if (linkCount >= linkSize)
+    linkError = 20;
+  else if (setSourcePhase > 7  ||  setTargetObject.MTD2A_link_action (setLinkAction, setActionValue, false) == false)
+    linkError = 21;
+  else {
+    linkTable[linkCount] = {&setSourceObject, &setTargetObject, setSourcePhase, setLinkAction, setActionValue, false};
+    linkCount++;
+  }
+#else
+  (void)setSourceObject;
+  (void)setSourcePhase;
+  (void)setTargetObject;
+  (void)setLinkAction;
+  (void)setActionValue;
+  linkError = 20;
+#endif
+  if (linkError != 0  &&  (globalDebugPrint == ENABLE ||  globalErrorPrint == ENABLE)) {
+    PortPrint ("set_link");
+    MTD2A_print_error_text (true, linkError, NO_PRINT_PIN);
+  }
+} // set_link
+
+
+void MTD2A::set_globalLink (MTD2A_link_entry *setLinkTable, const uint8_t &setLinkSize) {
+#if MTD2A_LINK > 0
+  linkTable   = setLinkTable;
+  linkSize    = (setLinkTable != nullptr) ? setLinkSize : 0;
+  linkCount   = 0;
+  linkPending = false;
+#else
+  (void)setLinkTable;
+  (void)setLinkSize;
+#endif
+} // set_globalLink
+
+
+void MTD2A::set_globalConfig (const uint16_t &setEEPROMAddress, const uint8_t &setConfigVersion) {
+  uint8_t configError {0};
+#if MTD2A_CONFIG > 0
+  configTable   = nullptr;
+  configAddress = setEEPROMAddress;
+  configVersion = setConfigVersion;
+  configEEPROM  = true;
+  configCount   = 0;
+  if ((uint32_t)configAddress + CONFIG_HEADER > EEPROM.length())
+    configError = 28;
+  // Blank EEPROM (no magic) is an empty configuration block
+  else if (EEPROM.read(configAddress) == CONFIG_MAGIC) {
+    const uint16_t recordCount = (uint16_t)(EEPROM.read(configAddress + 2) | (EEPROM.read(configAddress + 3) << 8));
+    const uint16_t blockCRC    = (uint16_t)(EEPROM.read(configAddress + 4) | (EEPROM.read(configAddress + 5) << 8));
+    if (EEPROM.read(configAddress + 1) != configVersion  ||
+        (uint32_t)configAddress + CONFIG_HEADER + (uint32_t)recordCount * CONFIG_RECORD > EEPROM.length())
+      configError = 28;
+    else
+      configError = MTD2A_config_load (recordCount, true, blockCRC);
+  }
+#else
+  (void)setEEPROMAddress;
+  (void)setConfigVersion;
+  configError = 28;
+#endif
+  if (configError != 0  &&  (globalDebugPrint == ENABLE ||  globalErrorPrint == ENABLE)) {
+    PortPrint ("set_globalConfig");
+    MTD2A_print_error_text (true, configError, NO_PRINT_PIN);
+  }
+} // set_globalConfig
+
+
+void MTD2A::set_globalConfig (const MTD2A_config_record *setConfigTable, const uint16_t &setRecordCount) {
+  uint8_t configError {0};
+#if MTD2A_CONFIG > 0
+  // Flash table is part of the sketch (no version and CRC)
+  configTable  = setConfigTable;
+  configEEPROM = false;
+  configError  = MTD2A_config_load ((setConfigTable != nullptr) ? setRecordCount : 0, false, 0);
+#else
+  (void)setConfigTable;
+  (void)setRecordCount;
+  configError = 28;
+#endif
+  if (configError != 0  &&  (globalDebugPrint == ENABLE ||  globalErrorPrint == ENABLE)) {
+    PortPrint ("set_globalConfig");
+    MTD2A_print_error_text (true, configError, NO_PRINT_PIN);
+  }
+} // set_globalConfig
+
+
+void MTD2A::set_globalWarmRestart (MTD2A_warm_entry *setWarmTable, const uint8_t &setWarmSize, const bool &setEnableOrDisable) {
+#if MTD2A_WARM > 0
+  warmTable = setWarmTable;
+  warmSize  = (setWarmTable != nullptr) ? setWarmSize : 0;
+  const uint8_t headerCheck = (uint8_t)(~globalObjectCount ^ warmSize);
+  warmRestartCount = 0;
+  if (setEnableOrDisable == ENABLE  &&  warmSize > 0  &&  warmHeader.warmMagic == WARM_MAGIC  &&
+      warmHeader.objectCount == globalObjectCount  &&  warmHeader.headerCheck == headerCheck) {
+    // Phase times continue from now (time between the last loop and the reset is lost)
+    globalSyncTimeMS = millis();
+    for (MTD2A* object = begin; object != nullptr  &&  object->objectIndex < warmSize; object = object->next) {
+      const MTD2A_warm_entry &warmEntry = warmTable[object->objectIndex];
+      MTD2A_snapshot_record warmRecord;
+      object->MTD2A_snapshot_state (warmRecord);
+      if (warmEntry.entryCheck != warm_check (warmEntry, warmRecord.objectType, object->objectIndex))
+        continue;
+      warmRecord.phaseNumber = warmEntry.phaseNumber;
+      warmRecord.stateFlags  = warmEntry.stateFlags;
+      warmRecord.pinValue    = warmEntry.pinValue;
+      warmRecord.timeMS      = warmEntry.timeMS;
+      if (object->MTD2A_warm_restore (warmRecord) == true)
+        warmRestartCount++;
+    }
+  }
+  const bool warmEnable = (setEnableOrDisable == ENABLE  &&  warmSize > 0);
+  warmHeader.warmMagic   = (warmEnable == true) ? WARM_MAGIC : 0;
+  warmHeader.objectCount = globalObjectCount;
+  warmHeader.headerCheck = headerCheck;
+  globalWarmRestart      = warmEnable;
+  warmSaveHook           = (warmEnable == true) ? MTD2A_warm_save : nullptr;
+#else
+  (void)setWarmTable;
+  (void)setWarmSize;
+  (void)setEnableOrDisable;
+#endif
+} // set_globalWarmRestart
+
+
+void MTD2A::set_globalConfigPort (Stream &setConfigPort) {
+#if MTD2A_CONFIG > 0
+  configPort   = &setConfigPort;
+  configLength = 0;
+  configCommandHook = MTD2A_config_command;
+#else
+  (void)setConfigPort;
+#endif
+} // set_globalConfigPort
+
+
 uint8_t MTD2A::get_globalDelayTimeMS () {
   return globalDelayTimeMS;
 }
 
 
+uint8_t MTD2A::get_globalWarmRestart () {
+  return warmRestartCount;
+} // get_globalWarmRestart
+
+
+uint16_t MTD2A::get_globalAdcScanCount () {
+  noInterrupts();
+  const uint16_t scanCount = MTD2A_isr::adcScanCount;
+  interrupts();
+  return scanCount;
+} // get_globalAdcScanCount
+
+
+uint16_t MTD2A::get_globalConfigCount () {
+#if MTD2A_CONFIG > 0
+  return configCount;
+#else
+  return 0;
+#endif
+} // get_globalConfigCount
+
+
 uint32_t MTD2A::get_globalSyncTimeMS () {
   return globalSyncTimeMS;
 }
@@ -128,6 +542,13 @@ uint8_t MTD2A::get_globalObjectCount () {
 }
 
 
+uint16_t MTD2A::get_reset_traceLostCount () {
+  uint16_t tempLostCount = traceLostCount;
+  traceLostCount = 0;
+  return tempLostCount;
+} // get_reset_traceLostCount
+
+
 // ========== Function pointer linked list of the function "loop_fast" instantiated object
 void MTD2A::MTD2A_add_function_pointer_loop_fast (MTD2A* object) {
   if (begin == nullptr)
@@ -136,6 +557,7 @@ void MTD2A::MTD2A_add_function_pointer_loop_fast (MTD2A* object) {
     end->next = object;
   }
   end = object;
+  object->objectIndex = globalObjectCount;
   globalObjectCount++;
 }
 
@@ -148,12 +570,40 @@ void MTD2A::loop_execute () {
   if (beginTimeUS == 0) {     
     beginTimeUS = micros();
   }
+  if (MTD2A_isr::adcScanPoll != nullptr)
+    MTD2A_isr::adcScanPoll ();
+  if (MTD2A_isr::irSamplePoll != nullptr)
+    MTD2A_isr::irSamplePoll ();
+#if MTD2A_TIMER_WHEEL > 0
+  // Expired timers are flagged before the objects execute (same loop as the time calculating engine)
+  MTD2A_timer::wheel_advance ();
+#endif
   // Execute function pointers
   MTD2A* object = begin;
   while (object != nullptr) {
     object->function_pointer(object);
+#if MTD2A_LINK > 0
+    if (linkPending == true)
+      MTD2A_link_execute ();
+#endif
+    if (warmSaveHook != nullptr)
+      warmSaveHook (object);
     object = object->next;
   }
+  if (globalTraceMode != TRACE_OFF  &&  traceDrainHook != nullptr)
+    traceDrainHook ();
+#if MTD2A_SNAPSHOT > 0
+  if (snapshotStage != SNAPSHOT_IDLE)
+    MTD2A_snapshot_drain ();
+  else if (globalSnapshotMS > 0  &&  globalSyncTimeMS - snapshotTimeMS >= globalSnapshotMS) {
+    snapshotTimeMS = globalSyncTimeMS;
+    MTD2A_snapshot_send (snapshotSequence % globalSnapshotFull == 0);
+  }
+#endif
+  if (configCommandHook != nullptr)
+    configCommandHook ();
+  if (globalPrintBuffer != nullptr)
+    globalPrintBuffer->drain ();
   // Cadence elapsed time correction from executing user code and MTD2A objects
   endTimeUS = micros();
   elapsedTimeUS = endTimeUS - beginTimeUS;
@@ -171,27 +621,39 @@ void MTD2A::loop_execute () {
 // ========== Function pointer linked list of the function "loop_fast" instantiated objects
 
 
-char *MTD2A::MTD2A_set_object_name (const char *setObjectName) {
-  if (setObjectName == nullptr) {
-    char *emptyObjectName = new char[1];
-    if (emptyObjectName != nullptr) {
-      emptyObjectName[0] = '\0';
+void MTD2A::MTD2A_set_object_name (const char *setObjectName, const bool &copyObjectName) {
+  if (objectNameCopy == true  &&  objectName != nullptr)
+    delete [] objectName;
+  objectName      = setObjectName;
+  objectNameFlash = false;
+  objectNameCopy  = false;
+  // Copy only runtime built names. String literals are kept as pointers
+  if (copyObjectName == true  &&  setObjectName != nullptr) {
+    char *newObjectName = new char[strlen(setObjectName) + 1];
+    if (newObjectName != nullptr) {
+      strcpy(newObjectName, setObjectName);
+      objectName     = newObjectName;
+      objectNameCopy = true;
     }
-    return emptyObjectName;
-  } 
-  char *newObjectName = new char[strlen(setObjectName) + 1];
-  if (newObjectName != nullptr) {
-    strcpy(newObjectName, setObjectName);
+    else
+      objectName = nullptr;
   }
-  return newObjectName;
+}
+void MTD2A::MTD2A_set_object_name (const __FlashStringHelper *setObjectName) {
+  MTD2A_set_object_name (reinterpret_cast<const char *>(setObjectName));
+  objectNameFlash = (setObjectName != nullptr);
 } // MTD2A_set_object_name
 
 
-void MTD2A::MTD2A_print_object_name (const char *printObjectName) {
-  if (printObjectName != nullptr)
-    PortPrint(printObjectName);
-  else
+void MTD2A::MTD2A_print_object_name () const {
+#if MTD2A_LOG_LEVEL >= MTD2A_LOG_ERROR
+  if (objectName == nullptr)
     PortPrint(F("Unnamed"));
+  else if (objectNameFlash == true)
+    PortPrint(reinterpret_cast<const __FlashStringHelper *>(objectName));
+  else
+    PortPrint(objectName);
+#endif
 } // MTD2A_print_object_name
 
 
@@ -285,8 +747,595 @@ uint8_t MTD2A::MTD2A_reserve_and_check_pin (const uint8_t &checkPinNumber, const
 } // MTD2A_reserve_and_check_pin
 
 
+// ========== Pin change interrupt dirty bitmap and edge counters
+// The pin change interrupt vectors and the external interrupt slots: MTD2A_base_interrupt.cpp
+
+
+uint8_t MTD2A::MTD2A_get_reset_pin_edges (const uint8_t &pinChangeHandle) {
+  const uint8_t pinByte {(uint8_t)(pinChangeHandle >> 3)};
+  const uint8_t pinMask {(uint8_t)(1 << (pinChangeHandle & 7))};
+  // Fast path without disabling interrupts
+  if ((pinDirtyMap[pinByte] & pinMask) == 0)
+    return 0;
+  noInterrupts();
+  uint8_t pinEdges = pinEdgeCount[pinChangeHandle];
+  pinEdgeCount[pinChangeHandle] = 0;
+  pinDirtyMap[pinByte] &= (uint8_t)~pinMask;
+  interrupts();
+  // Dirty without counted edges (set_pin_dirty) 
+  if (pinEdges == 0)
+    pinEdges = 1;
+  return pinEdges;
+} // MTD2A_get_reset_pin_edges
+
+
+void MTD2A::MTD2A_set_pin_dirty (const uint8_t &pinChangeHandle) {
+  if (pinChangeHandle < PIN_DIRTY_BYTES * 8) {
+    noInterrupts();
+    pinDirtyMap[pinChangeHandle >> 3] |= (uint8_t)(1 << (pinChangeHandle & 7));
+    interrupts();
+  }
+} // MTD2A_set_pin_dirty
+
+
+void MTD2A::MTD2A_detach_isr_slot (const uint8_t &detachPinNumber, uint8_t &isrSlot) {
+  // Slots are only linked and attached by MTD2A_attach_isr_slot ()
+  if (isrSlot != PIN_ERROR_NO  &&  MTD2A_isr::isrSlotDetach != nullptr)
+    MTD2A_isr::isrSlotDetach (detachPinNumber, isrSlot);
+  isrSlot = PIN_ERROR_NO;
+} // MTD2A_detach_isr_slot
+
+
+void MTD2A::MTD2A_detach_pin_change (const uint8_t &detachPinNumber, const uint8_t &pinChangeHandle) {
+  // Pin changes are only linked and attached by MTD2A_attach_pin_change ()
+  if (pinChangeHandle < PIN_DIRTY_BYTES * 8  &&  MTD2A_isr::pinChangeDetach != nullptr)
+    MTD2A_isr::pinChangeDetach (detachPinNumber, pinChangeHandle);
+} // MTD2A_detach_pin_change
+// ========== Pin change interrupt dirty bitmap and edge counters
+
+
+// ========== ADC scan engine
+
+
+uint8_t MTD2A::MTD2A_adc_scan_attach (const uint8_t &attachPinNumber, uint8_t &adcSlot) {
+  adcSlot = PIN_ERROR_NO;
+  if (attachPinNumber == PIN_ERROR_NO)
+    return 1;
+  // No scan table (MTD2A_globalAdcScan)
+  if (MTD2A_isr::adcScanAttach == nullptr)
+    return 134;  // Warning, continue analogRead ()
+  return MTD2A_isr::adcScanAttach (attachPinNumber, adcSlot);
+} // MTD2A_adc_scan_attach
+
+
+void MTD2A::MTD2A_adc_scan_detach (uint8_t &adcSlot) {
+  if (adcSlot < adcScanSize) {
+    noInterrupts();
+    adcScanMask &= (uint16_t)~(1U << adcSlot);
+    interrupts();
+  }
+  adcSlot = PIN_ERROR_NO;
+} // MTD2A_adc_scan_detach
+
+
+uint16_t MTD2A::MTD2A_adc_scan_value (const uint8_t &adcSlot) {
+  // Repeat if the buffers were swapped while reading (uint16_t is two byte reads on AVR)
+  uint8_t  scanFront;
+  uint16_t scanValue;
+  do {
+    scanFront = adcScanFront;
+    scanValue = adcScanTable[adcSlot].scanValue[scanFront];
+  } while (scanFront != adcScanFront);
+  return scanValue;
+} // MTD2A_adc_scan_value
+
+
+void MTD2A::MTD2A_adc_scan_stats (const uint8_t &adcSlot, MTD2A_adc_stats &adcStats) {
+  // Copy and clear (read and reset)
+  volatile MTD2A_adc_stats &slotStats = adcScanTable[adcSlot].scanStats;
+  noInterrupts();
+  adcStats.sumValue    = slotStats.sumValue;
+  adcStats.sumSquare   = slotStats.sumSquare;
+  adcStats.minValue    = slotStats.minValue;
+  adcStats.maxValue    = slotStats.maxValue;
+  adcStats.sampleCount = slotStats.sampleCount;
+  slotStats.sumValue    = 0;
+  slotStats.sumSquare   = 0;
+  slotStats.sampleCount = 0;
+  interrupts();
+} // MTD2A_adc_scan_stats
+// ========== ADC scan engine
+
+
+// ========== Binary trace ring buffer
+void MTD2A::MTD2A_trace_phase (const uint8_t &tracePhaseNumber, const uint8_t &traceErrorNumber) {
+#if MTD2A_TRACE > 0
+  if (globalTraceMode != TRACE_OFF) {
+    if (traceCount < traceSize) {
+      MTD2A_trace_event &traceEvent = traceBuffer[traceHead];
+      traceEvent.tickMS      = (uint16_t)globalSyncTimeMS;
+      traceEvent.objectIndex = objectIndex;
+      traceEvent.phaseNumber = tracePhaseNumber;
+      traceEvent.errorNumber = traceErrorNumber;
+      traceHead = (uint8_t)((traceHead + 1) % traceSize);
+      traceCount++;
+    }
+    else if (traceLostCount < UINT16_MAX) {
+      traceLostCount++;
+    }
+  }
+#endif
+  // Errors are not phase changes
+  if (traceErrorNumber != 0)
+    return;
+#if MTD2A_LINK > 0
+  // Evaluated by MTD2A_loop_execute () right after the object
+  for (uint8_t linkIndex {0}; linkIndex < linkCount; linkIndex++) {
+    MTD2A_link_entry &linkEntry = linkTable[linkIndex];
+    if (linkEntry.sourceObject == this  &&  linkEntry.sourcePhase == tracePhaseNumber) {
+      linkEntry.linkPending = true;
+      linkPending = true;
+    }
+  }
+#endif
+  // Phase change callback
+  for (uint8_t callbackIndex {0}; callbackIndex < callbackCount; callbackIndex++) {
+    const MTD2A_callback_entry &callbackEntry = callbackTable[callbackIndex];
+    if (callbackEntry.callbackObject == this  &&  tracePhaseNumber < 8  &&  (callbackEntry.callbackMask & (1 << tracePhaseNumber)))
+      callbackEntry.callbackFunction (tracePhaseNumber, callbackEntry.callbackContext);
+  }
+} // MTD2A_trace_phase
+
+
+void MTD2A::MTD2A_trace_drain () {
+#if MTD2A_TRACE > 0
+  // Rate limited: at most globalTraceDrain events per loop
+  for (uint8_t drainCount {0}; drainCount < globalTraceDrain  &&  traceCount > 0; drainCount++) {
+    const MTD2A_trace_event &traceEvent = traceBuffer[traceTail];
+    if (globalTraceMode == TRACE_RAW) {
+      if (globalPrintPort == nullptr)
+        break;
+      // Frame: 0xA5, tickMS (LSB first), objectIndex, phaseNumber, errorNumber
+      const uint8_t traceFrame[6] {0xA5, (uint8_t)(traceEvent.tickMS & 0xFF), (uint8_t)(traceEvent.tickMS >> 8),
+                                   traceEvent.objectIndex, traceEvent.phaseNumber, traceEvent.errorNumber};
+      globalPrintPort->write(traceFrame, sizeof(traceFrame));
+    }
+    else {
+#if MTD2A_LOG_LEVEL > MTD2A_LOG_NONE
+      // Text: tickMS object name: [phase] and error number
+      MTD2A* object = begin;
+      while (object != nullptr  &&  object->objectIndex != traceEvent.objectIndex)
+        object = object->next;
+      PortPrint(traceEvent.tickMS); PortPrint(F(" "));
+      if (object != nullptr)
+        object->MTD2A_print_object_name ();
+      PortPrint(F(": [")); PortPrint(traceEvent.phaseNumber); PortPrint(F("]"));
+      if (traceEvent.errorNumber != 0) {
+        PortPrint(F(" Error: ")); PortPrint(traceEvent.errorNumber);
+      }
+      PortPrintln();
+#endif
+    }
+    traceTail = (uint8_t)((traceTail + 1) % traceSize);
+    traceCount--;
+  }
+#endif
+} // MTD2A_trace_drain
+// ========== Binary trace ring buffer
+
+
+// ========== Link table
+// Actions only request a change (e.g. activate ()). The target executes it in its own loop_fast (),
+// thus chained links never call each other recursively.
+bool MTD2A::MTD2A_link_action (const uint8_t &linkAction, const uint8_t &actionValue, const bool &executeAction) {
+  // No link actions in the base class
+  (void)linkAction;
+  (void)actionValue;
+  (void)executeAction;
+  return false;
+} // MTD2A_link_action
+
+
+void MTD2A::MTD2A_link_execute () {
+#if MTD2A_LINK > 0
+  // Pending flags are set by MTD2A_trace_phase (). No link state in the objects
+  linkPending = false;
+  for (uint8_t linkIndex {0}; linkIndex < linkCount; linkIndex++) {
+    MTD2A_link_entry &linkEntry = linkTable[linkIndex];
+    if (linkEntry.linkPending == true) {
+      linkEntry.linkPending = false;
+      linkEntry.targetObject->MTD2A_link_action (linkEntry.linkAction, linkEntry.actionValue, true);
+    }
+  }
+#endif
+} // MTD2A_link_execute
+// ========== Link table
+
+
+// ========== Warm restart
+#if MTD2A_WARM > 0
+bool MTD2A::MTD2A_warm_restore (const MTD2A_snapshot_record &warmRecord) {
+  // Not resumed: Normal cold start of the object
+  (void)warmRecord;
+  return false;
+} // MTD2A_warm_restore
+#endif
+
+
+void MTD2A::MTD2A_warm_save (MTD2A *warmObject) {
+#if MTD2A_WARM > 0
+  if (warmObject->objectIndex >= warmSize)
+    return;
+  MTD2A_snapshot_record warmRecord;
+  warmObject->MTD2A_snapshot_state (warmRecord);
+  warmHeader.saveTimeMS = globalSyncTimeMS;
+  MTD2A_warm_entry &warmEntry = warmTable[warmObject->objectIndex];
+  warmEntry.timeMS      = warmRecord.timeMS;
+  warmEntry.phaseNumber = warmRecord.phaseNumber;
+  warmEntry.stateFlags  = warmRecord.stateFlags;
+  warmEntry.pinValue    = warmRecord.pinValue;
+  warmEntry.entryCheck  = warm_check (warmEntry, warmRecord.objectType, warmObject->objectIndex);
+#else
+  (void)warmObject;
+#endif
+} // MTD2A_warm_save
+
+
+uint32_t MTD2A::MTD2A_warm_time () {
+#if MTD2A_WARM > 0
+  return warmHeader.saveTimeMS;
+#else
+  return globalSyncTimeMS;
+#endif
+} // MTD2A_warm_time
+// ========== Warm restart
+
+
+// ========== Configuration block
+// EEPROM block (multi byte values LSB first):
+//   0xA8, version, recordCount (uint16_t), CRC-16/CCITT-FALSE of all records (uint16_t),
+//   records: objectIndex, fieldId, fieldValue (uint32_t) (6 bytes each)
+#if MTD2A_CONFIG > 0
+bool MTD2A::MTD2A_config_field (const uint8_t &fieldId, const uint32_t &fieldValue, const bool &applyField) {
+  // No configuration fields in the base class
+  (void)fieldId;
+  (void)fieldValue;
+  (void)applyField;
+  return false;
+} // MTD2A_config_field
+#endif
+
+
+uint32_t MTD2A::MTD2A_config_value (const uint8_t &fieldId, const uint32_t &defaultValue) const {
+  uint32_t configValue {defaultValue};
+#if MTD2A_CONFIG > 0
+  MTD2A_config_record configRecord;
+  for (uint16_t recordIndex {0}; MTD2A_config_read (recordIndex, configRecord); recordIndex++) {
+    if (configRecord.objectIndex == objectIndex  &&  configRecord.fieldId == fieldId)
+      configValue = configRecord.fieldValue;
+  }
+#else
+  (void)fieldId;
+#endif
+  return configValue;
+} // MTD2A_config_value
+
+
+bool MTD2A::MTD2A_config_read (const uint16_t &recordIndex, MTD2A_config_record &configRecord) {
+#if MTD2A_CONFIG > 0
+  if (recordIndex >= configCount)
+    return false;
+  if (configTable != nullptr) {
+    memcpy_P (&configRecord, &configTable[recordIndex], sizeof(MTD2A_config_record));
+  }
+  else {
+    const uint16_t recordAddress = configAddress + CONFIG_HEADER + recordIndex * CONFIG_RECORD;
+    configRecord.objectIndex = EEPROM.read(recordAddress);
+    configRecord.fieldId     = EEPROM.read(recordAddress + 1);
+    configRecord.fieldValue  = 0;
+    for (uint8_t byteIndex {CONFIG_RECORD - 1}; byteIndex >= 2; byteIndex--)
+      configRecord.fieldValue = (configRecord.fieldValue << 8) | EEPROM.read(recordAddress + byteIndex);
+  }
+  return true;
+#else
+  (void)recordIndex;
+  (void)configRecord;
+  return false;
+#endif
+} // MTD2A_config_read
+
+
+#if MTD2A_CONFIG > 0
+uint8_t MTD2A::MTD2A_config_check (const MTD2A_config_record &configRecord) {
+  // Range of the field value, then the object must support the field
+  const uint32_t &fieldValue = configRecord.fieldValue;
+  bool validValue {false};
+  switch (configRecord.fieldId) {
+    case CONFIG_PIN_NUMBER:  validValue = (fieldValue < NUM_DIGITAL_PINS  ||  fieldValue == PIN_ERROR_NO);  break;
+    case CONFIG_PIN_MODE:    validValue = (fieldValue <= 1);                break;
+    case CONFIG_DELAY_TIME:
+    case CONFIG_BLOCK_TIME:
+    case CONFIG_OUTPUT_TIME:
+    case CONFIG_BEGIN_DELAY:
+    case CONFIG_END_DELAY:
+    case CONFIG_COUNT_DOWN:
+    case CONFIG_TIME_OUT:    validValue = (fieldValue == 0  ||  fieldValue >= globalDelayTimeMS);  break;
+    case CONFIG_BEGIN_VALUE:
+    case CONFIG_END_VALUE:   validValue = (fieldValue <= MAX_BYTE_VALUE);   break;
+    case CONFIG_PWM_CURVE:   validValue = (fieldValue <= MAX_PWM_CURVES);   break;
+    case CONFIG_DISTANCE:    validValue = (fieldValue > 0);                 break;
+    case CONFIG_THRESHOLD:
+    case CONFIG_HYSTERESIS:  validValue = (fieldValue <= 0xFFFF);           break;
+  }
+  MTD2A *configObject = MTD2A_config_object (configRecord.objectIndex);
+  if (validValue == false  ||  configObject == nullptr  ||
+      configObject->MTD2A_config_field (configRecord.fieldId, fieldValue, false) == false)
+    return 29;
+  return 0;
+} // MTD2A_config_check
+#endif
+
+
+MTD2A *MTD2A::MTD2A_config_object (const uint8_t &findObjectIndex) {
+  MTD2A* object = begin;
+  while (object != nullptr  &&  object->objectIndex != findObjectIndex)
+    object = object->next;
+  return object;
+} // MTD2A_config_object
+
+
+uint8_t MTD2A::MTD2A_config_load (const uint16_t &recordCount, const bool &checkCRC, const uint16_t &blockCRC) {
+#if MTD2A_CONFIG > 0
+  // Validate the whole block in one pass before any field is applied
+  configCount = recordCount;
+  uint8_t  configError {0};
+  uint16_t recordCRC   {0xFFFF};
+  MTD2A_config_record configRecord;
+  for (uint16_t recordIndex {0}; MTD2A_config_read (recordIndex, configRecord); recordIndex++) {
+    recordCRC = MTD2A_crc16 (recordCRC, configRecord.objectIndex);
+    recordCRC = MTD2A_crc16 (recordCRC, configRecord.fieldId);
+    for (uint8_t byteIndex {0}; byteIndex < 4; byteIndex++)
+      recordCRC = MTD2A_crc16 (recordCRC, (uint8_t)(configRecord.fieldValue >> (byteIndex * 8)));
+    if (configError == 0)
+      configError = MTD2A_config_check (configRecord);
+  }
+  if (checkCRC == true  &&  recordCRC != blockCRC)
+    configError = 28;
+  if (configError != 0) {
+    configCount = 0;
+    return configError;
+  }
+  for (uint16_t recordIndex {0}; MTD2A_config_read (recordIndex, configRecord); recordIndex++)
+    MTD2A_config_object (configRecord.objectIndex)->MTD2A_config_field (configRecord.fieldId, configRecord.fieldValue, true);
+  return 0;
+#else
+  (void)recordCount;
+  (void)checkCRC;
+  (void)blockCRC;
+  return 28;
+#endif
+} // MTD2A_config_load
+
+
+uint8_t MTD2A::MTD2A_config_store (const MTD2A_config_record &configRecord) {
+#if MTD2A_CONFIG > 0
+  // Flash table: applied to the object only
+  if (configEEPROM == false)
+    return 0;
+  MTD2A_config_record storedRecord;
+  uint16_t recordIndex {0};
+  while (MTD2A_config_read (recordIndex, storedRecord)  &&
+         (storedRecord.objectIndex != configRecord.objectIndex  ||  storedRecord.fieldId != configRecord.fieldId))
+    recordIndex++;
+  if (recordIndex == configCount) {
+    if ((uint32_t)configAddress + CONFIG_HEADER + (uint32_t)(configCount + 1) * CONFIG_RECORD > EEPROM.length())
+      return 28;
+    configCount++;
+  }
+  const uint16_t recordAddress = configAddress + CONFIG_HEADER + recordIndex * CONFIG_RECORD;
+  MTD2A_config_write (recordAddress,     configRecord.objectIndex);
+  MTD2A_config_write (recordAddress + 1, configRecord.fieldId);
+  for (uint8_t byteIndex {0}; byteIndex < 4; byteIndex++)
+    MTD2A_config_write (recordAddress + 2 + byteIndex, (uint8_t)(configRecord.fieldValue >> (byteIndex * 8)));
+  // Header with new record count and CRC
+  uint16_t recordCRC {0xFFFF};
+  for (uint16_t byteIndex {0}; byteIndex < configCount * CONFIG_RECORD; byteIndex++)
+    recordCRC = MTD2A_crc16 (recordCRC, EEPROM.read(configAddress + CONFIG_HEADER + byteIndex));
+  const uint8_t headerBytes[CONFIG_HEADER] {CONFIG_MAGIC, configVersion, (uint8_t)configCount, (uint8_t)(configCount >> 8),
+                                            (uint8_t)recordCRC, (uint8_t)(recordCRC >> 8)};
+  for (uint8_t byteIndex {0}; byteIndex < CONFIG_HEADER; byteIndex++)
+    MTD2A_config_write (configAddress + byteIndex, headerBytes[byteIndex]);
+#if defined(ESP32) || defined(ESP8266)
+  EEPROM.commit();
+#endif
+  return 0;
+#else
+  (void)configRecord;
+  return 28;
+#endif
+} // MTD2A_config_store
+
+
+void MTD2A::MTD2A_config_write (const uint16_t &writeAddress, const uint8_t &writeValue) {
+#if MTD2A_CONFIG > 0
+  // Only changed bytes are written (EEPROM wear). EEPROM.update () is AVR only
+  if (EEPROM.read(writeAddress) != writeValue)
+    EEPROM.write(writeAddress, writeValue);
+#else
+  (void)writeAddress;
+  (void)writeValue;
+#endif
+} // MTD2A_config_write
+
+
+void MTD2A::MTD2A_config_command () {
+#if MTD2A_CONFIG > 0
+  // Non blocking: Collect characters until end of line. Command: "C objectIndex fieldId value"
+  while (configPort->available() > 0) {
+    const char readChar = (char)configPort->read();
+    if (readChar != '\n'  &&  readChar != '\r') {
+      if (configLength < sizeof(configLine) - 1)
+        configLine[configLength++] = readChar;
+      continue;
+    }
+    if (configLength == 0)
+      continue;
+    configLine[configLength] = '\0';
+    configLength = 0;
+    uint8_t configError {29};
+    if (configLine[0] == 'C'  ||  configLine[0] == 'c') {
+      char *parsePointer {nullptr};
+      MTD2A_config_record configRecord;
+      configRecord.objectIndex = (uint8_t)strtoul(configLine + 1, &parsePointer, 10);
+      configRecord.fieldId     = (uint8_t)strtoul(parsePointer,   &parsePointer, 10);
+      configRecord.fieldValue  = strtoul(parsePointer, &parsePointer, 10);
+      configError = MTD2A_config_check (configRecord);
+      if (configError == 0) {
+        MTD2A_config_object (configRecord.objectIndex)->MTD2A_config_field (configRecord.fieldId, configRecord.fieldValue, true);
+        configError = MTD2A_config_store (configRecord);
+      }
+    }
+    if (configError == 0) {
+      configPort->println(F("OK"));
+    }
+    else {
+      configPort->print(F("ERROR "));
+      configPort->println(configError);
+    }
+  }
+#endif
+} // MTD2A_config_command
+// ========== Configuration block
+
+
+// ========== Binary snapshot
+// Frame (multi byte values LSB first):
+//   0xA6 0x5A, length (uint16_t, bytes from frame type to last record),
+//   frame type (0 = full, 1 = delta), sequence, globalSyncTimeMS (uint32_t), timeOverrunCount (uint16_t),
+//   objectCount, recordCount, records: objectIndex + MTD2A_snapshot_record (11 bytes each),
+//   CRC-16/CCITT-FALSE of length to last record (uint16_t)
+#if MTD2A_OBJECT_STATE > 0
+void MTD2A::MTD2A_snapshot_state (MTD2A_snapshot_record &snapshotRecord) const {
+  snapshotRecord.pinNumber = PIN_ERROR_NO;
+} // MTD2A_snapshot_state
+#endif
+
+
+uint16_t MTD2A::MTD2A_crc16 (uint16_t crcValue, const uint8_t &crcByte) {
+  crcValue ^= (uint16_t)crcByte << 8;
+  for (uint8_t bitCount {0}; bitCount < 8; bitCount++)
+    crcValue = (crcValue & 0x8000) ? (uint16_t)((crcValue << 1) ^ 0x1021) : (uint16_t)(crcValue << 1);
+  return crcValue;
+} // MTD2A_crc16
+
+
+#if MTD2A_SNAPSHOT > 0
+uint16_t MTD2A::MTD2A_snapshot_bytes (const MTD2A *object, uint8_t *recordBytes) {
+  // Serialize object record and return its CRC (delta encoding)
+  MTD2A_snapshot_record snapshotRecord;
+  object->MTD2A_snapshot_state (snapshotRecord);
+  recordBytes[0]  = object->objectIndex;
+  recordBytes[1]  = snapshotRecord.objectType;
+  recordBytes[2]  = snapshotRecord.phaseNumber;
+  recordBytes[3]  = snapshotRecord.stateFlags;
+  recordBytes[4]  = snapshotRecord.errorNumber;
+  recordBytes[5]  = snapshotRecord.pinNumber;
+  recordBytes[6]  = snapshotRecord.pinValue;
+  recordBytes[7]  = (uint8_t)(snapshotRecord.timeMS);
+  recordBytes[8]  = (uint8_t)(snapshotRecord.timeMS >> 8);
+  recordBytes[9]  = (uint8_t)(snapshotRecord.timeMS >> 16);
+  recordBytes[10] = (uint8_t)(snapshotRecord.timeMS >> 24);
+  uint16_t recordCRC {0xFFFF};
+  for (uint8_t byteCount {0}; byteCount < SNAPSHOT_RECORD_BYTES; byteCount++)
+    recordCRC = MTD2A_crc16 (recordCRC, recordBytes[byteCount]);
+  return recordCRC;
+} // MTD2A_snapshot_bytes
+#endif
+
+
+void MTD2A::MTD2A_snapshot_send (const bool &fullSnapshot) {
+#if MTD2A_SNAPSHOT > 0
+  // Count changed records. The frame is written in parts by MTD2A_snapshot_drain ()
+  uint8_t recordCount {0};
+  for (MTD2A* object = begin; object != nullptr; object = object->next) {
+    if (fullSnapshot == true  ||  MTD2A_snapshot_bytes (object, snapshotBytes) != object->snapshotCheck)
+      recordCount++;
+  }
+  const uint16_t frameLength  = SNAPSHOT_HEADER_BYTES + (uint16_t)recordCount * SNAPSHOT_RECORD_BYTES;
+  const uint32_t overrunCount = min(timeOverrunCount, (uint32_t)UINT16_MAX);
+  const uint8_t headerBytes[2 + 2 + SNAPSHOT_HEADER_BYTES] {0xA6, 0x5A,
+    (uint8_t)(frameLength & 0xFF), (uint8_t)(frameLength >> 8),
+    (uint8_t)(fullSnapshot ? 0 : 1), snapshotSequence,
+    (uint8_t)(globalSyncTimeMS), (uint8_t)(globalSyncTimeMS >> 8), (uint8_t)(globalSyncTimeMS >> 16), (uint8_t)(globalSyncTimeMS >> 24),
+    (uint8_t)(overrunCount), (uint8_t)(overrunCount >> 8),
+    globalObjectCount, recordCount};
+  memcpy (snapshotBytes, headerBytes, sizeof(headerBytes));
+  snapshotCRC = 0xFFFF;
+  for (uint8_t byteCount {2}; byteCount < sizeof(headerBytes); byteCount++)
+    snapshotCRC = MTD2A_crc16 (snapshotCRC, headerBytes[byteCount]);
+  snapshotLength  = sizeof(headerBytes);
+  snapshotOffset  = 0;
+  snapshotRecords = recordCount;
+  snapshotFrame   = fullSnapshot;
+  snapshotObject  = begin;
+  snapshotStage   = SNAPSHOT_RECORDS;
+  snapshotSequence++;
+  MTD2A_snapshot_drain ();
+#else
+  (void)fullSnapshot;
+#endif
+} // MTD2A_snapshot_send
+
+
+void MTD2A::MTD2A_snapshot_drain () {
+#if MTD2A_SNAPSHOT > 0
+  // Never more than the free output buffer space (no blocking)
+  int freeBytes = globalSnapshotPort->availableForWrite();
+  while (freeBytes > 0) {
+    if (snapshotOffset == snapshotLength) {
+      if (snapshotStage == SNAPSHOT_RECORDS) {
+        snapshotLength = 0;
+        // Records are sampled when written. Unchanged records fill up to the counted number of records
+        while (snapshotRecords > 0  &&  snapshotObject != nullptr) {
+          MTD2A *object = snapshotObject;
+          snapshotObject = object->next;
+          const uint16_t recordCheck = MTD2A_snapshot_bytes (object, snapshotBytes);
+          if (snapshotFrame == true  ||  recordCheck != object->snapshotCheck  ||
+              snapshotRecords >= (uint8_t)(globalObjectCount - object->objectIndex)) {
+            object->snapshotCheck = recordCheck;
+            for (uint8_t byteCount {0}; byteCount < SNAPSHOT_RECORD_BYTES; byteCount++)
+              snapshotCRC = MTD2A_crc16 (snapshotCRC, snapshotBytes[byteCount]);
+            snapshotLength = SNAPSHOT_RECORD_BYTES;
+            snapshotRecords--;
+            break;
+          }
+        }
+        if (snapshotLength == 0) {
+          snapshotBytes[0] = (uint8_t)(snapshotCRC & 0xFF);
+          snapshotBytes[1] = (uint8_t)(snapshotCRC >> 8);
+          snapshotLength   = 2;
+          snapshotStage    = SNAPSHOT_CHECK;
+        }
+        snapshotOffset = 0;
+      }
+      else {
+        snapshotStage = SNAPSHOT_IDLE;
+        return;
+      }
+    }
+    const uint8_t writeBytes = (uint8_t)min(freeBytes, (int)(snapshotLength - snapshotOffset));
+    globalSnapshotPort->write(&snapshotBytes[snapshotOffset], writeBytes);
+    snapshotOffset += writeBytes;
+    freeBytes      -= writeBytes;
+  }
+#endif
+} // MTD2A_snapshot_drain
+// ========== Binary snapshot
+
+
 void MTD2A::MTD2A_print_error_text 
   (const bool &DebugOrErrorPrint, const uint8_t &printErrorNumber, const uint8_t &printPinNumber) {
+#if MTD2A_LOG_LEVEL >= MTD2A_LOG_ERROR
   if (DebugOrErrorPrint == ENABLE || globalDebugPrint == ENABLE ||  globalErrorPrint == ENABLE) {
     PortPrint (F(": ")); 
     if (printErrorNumber < WARNING_START) {
@@ -316,11 +1365,29 @@ void MTD2A::MTD2A_print_error_text
       case  14: PortPrintln (F("Unknown TIMER argument"));                break;
       case  15: PortPrintln (F("globalDelayTimeMS must be : 1 - 10 MS")); break;
       case  16: PortPrintln (F("Process state must be ACTIVE"));          break;
+      case  17: PortPrintln (F("All interrupt slots in use"));            break;
+      case  18: PortPrintln (F("Out of memory"));                         break;
+      case  20: PortPrintln (F("Link table full (MTD2A_globalLink)"));     break;
+      case  21: PortPrintln (F("Link phase or action not supported"));    break;
+      case  22: PortPrintln (F("Sequence steps not set"));                break;
+      case  23: PortPrintln (F("Sequence step offsets not sorted"));      break;
+      case  24: PortPrintln (F("Script image not valid (CRC)"));          break;
+      case  25: PortPrintln (F("Unknown script instruction"));            break;
+      case  26: PortPrintln (F("Script address out of range"));           break;
+      case  27: PortPrintln (F("Script object not found"));               break;
+      case  28: PortPrintln (F("Config block not valid (version or CRC)")); break;
+      case  29: PortPrintln (F("Config object, field or value not valid")); break;
+      case  30: PortPrintln (F("ADC scan full (MTD2A_globalAdcScan)"));  break;
+      case  31: PortPrintln (F("No free IR channel (MTD2A_globalIrChannels)")); break;
+      case  32: PortPrintln (F("Callback table full (MTD2A_globalCallback)")); break;
+      case  33: PortPrintln (F("No object state (MTD2A_SNAPSHOT 0, MTD2A_WARM 0)")); break;
       case 128: PortPrintln (F("Digital Pin check not possible"));        break;
       case 129: PortPrintln (F("Analog Pin check not possible"));          break;
       case 130: PortPrintln (F("Pin used more than once"));               break;
       case 131: PortPrintln (F("PWM Pin check not possible"));            break;
       case 132: PortPrintln (F("Interupt Pin check not possible"));       break;
+      case 133: PortPrintln (F("Pin change interrupt not supported"));    break;
+      case 134: PortPrintln (F("No ADC scan table (MTD2A_globalAdcScan)")); break;
       case 140: PortPrintln (F("Timer value is zero"));                   break;
       case 150: PortPrintln (F("Output timer value is zero"));            break;
       case 151: PortPrintln (F("All three timers are zero"));             break;
@@ -329,21 +1396,41 @@ void MTD2A::MTD2A_print_error_text
       case 154: PortPrintln (F("Use RISING curve instead of FALLING"));   break;
       case 155: PortPrintln (F("Use FALLING curve instead of RISING"));   break;
       case 156: PortPrintln (F("PWM curve changed to NO_CURVE"));         break;
+      case 160: PortPrintln (F("Debounce samples must be 1 - 8"));        break;
+      case 161: PortPrintln (F("Unknown debounce mode"));                 break;
+      case 162: PortPrintln (F("Oversampling must be 1 - 16"));           break;
+      case 163: PortPrintln (F("Unknown detect mode. Set to DETECT_RMS")); break;
+      case 170: PortPrintln (F("Sensor distance is zero"));               break;
+      case 171: PortPrintln (F("Speed trap timeout"));                    break;
+      case 172: PortPrintln (F("Same entry time. Direction from exit order")); break;
+      case 180: PortPrintln (F("Steps per detent must be 1, 2 or 4"));    break;
+      case 181: PortPrintln (F("Range minimum must be < maximum"));       break;
+      case 182: PortPrintln (F("Encoder range not set"));                 break;
       default:
         PortPrint(F("Unknown error: ")); PortPrint(printErrorNumber); PortPrintln(F(" Please report"));
     }
   }
+#else
+  (void)DebugOrErrorPrint;
+  (void)printErrorNumber;
+  (void)printPinNumber;
+#endif
 } // MTD2A_print_error_text
 
 
-void MTD2A::MTD2A_print_name_state (const char *printObjectName, const bool &printProcessState) {
+void MTD2A::MTD2A_print_name_state (const bool &printProcessState) const {
+#if MTD2A_LOG_LEVEL >= MTD2A_LOG_DEBUG
   for (size_t i {1}; i < 20; i++) PortPrint(F("-")); PortPrintln();
-  PortPrint  (F("  objectName   : ")); PortPrintln(printObjectName);
+  PortPrint  (F("  objectName   : ")); MTD2A_print_object_name (); PortPrintln();
   PortPrint  (F("  processState : ")); if (printProcessState == ACTIVE) PortPrintln(F("ACTIVE")); else PortPrintln(F("COMPLETE"));
+#else
+  (void)printProcessState;
+#endif
 }; // MTD2A_print_phase_info
 
 
 void MTD2A::MTD2A_print_debug_error (const bool &printDebugPrint, const bool &printErrorPrint, const uint8_t &printErrorNumber) {
+#if MTD2A_LOG_LEVEL >= MTD2A_LOG_DEBUG
   PortPrint  (F("  debugPrint   : "));  MTD2A_print_enable_disable(printDebugPrint);
   PortPrint  (F("  globalDebugPr: "));  MTD2A_print_enable_disable(globalDebugPrint);
   PortPrint  (F("  errorPrint   : "));  MTD2A_print_enable_disable(printErrorPrint);
@@ -354,20 +1441,30 @@ void MTD2A::MTD2A_print_debug_error (const bool &printDebugPrint, const bool &pr
   }
   else
     PortPrintln(printErrorNumber);
+#else
+  (void)printDebugPrint;
+  (void)printErrorPrint;
+  (void)printErrorNumber;
+#endif
 }; // MTD2A_print_debug_error 
 
 
 void MTD2A::MTD2A_print_pin_number (const uint8_t &printPinNumber) {
+#if MTD2A_LOG_LEVEL >= MTD2A_LOG_DEBUG
   PortPrint  (F("  pinNumber    : ")); PortPrint(printPinNumber); 
   if (printPinNumber == PIN_ERROR_NO) 
     PortPrintln(F(" (NOT defined)")); 
   else 
     PortPrintln();
+#else
+  (void)printPinNumber;
+#endif
 }
 // MTD2A_print_pin_number
 
 
 void MTD2A::MTD2A_print_value_binary (const bool &binaryOrP_W_M, const uint8_t &PrintValue) {
+#if MTD2A_LOG_LEVEL >= MTD2A_LOG_DEBUG
   if (binaryOrP_W_M == P_W_M)
     PortPrintln(PrintValue);
   else {
@@ -376,34 +1473,51 @@ void MTD2A::MTD2A_print_value_binary (const bool &binaryOrP_W_M, const uint8_t &
     else 
       PortPrintln(F("LOW"));
   }
+#else
+  (void)binaryOrP_W_M;
+  (void)PrintValue;
+#endif
 } // MTD2A_print_value_binary
 
 
 void MTD2A::MTD2A_print_enable_disable (const bool &enableOrDisable) {
+#if MTD2A_LOG_LEVEL >= MTD2A_LOG_DEBUG
   if (enableOrDisable == ENABLE)
     PortPrintln(F("ENABLE"));
   else
     PortPrintln(F("DISABLE"));
+#else
+  (void)enableOrDisable;
+#endif
 } // MTD2A_print_enable_disable
 
 
 void MTD2A::MTD2A_print_pulse_fixed (const bool &pulseOrFixed) {
+#if MTD2A_LOG_LEVEL >= MTD2A_LOG_DEBUG
   if (pulseOrFixed == PULSE)
     PortPrintln(F("PULSE"));
   else
     PortPrintln(F("FIXED"));
+#else
+  (void)pulseOrFixed;
+#endif
 } // MTD2A_print_puls_fixed
 
 
 void MTD2A::MTD2A_print_normal_inverted (const bool &normalOrInverted) {
+#if MTD2A_LOG_LEVEL >= MTD2A_LOG_DEBUG
   if (normalOrInverted == NORMAL) 
     PortPrintln(F("NORMAL"));
   else 
     PortPrintln(F("INVERTED"));
+#else
+  (void)normalOrInverted;
+#endif
 }
 
 
 void MTD2A::print_conf () {
+#if MTD2A_LOG_LEVEL >= MTD2A_LOG_DEBUG
   PortPrintln(F("MTD2A_base:"));
   for (size_t i {1}; i < 20; i++) PortPrint(F("-")); PortPrintln();
   PortPrint  (F("  globalDebugPrint : ")); MTD2A_print_enable_disable(globalDebugPrint);
@@ -414,6 +1528,11 @@ void MTD2A::print_conf () {
   PortPrint  (F("  maxElapsedTimeUS : ")); PortPrintln(maxElapsedTimeUS);
   PortPrint  (F("  timeOverrunCount : ")); PortPrintln(timeOverrunCount);
   PortPrint  (F("  globalObjectCount: ")); PortPrintln(globalObjectCount);
+  PortPrint  (F("  globalConfigCount: ")); PortPrintln(get_globalConfigCount ());
+  PortPrint  (F("  globalWarmRestart: ")); PortPrintln(warmRestartCount);
+  PortPrint  (F("  adcScanCount     : ")); PortPrintln(get_globalAdcScanCount ());
+  PortPrint  (F("  irWindowCount    : ")); PortPrintln(get_globalIrWindowCount ());
   PortPrintln(F("  MS/US = Milli/Microseconds"));
+#endif
 }
 
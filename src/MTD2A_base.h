@@ -33,18 +33,200 @@
 #ifndef _MTD2A_base_H_
 #define _MTD2A_base_H_
 
-// Development an debug
-#define PortPrint(x)   Serial.print(x)
-#define PortPrintln(x) Serial.println(x)
-// Optimized production
-// #define PortPrint(x)
-// #define PortPrintln(x)
+// Log level. Set with a compiler flag, e.g. -DMTD2A_LOG_LEVEL=0 (library files do not see #define in the sketch)
+#define MTD2A_LOG_NONE  0  // Optimized production. No print code, error texts or print_conf () in the binary
+#define MTD2A_LOG_ERROR 1  // Error and warning text only
+#define MTD2A_LOG_DEBUG 2  // Development and debug. Error, warning, phase text and print_conf ()
+#ifndef MTD2A_LOG_LEVEL
+  #define MTD2A_LOG_LEVEL MTD2A_LOG_DEBUG
+#endif
+
+// Print port (default Serial, none at MTD2A_LOG_NONE). Change with MTD2A_globalPrintPort (Serial1);
+#if MTD2A_LOG_LEVEL > MTD2A_LOG_NONE
+  #define PortPrint(x)   MTD2A::globalPrintPort->print(x)
+  #define PortPrintln(x) MTD2A::globalPrintPort->println(x)
+#else
+  #define PortPrint(x)
+  #define PortPrintln(x)
+#endif
+
+// Binary trace ring buffer (MTD2A_globalTraceBuffer). Storage in the sketch. Set to 0 to remove trace code
+#ifndef MTD2A_TRACE
+  #define MTD2A_TRACE 1
+#endif
+
+// Binary state snapshot telemetry (set_globalSnapshot). Set to 0 to remove snapshot code
+#ifndef MTD2A_SNAPSHOT
+  #define MTD2A_SNAPSHOT 1
+#endif
+
+// Link table (MTD2A_globalLink and MTD2A_link). Storage in the sketch. Set to 0 to remove link code
+#ifndef MTD2A_LINK
+  #define MTD2A_LINK 1
+#endif
+
+// Configuration block in EEPROM or flash (MTD2A_globalConfig). Default 1 on boards with an EEPROM library (AVR, ESP32, ESP8266).
+// Set to 0 to remove configuration code
+#ifndef MTD2A_CONFIG
+  #if defined(__AVR__) || defined(ESP32) || defined(ESP8266)
+    #define MTD2A_CONFIG 1
+  #else
+    #define MTD2A_CONFIG 0
+  #endif
+#endif
+
+// Warm restart objects in uninitialized RAM (MTD2A_globalWarmRestart). Storage in the sketch. Set to 0 to remove warm restart code
+#ifndef MTD2A_WARM
+  #define MTD2A_WARM 1
+#endif
+
+// Object state record (MTD2A_snapshot_state of each class): snapshot, warm restart and script GET. Removed when both are 0
+#define MTD2A_OBJECT_STATE (MTD2A_SNAPSHOT > 0  ||  MTD2A_WARM > 0)
+
+// Uninitialized RAM (not cleared by a watchdog, software or brown-out reset), e.g. MTD2A_warm_entry warmTable[8] MTD2A_NOINIT;
+#if defined(__AVR__)
+  #define MTD2A_NOINIT __attribute__((section(".noinit")))
+#elif defined(ESP32)
+  #define MTD2A_NOINIT RTC_NOINIT_ATTR
+#else
+  #define MTD2A_NOINIT  // Cleared at reset: Always a cold start
+#endif
+
+// ADC scan engine (analog_input set_adcScan). Channels in the sketch (MTD2A_globalAdcScan). The AVR ADC interrupt vector is only
+// linked by sketches calling MTD2A_globalAdcScan (MTD2A_base_adc_scan.cpp), otherwise it is free for other libraries
+// ADC conversions per MTD2A_loop_execute () on boards without the AVR conversion complete interrupt (polled scan)
+#ifndef MTD2A_ADC_POLL_SAMPLES
+  #define MTD2A_ADC_POLL_SAMPLES 1
+#endif
+
+// Modulated IR demodulator (ir_input). Channels in the sketch (MTD2A_globalIrChannels). The AVR timer 0 compare A interrupt vector
+// is only linked by sketches using ir_input (MTD2A_base_ir.cpp)
+// IR correlation window in code periods of 16 samples (AVR: 1 sample per ms. Other boards: 1 sample per MTD2A_loop_execute ())
+#ifndef MTD2A_IR_WINDOW
+  #define MTD2A_IR_WINDOW 4
+#endif
+
+// Timer engine (MTD2A_timer). 0 = every running timer calculates remaining and elapsed time every loop.
+// 1 = hierarchical timing wheel (8 levels of 16 slots): O(1) start, pause and stop, expiry cost per expiring timer,
+// remaining and elapsed time calculated on demand by the getters. For hundreds of timers (128 slot pointers RAM)
+// Build flag, not a sketch call: the wheel changes the layout of every MTD2A_timer (PlatformIO build_flags or arduino-cli)
+#ifndef MTD2A_TIMER_WHEEL
+  #define MTD2A_TIMER_WHEEL 0
+#endif
+
+// Pin change interrupts (binary_input set_pinInterrupt). The AVR PCINT vectors are only linked by sketches using interrupt inputs
+// (MTD2A_base_interrupt.cpp). Set to 0 if such a sketch also use another library with PCINT vectors (SoftwareSerial etc.)
+#ifndef MTD2A_PIN_CHANGE_ISR
+  #define MTD2A_PIN_CHANGE_ISR 1
+#endif
+#if defined(ESP32) || defined(ESP8266)
+  #define MTD2A_ISR_ATTR IRAM_ATTR
+#else
+  #define MTD2A_ISR_ATTR
+#endif
 
 
 #include "Arduino.h"
 #include "MTD2A_const.h"
 
 
+class MTD2A_print_buffer;
+class MTD2A;
+
+
+// Phase change callback table entry (MTD2A_globalCallback). Storage in the sketch, e.g. MTD2A_callback_entry callbackTable[4];
+struct MTD2A_callback_entry {
+  MTD2A   *callbackObject;
+  void   (*callbackFunction) (const uint8_t phaseNumber, void *callbackContext);
+  void    *callbackContext;
+  uint8_t  callbackMask;  // One bit per phase number
+};
+
+
+// Binary trace event (MTD2A_globalTraceBuffer). Storage in the sketch, e.g. MTD2A_trace_event traceBuffer[32];
+struct MTD2A_trace_event {
+  uint16_t tickMS;       // globalSyncTimeMS (low 16 bits)
+  uint8_t  objectIndex;  // Instantiation order
+  uint8_t  phaseNumber;  // New phase
+  uint8_t  errorNumber;  // 0 = phase change
+};
+
+
+// Link table entry (MTD2A_globalLink). Storage in the sketch, e.g. MTD2A_link_entry linkTable[8];
+struct MTD2A_link_entry {
+  MTD2A  *sourceObject;
+  MTD2A  *targetObject;
+  uint8_t sourcePhase;
+  uint8_t linkAction;
+  uint8_t actionValue;
+  bool    linkPending;   // Source phase change since the last link evaluation
+};
+
+
+// Warm restart entry of one object (MTD2A_globalWarmRestart). Storage in the sketch, e.g. MTD2A_warm_entry warmTable[8] MTD2A_NOINIT;
+struct MTD2A_warm_entry {
+  uint32_t timeMS;       // MTD2A_snapshot_record timeMS
+  uint8_t  phaseNumber;
+  uint8_t  stateFlags;   // Bit 0 processState
+  uint8_t  pinValue;
+  uint8_t  entryCheck;   // Check value incl. object type and index
+};
+
+
+// Per object state in a binary snapshot frame (11 bytes incl. object index). Decoder: extras/MTD2A_snapshot_decoder.py
+struct MTD2A_snapshot_record {
+  uint8_t  objectType  {0};  // SNAPSHOT_INPUT = 1, SNAPSHOT_OUTPUT = 2, SNAPSHOT_TIMER = 3, SNAPSHOT_SPEED_TRAP = 4, SNAPSHOT_SEQUENCE = 5, SNAPSHOT_SCRIPT = 6, SNAPSHOT_ANALOG = 7, SNAPSHOT_CURRENT = 8, SNAPSHOT_DISTANCE = 9, SNAPSHOT_IR = 10, SNAPSHOT_ENCODER = 11
+  uint8_t  phaseNumber {0};
+  uint8_t  stateFlags  {0};  // Bit 0 processState, bit 1 phaseChange
+  uint8_t  errorNumber {0};
+  uint8_t  pinNumber   {0};  // PIN_ERROR_NO (255) = no pin
+  uint8_t  pinValue    {0};  // Input pin state or output pin value
+  uint32_t timeMS      {0};  // Class specific time (see MTD2A_snapshot_state () of the object type)
+};
+
+
+// ADC scan statistics of one channel since the last reading (current_detector). Max 255 samples
+struct MTD2A_adc_stats {
+  uint32_t sumValue    {0};  // Sum of samples
+  uint32_t sumSquare   {0};  // Sum of squared samples
+  uint16_t minValue    {0};
+  uint16_t maxValue    {0};
+  uint8_t  sampleCount {0};
+};
+
+
+// ADC scan channel (MTD2A_globalAdcScan). Storage in the sketch, e.g. MTD2A_adc_scan_entry adcScanTable[4]; (one per set_adcScan, max 16)
+struct MTD2A_adc_scan_entry {
+  uint8_t         pinNumber;
+  uint16_t        scanValue[2];  // Double buffer (front and back)
+  MTD2A_adc_stats scanStats;     // Statistics since the last reading
+};
+
+
+// Modulated IR channel (MTD2A_globalIrChannels). Storage in the sketch, e.g. MTD2A_ir_channel irChannels[2]; (one per ir_input, max 8)
+struct MTD2A_ir_channel {
+  uint8_t           ledPin;
+  uint8_t           receiverPin;
+#if defined(__AVR__)
+  volatile uint8_t *ledPort;       // LED port output register
+  volatile uint8_t *receiverPort;  // Receiver port input register
+  uint8_t           ledMask;       // LED port bit
+  uint8_t           receiverMask;  // Receiver port bit
+#endif
+  uint16_t          walshCode;     // One bit (LED on) per sample
+  volatile int16_t  sumValue;      // Correlation of the current window
+  volatile int16_t  windowValue;   // Correlation of the last complete window
+};
+
+
+// Configuration record (MTD2A_globalConfig). EEPROM: 6 bytes packed. Flash: const MTD2A_config_record name[] PROGMEM {...};
+struct MTD2A_config_record {
+  uint8_t  objectIndex;  // Instantiation order (first object = 0)
+  uint8_t  fieldId;      // CONFIG_PIN_NUMBER ... CONFIG_HYSTERESIS
+  uint32_t fieldValue;
+};
+
+
 class MTD2A  // base class
 { 
   // Static class that makes the attributes or methods belong to the class itself instead of to instances of the class. 
@@ -53,12 +235,33 @@ class MTD2A  // base class
     friend class MTD2A_timer;
     friend class MTD2A_binary_output;
     friend class MTD2A_binary_input;
+    friend class MTD2A_analog_input;
+    friend class MTD2A_current_detector;
+    friend class MTD2A_distance_input;
+    friend class MTD2A_ir_input;
+    friend class MTD2A_encoder_input;
+    friend class MTD2A_speed_trap;
+    friend class MTD2A_print_buffer;
+    friend class MTD2A_sequence;
+    friend class MTD2A_script;
 
   private:
     static constexpr uint8_t  NO_PRINT_PIN   {254};
     static constexpr uint8_t  WARNING_START  {128};
     static constexpr uint8_t  MAX_PWM_CURVES {16};
     static constexpr uint16_t MS_to_US       {1000};
+    // Snapshot object types
+    static constexpr uint8_t  SNAPSHOT_INPUT      {1};
+    static constexpr uint8_t  SNAPSHOT_OUTPUT     {2};
+    static constexpr uint8_t  SNAPSHOT_TIMER      {3};
+    static constexpr uint8_t  SNAPSHOT_SPEED_TRAP {4};
+    static constexpr uint8_t  SNAPSHOT_SEQUENCE   {5};
+    static constexpr uint8_t  SNAPSHOT_SCRIPT     {6};
+    static constexpr uint8_t  SNAPSHOT_ANALOG     {7};
+    static constexpr uint8_t  SNAPSHOT_CURRENT    {8};
+    static constexpr uint8_t  SNAPSHOT_DISTANCE   {9};
+    static constexpr uint8_t  SNAPSHOT_IR         {10};
+    static constexpr uint8_t  SNAPSHOT_ENCODER    {11};
     // Global constants from MTD2A_const.h
     static constexpr uint8_t  MAX_BYTE_VALUE {MTD2A_const::MAX_BYTE_VALUE};
     static constexpr uint8_t  PIN_ERROR_NO   {MTD2A_const::PIN_ERROR_NO};
@@ -76,6 +279,30 @@ class MTD2A  // base class
     static constexpr uint8_t  DELAY_10MS {MTD2A_const::DELAY_10MS};
     static constexpr uint8_t  DELAY_5MS  {MTD2A_const::DELAY_5MS};
     static constexpr uint8_t  DELAY_1MS  {MTD2A_const::DELAY_1MS};
+    static constexpr uint8_t  TRACE_OFF  {MTD2A_const::TRACE_OFF};
+    static constexpr uint8_t  TRACE_TEXT {MTD2A_const::TRACE_TEXT};
+    static constexpr uint8_t  TRACE_RAW  {MTD2A_const::TRACE_RAW};
+    static constexpr uint8_t  ALL_PHASES {MTD2A_const::ALL_PHASES};
+    static constexpr uint8_t  LINK_ACTIVATE {MTD2A_const::LINK_ACTIVATE};
+    static constexpr uint8_t  LINK_RESET    {MTD2A_const::LINK_RESET};
+    static constexpr uint8_t  LINK_STOP     {MTD2A_const::LINK_STOP};
+    static constexpr uint8_t  LINK_PAUSE    {MTD2A_const::LINK_PAUSE};
+    static constexpr uint8_t  LINK_WRITE    {MTD2A_const::LINK_WRITE};
+    static constexpr uint8_t  CONFIG_PIN_NUMBER  {MTD2A_const::CONFIG_PIN_NUMBER};
+    static constexpr uint8_t  CONFIG_PIN_MODE    {MTD2A_const::CONFIG_PIN_MODE};
+    static constexpr uint8_t  CONFIG_DELAY_TIME  {MTD2A_const::CONFIG_DELAY_TIME};
+    static constexpr uint8_t  CONFIG_BLOCK_TIME  {MTD2A_const::CONFIG_BLOCK_TIME};
+    static constexpr uint8_t  CONFIG_OUTPUT_TIME {MTD2A_const::CONFIG_OUTPUT_TIME};
+    static constexpr uint8_t  CONFIG_BEGIN_DELAY {MTD2A_const::CONFIG_BEGIN_DELAY};
+    static constexpr uint8_t  CONFIG_END_DELAY   {MTD2A_const::CONFIG_END_DELAY};
+    static constexpr uint8_t  CONFIG_BEGIN_VALUE {MTD2A_const::CONFIG_BEGIN_VALUE};
+    static constexpr uint8_t  CONFIG_END_VALUE   {MTD2A_const::CONFIG_END_VALUE};
+    static constexpr uint8_t  CONFIG_PWM_CURVE   {MTD2A_const::CONFIG_PWM_CURVE};
+    static constexpr uint8_t  CONFIG_COUNT_DOWN  {MTD2A_const::CONFIG_COUNT_DOWN};
+    static constexpr uint8_t  CONFIG_DISTANCE    {MTD2A_const::CONFIG_DISTANCE};
+    static constexpr uint8_t  CONFIG_TIME_OUT    {MTD2A_const::CONFIG_TIME_OUT};
+    static constexpr uint8_t  CONFIG_THRESHOLD   {MTD2A_const::CONFIG_THRESHOLD};
+    static constexpr uint8_t  CONFIG_HYSTERESIS  {MTD2A_const::CONFIG_HYSTERESIS};
     //
     static const uint8_t DIGITAL_FLAG_0 {1}, ANALOG_FLAG_1 {2}, INPUT_FLAG_2 {4}, PULLUP_FLAG_3    {8}, 
                          OUTPUT_FLAG_4 {16}, PWM_FLAG_5 {32},   TONE_FLAG_6 {64}, INTERRUPT_FLAG_7 {128};
@@ -85,6 +312,18 @@ class MTD2A  // base class
     static uint32_t globalSyncTimeMS;
     static uint8_t  globalDelayTimeMS;
     static uint8_t  globalObjectCount;
+    static Print   *globalPrintPort;
+    static MTD2A_print_buffer *globalPrintBuffer;
+    static uint8_t  globalTraceMode;
+    static uint8_t  globalTraceDrain;
+    static uint16_t traceLostCount;
+    static Print   *globalSnapshotPort;
+    static uint16_t globalSnapshotMS;
+    static uint8_t  globalSnapshotFull;
+    static uint32_t snapshotTimeMS;
+    static uint8_t  snapshotSequence;
+    static bool     globalWarmRestart;
+    static uint8_t  warmRestartCount;
     //
     static uint32_t delayTimeUS;
     static uint32_t elapsedTimeUS;
@@ -94,7 +333,15 @@ class MTD2A  // base class
     static uint32_t beginTimeUS;
 
   public:
-    virtual ~MTD2A() = default;
+    // Phase change callback: void function_name (const uint8_t phaseNumber, void *callbackContext)
+    using callback_type = void (*)(const uint8_t phaseNumber, void *callbackContext);
+
+    virtual ~MTD2A() {
+      if (objectNameCopy == true  &&  objectName != nullptr) {
+        delete [] objectName;
+        objectName = nullptr;
+      }
+    };
 
 
     // Setters -------------------------------------------------------------
@@ -127,6 +374,163 @@ class MTD2A  // base class
     static void set_globalDelayTimeMS (const uint8_t &setGlobalDelayTimeMS = DELAY_10MS);
 
 
+    /**
+     * @brief Set object name. The name is not copied (string literal or F("Flash name")) unless copy is enabled (runtime built names)
+     * @brief Constructors never copy the name. A temporary buffer (local char array, String c_str ()) leaves a dangling pointer: set_objectName (buffer, ENABLE)
+     * @brief F() is only legal inside functions. Global objects: const char name[] PROGMEM = "Name"; and (const __FlashStringHelper *)name, or set_objectName (F("Name")) in setup ()
+     * @name object_name.set_objectName
+     * @param ( "Object name", {ENABLE | DISABLE} ); or ( F("Object name") );
+     * @return none
+     */
+    void set_objectName (const char *setObjectName, const bool &copyObjectName = DISABLE);
+    void set_objectName (const __FlashStringHelper *setObjectName);
+
+
+    /**
+     * @brief Call a function at the moment of a phase change (same loop) instead of polling get_phaseChange ().
+     * @brief Phase mask: one bit per phase number, e.g. (1 << FIRST_TIME_PHASE) | (1 << COMPLETE_PHASE). nullptr removes the callback.
+     * @brief Uses one entry of the callback table (MTD2A_globalCallback), otherwise error 32.
+     * @name object_name.set_callback
+     * @param ( function_name, context pointer or nullptr, phaseMask {ALL_PHASES | 1 - 255} );
+     * @return none
+     */
+    void set_callback (callback_type setCallback, void *setCallbackContext = nullptr, const uint8_t &setPhaseMask = ALL_PHASES);
+
+
+    /**
+     * @brief Set the phase change callback table (storage declared in the sketch). One entry per object with a callback.
+     * @brief No callback memory in the objects. Phase changes of objects without a callback cost nothing.
+     * @name set_globalCallback
+     * @param ( MTD2A_callback_entry array, number of entries {1 - 255} );
+     * @return none
+     */
+    static void set_globalCallback (MTD2A_callback_entry *setCallbackTable, const uint8_t &setCallbackSize);
+
+
+    /**
+     * @brief Set print port for debug, error and print_conf () text for all instantiated classes
+     * @brief MTD2A_LOG_NONE has no default port. Set one for TRACE_RAW output
+     * @name set_globalPrintPort
+     * @param ( {Serial | Serial1 | any Print object} );
+     * @return none
+     */
+    static void set_globalPrintPort (Print &setPrintPort = Serial);
+
+
+    /**
+     * @brief Record phase changes and errors of all instantiated classes in a binary trace buffer instead of printing text.
+     * @brief The buffer is drained to the print port by MTD2A_loop_execute (), decoded to text or as raw 6 byte frames.
+     * @brief Requires a trace buffer (set_globalTraceBuffer). Otherwise ignored
+     * @name set_globalTrace
+     * @param ( {TRACE_OFF | TRACE_TEXT | TRACE_RAW}, drainEvents {1 - 255} per loop );
+     * @return none
+     */
+    static void set_globalTrace (const uint8_t &setTraceMode = TRACE_TEXT, const uint8_t &setDrainEvents = 1);
+
+
+    /**
+     * @brief Set the trace ring buffer (set_globalTrace). Storage in the sketch: MTD2A_trace_event traceBuffer[32]; (5 bytes per event on AVR)
+     * @brief Call before set_globalTrace (). Events are lost (get_reset_traceLostCount) when the buffer is full.
+     * @name set_globalTraceBuffer
+     * @param ( MTD2A_trace_event array, number of events {1 - 255} );
+     * @return none
+     */
+    static void set_globalTraceBuffer (MTD2A_trace_event *setTraceBuffer, const uint8_t &setTraceSize);
+
+
+    /**
+     * @brief Send a binary snapshot of the global state and the state of all instantiated classes every intervalMS.
+     * @brief Only objects with a changed state since the last snapshot are sent, except every fullEvery snapshot (all objects).
+     * @brief Frame: 0xA6 0x5A, length, type, sequence, globals, records and CRC-16. Decoder: extras/MTD2A_snapshot_decoder.py
+     * @brief Never blocks: Each loop writes no more than the free output buffer space. The port must support availableForWrite () (HardwareSerial).
+     * @name set_globalSnapshot
+     * @param ( {Serial | Serial1 | any Print object}, intervalMS {0 = off, 1 - 65535}, fullEvery {1 - 255} );
+     * @return none
+     */
+    static void set_globalSnapshot (Print &setSnapshotPort, const uint16_t &setIntervalMS = 100, const uint8_t &setFullEvery = 10);
+
+
+    /**
+     * @brief Link a source object phase to an action on a target object. Executed by MTD2A_loop_execute () right after the source object.
+     * @brief binary_output: LINK_ACTIVATE, LINK_RESET, LINK_STOP (output timer), LINK_WRITE (set_pinWriteValue (actionValue)). timer: LINK_ACTIVATE (start), LINK_RESET, LINK_STOP, LINK_PAUSE.
+     * @brief binary_input: LINK_ACTIVATE (set_inputState LOW), LINK_RESET. speed_trap and encoder_input: LINK_RESET.
+     * @brief Target objects after the source object (instantiation order) react in the same loop, otherwise in the next loop.
+     * @brief Requires a link table (set_globalLink). Otherwise error 20
+     * @name set_link
+     * @param ( source_object, {RESET_PHASE | FIRST_TIME_PHASE | ... | COMPLETE_PHASE}, target_object, {LINK_ACTIVATE | ... | LINK_WRITE}, actionValue {0 - 255} );
+     * @return none
+     */
+    static void set_link (MTD2A &setSourceObject, const uint8_t &setSourcePhase, MTD2A &setTargetObject, const uint8_t &setLinkAction, const uint8_t &setActionValue = 0);
+
+
+    /**
+     * @brief Set the link table (set_link). Storage in the sketch: MTD2A_link_entry linkTable[8]; (one entry per link)
+     * @brief Call before set_link (). Links already set are removed.
+     * @name set_globalLink
+     * @param ( MTD2A_link_entry array, number of entries {1 - 255} );
+     * @return none
+     */
+    static void set_globalLink (MTD2A_link_entry *setLinkTable, const uint8_t &setLinkSize);
+
+
+    /**
+     * @brief Set the modulated IR channel table (ir_input). Storage in the sketch: MTD2A_ir_channel irChannels[2]; (one channel per ir_input, max 8)
+     * @brief Call before initialize () of the ir_input objects. Without a table initialize () reports error 31.
+     * @name set_globalIrChannels
+     * @param ( MTD2A_ir_channel array, number of channels {1 - 8} );
+     * @return none
+     */
+    static void set_globalIrChannels (MTD2A_ir_channel *setIrChannels, const uint8_t &setIrSize);
+
+
+    /**
+     * @brief Set the ADC scan channel table (analog_input set_adcScan, current_detector). Storage in the sketch: MTD2A_adc_scan_entry adcScanTable[4]; (max 16)
+     * @brief Call before initialize () of the current_detector objects and before set_adcScan (). Without a table set_adcScan () reports warning 134.
+     * @brief AVR: Claims the ADC conversion complete interrupt vector (not linked by sketches without this call).
+     * @name set_globalAdcScan
+     * @param ( MTD2A_adc_scan_entry array, number of channels {1 - 16} );
+     * @return none
+     */
+    static void set_globalAdcScan (MTD2A_adc_scan_entry *setAdcScanTable, const uint8_t &setAdcScanSize);
+
+
+    /**
+     * @brief Validate (version, CRC and all fields in one pass) and apply a configuration block to all instantiated objects.
+     * @brief Call before initialize (). CONFIG_PIN_NUMBER and CONFIG_PIN_MODE are used by initialize (), other fields are applied at once.
+     * @brief EEPROM block: 0xA8, version, recordCount (uint16_t), CRC-16 of records (uint16_t), records (objectIndex, fieldId, value uint32_t).
+     * @brief Blank EEPROM is an empty block. Flash table: const MTD2A_config_record name[] PROGMEM {{objectIndex, fieldId, value}, ...};
+     * @brief Requires MTD2A_CONFIG > 0 (default AVR, ESP32 and ESP8266). ESP32 and ESP8266: Call EEPROM.begin (size) first, otherwise EEPROM.length () is 0 (error 28).
+     * @name set_globalConfig
+     * @param ( EEPROMaddress, configVersion {0 - 254} ); or ( flash_table, recordCount );
+     * @return none
+     */
+    static void set_globalConfig (const uint16_t &setEEPROMAddress = 0, const uint8_t &setConfigVersion = 1);
+    static void set_globalConfig (const MTD2A_config_record *setConfigTable, const uint16_t &setRecordCount);
+
+
+    /**
+     * @brief Update single fields live from a serial port. Command line: "C objectIndex fieldId value" (e.g. "C 2 5 1500").
+     * @brief Reply "OK" or "ERROR number". An EEPROM configuration block is updated as well (CONFIG_PIN_NUMBER takes effect after restart).
+     * @name set_globalConfigPort
+     * @param ( {Serial | Serial1 | any Stream object} );
+     * @return none
+     */
+    static void set_globalConfigPort (Stream &setConfigPort = Serial);
+
+
+    /**
+     * @brief Save phase, process state, pin value and phase time of all instantiated objects in uninitialized RAM after each object loop.
+     * @brief After a watchdog, software or brown-out reset, ENABLE resumes ACTIVE binary_output and timer objects mid-phase with adjusted deadlines.
+     * @brief Call after initialize (). Power on (RAM not valid) is a normal cold start. PWM curves continue as a fixed value.
+     * @brief Storage in the sketch (uninitialized RAM, one entry per object in instantiation order): MTD2A_warm_entry warmTable[8] MTD2A_NOINIT;
+     * @brief Objects beyond the table size always cold start. Changing the table size or number of objects is a cold start.
+     * @name set_globalWarmRestart
+     * @param ( MTD2A_warm_entry array, number of entries {1 - 255}, {ENABLE | DISABLE} );
+     * @return none
+     */
+    static void set_globalWarmRestart (MTD2A_warm_entry *setWarmTable, const uint8_t &setWarmSize, const bool &setEnableOrDisable = ENABLE);
+
+
     // getters -------------------------------------------------------------
 
 
@@ -138,6 +542,15 @@ class MTD2A  // base class
      */
     static uint8_t get_globalDelayTimeMS ();
 
+
+    /**
+     * @brief Get number of records in the configuration block
+     * @name get_globalConfigCount();
+     * @param none
+     * @return uint16_t {0 = no configuration block}
+     */
+    static uint16_t get_globalConfigCount ();
+
  
     /**
      * @brief Get current common reference time for all instantiated objects
@@ -175,6 +588,42 @@ class MTD2A  // base class
     static uint8_t get_globalObjectCount ();
 
 
+    /**
+     * @brief Get number of objects resumed by the last set_globalWarmRestart (ENABLE)
+     * @name get_globalWarmRestart ();
+     * @param none
+     * @return uint8_t count {0 = cold start}
+     */
+    static uint8_t get_globalWarmRestart ();
+
+
+    /**
+     * @brief Get number of completed ADC scan rounds (all channels converted once). Counter wraps around at 65535
+     * @name get_globalAdcScanCount ();
+     * @param none
+     * @return uint16_t count
+     */
+    static uint16_t get_globalAdcScanCount ();
+
+
+    /**
+     * @brief Get number of completed IR correlation windows (all IR channels). Counter wraps around at 65535
+     * @name get_globalIrWindowCount ();
+     * @param none
+     * @return uint16_t count
+     */
+    static uint16_t get_globalIrWindowCount ();
+
+
+    /**
+     * @brief Get and reset number of trace events lost because the trace buffer was full
+     * @name get_reset_traceLostCount ();
+     * @param none
+     * @return uint16_t count
+     */
+    static uint16_t get_reset_traceLostCount ();
+
+
     /**
      * @brief print configuration parameters, timers and state logic.
      * @name print_conf ();
@@ -192,6 +641,15 @@ class MTD2A  // base class
     MTD2A* next = nullptr;
     using function_type = void (*)(MTD2A*);
     function_type function_pointer = nullptr;
+    // Object name (string literal, flash memory or heap copy)
+    const char *objectName      {nullptr};
+    bool        objectNameFlash {false};  // F() / PROGMEM pointer
+    bool        objectNameCopy  {false};  // Heap copy (delete [] by destructor)
+    // Trace, snapshot, warm restart, configuration and script object reference. Callbacks and links are in side tables
+    uint8_t     objectIndex     {0};      // Instantiation order {0 - 254}
+#if MTD2A_SNAPSHOT > 0
+    uint16_t    snapshotCheck   {0};      // CRC-16 of the last sent snapshot record (delta encoding)
+#endif
   public:
     MTD2A(const MTD2A&) = delete;
     MTD2A& operator=(const MTD2A&) = delete;
@@ -201,15 +659,74 @@ class MTD2A  // base class
 
   private:
     // Internal functions
-    static char    *MTD2A_set_object_name       (const char     *setObjectName);
-    static void     MTD2A_print_object_name     (const char     *printObjectName);
+    void            MTD2A_set_object_name       (const char     *setObjectName,     const bool    &copyObjectName = false);
+    void            MTD2A_set_object_name       (const __FlashStringHelper *setObjectName);
+    void            MTD2A_print_object_name     () const;
     static uint8_t  MTD2A_reserve_and_check_pin (const uint8_t  &checkPinNumber,    const uint8_t &checkPinFlags);
+    // Pin change interrupt
+    static uint8_t  MTD2A_attach_pin_change     (const uint8_t  &attachPinNumber,   uint8_t       &pinChangeHandle);
+    static void     MTD2A_detach_pin_change     (const uint8_t  &detachPinNumber,   const uint8_t &pinChangeHandle);
+    static void     MTD2A_pin_change_release    (const uint8_t  &detachPinNumber,   const uint8_t &pinChangeHandle);
+    static uint8_t  MTD2A_get_reset_pin_edges   (const uint8_t  &pinChangeHandle);
+    static void     MTD2A_set_pin_dirty         (const uint8_t  &pinChangeHandle);
+    // External interrupt slots (attachInterrupt with object pointer)
+    static uint8_t  MTD2A_attach_isr_slot       (const uint8_t  &attachPinNumber,   MTD2A *isrObject, function_type isrFunction, uint8_t &isrSlot);
+    static void     MTD2A_detach_isr_slot       (const uint8_t  &detachPinNumber,   uint8_t &isrSlot);
+    static void     MTD2A_isr_slot_release      (const uint8_t  &detachPinNumber,   uint8_t &isrSlot);
+    // ADC scan engine (analog_input set_adcScan)
+    static uint8_t  MTD2A_adc_scan_attach       (const uint8_t  &attachPinNumber,   uint8_t       &adcSlot);
+    static void     MTD2A_adc_scan_detach       (uint8_t        &adcSlot);
+    static uint16_t MTD2A_adc_scan_value        (const uint8_t  &adcSlot);
+    static void     MTD2A_adc_scan_stats        (const uint8_t  &adcSlot,           MTD2A_adc_stats &adcStats);
+    // Modulated IR demodulator (ir_input)
+    static uint8_t  MTD2A_ir_attach             (const uint8_t  &ledPinNumber,      const uint8_t &receiverPinNumber, uint8_t &irSlot);
+    static void     MTD2A_ir_detach             (uint8_t        &irSlot);
+    static int16_t  MTD2A_ir_value              (const uint8_t  &irSlot);
+
+    // Binary trace and phase change callback
+    void            MTD2A_trace_phase           (const uint8_t  &tracePhaseNumber,  const uint8_t &traceErrorNumber = 0);
+    static void     MTD2A_trace_drain           ();
+
+    // Binary snapshot
+#if MTD2A_OBJECT_STATE > 0
+    virtual void    MTD2A_snapshot_state        (MTD2A_snapshot_record &snapshotRecord) const;
+#endif
+#if MTD2A_SNAPSHOT > 0
+    static uint16_t MTD2A_snapshot_bytes        (const MTD2A    *object,            uint8_t       *recordBytes);
+#endif
+    static void     MTD2A_snapshot_send         (const bool     &fullSnapshot);
+    static void     MTD2A_snapshot_drain        ();
+    // Link table
+    virtual bool    MTD2A_link_action           (const uint8_t  &linkAction,        const uint8_t &actionValue,      const bool &executeAction);
+    static void     MTD2A_link_execute          ();
+    // Warm restart
+#if MTD2A_WARM > 0
+    virtual bool    MTD2A_warm_restore          (const MTD2A_snapshot_record &warmRecord);
+#endif
+    static void     MTD2A_warm_save             (MTD2A          *warmObject);
+    static uint32_t MTD2A_warm_time             ();
+    // Configuration block
+#if MTD2A_CONFIG > 0
+    virtual bool    MTD2A_config_field          (const uint8_t  &fieldId,           const uint32_t &fieldValue,      const bool &applyField);
+#endif
+    uint32_t        MTD2A_config_value          (const uint8_t  &fieldId,           const uint32_t &defaultValue) const;
+    static bool     MTD2A_config_read           (const uint16_t &recordIndex,       MTD2A_config_record &configRecord);
+#if MTD2A_CONFIG > 0
+    static uint8_t  MTD2A_config_check          (const MTD2A_config_record &configRecord);
+#endif
+    static MTD2A   *MTD2A_config_object         (const uint8_t  &objectIndex);
+    static uint8_t  MTD2A_config_load           (const uint16_t &recordCount,       const bool    &checkCRC,         const uint16_t &blockCRC);
+    static uint8_t  MTD2A_config_store          (const MTD2A_config_record &configRecord);
+    static void     MTD2A_config_write          (const uint16_t &writeAddress,      const uint8_t &writeValue);
+    static void     MTD2A_config_command        ();
+    // CRC-16/CCITT-FALSE (snapshot frames and script images)
+    static uint16_t MTD2A_crc16                 (uint16_t       crcValue,           const uint8_t &crcByte);
 
     // Error and debug print
     static void     MTD2A_print_error_text      (const bool     &DebugOrErrorPrint, const uint8_t &printErrorNumber, const uint8_t &printPinNumber);
     static void     MTD2A_print_debug_error     (const bool     &printDebugPrint,   const bool    &printErrorPrint,  const uint8_t &printErrorNumber);
     static void     MTD2A_print_pin_number      (const uint8_t  &printPinNumber);
-    static void     MTD2A_print_name_state      (const char     *printObjectName,   const bool    &printProcessState);
+    void            MTD2A_print_name_state      (const bool     &printProcessState) const;
     static void     MTD2A_print_value_binary    (const bool     &binaryOrP_W_M,     const uint8_t &PrintValue);
     static void     MTD2A_print_enable_disable  (const bool     &enableOrDisable);
     static void     MTD2A_print_normal_inverted (const bool     &normalOrInverted);
@@ -253,6 +770,149 @@ auto MTD2A_globalErrorPrint = [](const bool &setEnableOrDisable  = MTD2A_const::
 };
 
 
+/**
+ * @brief Set print port for debug, error and print_conf () text for all instantiated classes
+ * @name MTD2A_globalPrintPort
+ * @param ( {Serial | Serial1 | any Print object} );
+ * @return none
+ */
+auto MTD2A_globalPrintPort = [](Print &setPrintPort) {
+  MTD2A::set_globalPrintPort (setPrintPort);
+};
+
+
+/**
+ * @brief Set the trace ring buffer (MTD2A_globalTrace). Storage in the sketch: MTD2A_trace_event traceBuffer[32];
+ * @name MTD2A_globalTraceBuffer
+ * @param ( MTD2A_trace_event array, number of events {1 - 255} );
+ * @return none
+ */
+auto MTD2A_globalTraceBuffer = [](MTD2A_trace_event *setTraceBuffer, const uint8_t &setTraceSize) {
+  MTD2A::set_globalTraceBuffer (setTraceBuffer, setTraceSize);
+};
+
+
+/**
+ * @brief Record phase changes and errors in a binary trace buffer instead of printing text
+ * @name MTD2A_globalTrace
+ * @param ( {TRACE_OFF | TRACE_TEXT | TRACE_RAW}, drainEvents {1 - 255} per loop );
+ * @return none
+ */
+auto MTD2A_globalTrace = [](const uint8_t &setTraceMode = MTD2A_const::TRACE_TEXT, const uint8_t &setDrainEvents = 1) {
+  MTD2A::set_globalTrace (setTraceMode, setDrainEvents);
+};
+
+
+/**
+ * @brief Send binary snapshots of the global state and the state of all instantiated classes
+ * @name MTD2A_globalSnapshot
+ * @param ( {Serial | Serial1 | any Print object}, intervalMS {0 = off, 1 - 65535}, fullEvery {1 - 255} );
+ * @return none
+ */
+auto MTD2A_globalSnapshot = [](Print &setSnapshotPort, const uint16_t &setIntervalMS = 100, const uint8_t &setFullEvery = 10) {
+  MTD2A::set_globalSnapshot (setSnapshotPort, setIntervalMS, setFullEvery);
+};
+
+
+/**
+ * @brief Set the phase change callback table (set_callback). Storage in the sketch: MTD2A_callback_entry callbackTable[4];
+ * @name MTD2A_globalCallback
+ * @param ( MTD2A_callback_entry array, number of entries {1 - 255} );
+ * @return none
+ */
+auto MTD2A_globalCallback = [](MTD2A_callback_entry *setCallbackTable, const uint8_t &setCallbackSize) {
+  MTD2A::set_globalCallback (setCallbackTable, setCallbackSize);
+};
+
+
+/**
+ * @brief Set the link table (MTD2A_link). Storage in the sketch: MTD2A_link_entry linkTable[8];
+ * @name MTD2A_globalLink
+ * @param ( MTD2A_link_entry array, number of entries {1 - 255} );
+ * @return none
+ */
+auto MTD2A_globalLink = [](MTD2A_link_entry *setLinkTable, const uint8_t &setLinkSize) {
+  MTD2A::set_globalLink (setLinkTable, setLinkSize);
+};
+
+
+/**
+ * @brief Set the ADC scan channel table (set_adcScan, current_detector). Storage in the sketch: MTD2A_adc_scan_entry adcScanTable[4];
+ * @name MTD2A_globalAdcScan
+ * @param ( MTD2A_adc_scan_entry array, number of channels {1 - 16} );
+ * @return none
+ */
+auto MTD2A_globalAdcScan = [](MTD2A_adc_scan_entry *setAdcScanTable, const uint8_t &setAdcScanSize) {
+  MTD2A::set_globalAdcScan (setAdcScanTable, setAdcScanSize);
+};
+
+
+/**
+ * @brief Set the modulated IR channel table (ir_input). Storage in the sketch: MTD2A_ir_channel irChannels[2];
+ * @name MTD2A_globalIrChannels
+ * @param ( MTD2A_ir_channel array, number of channels {1 - 8} );
+ * @return none
+ */
+auto MTD2A_globalIrChannels = [](MTD2A_ir_channel *setIrChannels, const uint8_t &setIrSize) {
+  MTD2A::set_globalIrChannels (setIrChannels, setIrSize);
+};
+
+
+/**
+ * @brief Link a source object phase to an action on a target object (no polling in loop)
+ * @name MTD2A_link
+ * @param ( source_object, {RESET_PHASE | FIRST_TIME_PHASE | ... | COMPLETE_PHASE}, target_object, {LINK_ACTIVATE | ... | LINK_WRITE}, actionValue {0 - 255} );
+ * @return none
+ */
+auto MTD2A_link = [](MTD2A &setSourceObject, const uint8_t &setSourcePhase, MTD2A &setTargetObject, const uint8_t &setLinkAction, const uint8_t &setActionValue = 0) {
+  MTD2A::set_link (setSourceObject, setSourcePhase, setTargetObject, setLinkAction, setActionValue);
+};
+
+
+/**
+ * @brief Validate and apply a configuration block (EEPROM) to all instantiated objects. Call before initialize ()
+ * @name MTD2A_globalConfig
+ * @param ( EEPROMaddress, configVersion {0 - 254} );
+ * @return none
+ */
+auto MTD2A_globalConfig = [](const uint16_t &setEEPROMAddress = 0, const uint8_t &setConfigVersion = 1) {
+  MTD2A::set_globalConfig (setEEPROMAddress, setConfigVersion);
+};
+
+
+/**
+ * @brief Validate and apply a configuration table (flash memory) to all instantiated objects. Call before initialize ()
+ * @name MTD2A_globalConfigTable
+ * @param ( flash_table, recordCount );
+ * @return none
+ */
+auto MTD2A_globalConfigTable = [](const MTD2A_config_record *setConfigTable, const uint16_t &setRecordCount) {
+  MTD2A::set_globalConfig (setConfigTable, setRecordCount);
+};
+
+
+/**
+ * @brief Update single configuration fields live from a serial port ("C objectIndex fieldId value")
+ * @name MTD2A_globalConfigPort
+ * @param ( {Serial | Serial1 | any Stream object} );
+ * @return none
+ */
+auto MTD2A_globalConfigPort = [](Stream &setConfigPort) {
+  MTD2A::set_globalConfigPort (setConfigPort);
+};
+
+
+/**
+ * @brief Resume ACTIVE objects mid-phase after a watchdog, software or brown-out reset. Call after initialize ()
+ * @name MTD2A_globalWarmRestart
+ * @param ( MTD2A_warm_entry array (MTD2A_NOINIT), number of entries {1 - 255}, {ENABLE | DISABLE} );
+ * @return none
+ */
+auto MTD2A_globalWarmRestart = [](MTD2A_warm_entry *setWarmTable, const uint8_t &setWarmSize, const bool &setEnableOrDisable = MTD2A_const::ENABLE) {
+  MTD2A::set_globalWarmRestart (setWarmTable, setWarmSize, setEnableOrDisable);
+};
+
+
 /**
  * @brief print configuration parameters, timers and state logic.
  * @name MTD2A_print_conf ();
@@ -0,0 +1,136 @@
+/**
+ ******************************************************************************
+ * @file    MTD2A_base_adc_scan.cpp
+ * @author  Joergen Bo Madsen
+ * @version 1.0.0
+ * @date    19. October 2026
+ * @brief   ADC scan engine of the MTD2A base class (Model Train Detection And Action)
+ *
+ * Supporting a vast variety of input sensors and output devices
+ * Simple to use to build complex solutions
+ * Non blocking, simple, yet efficient event-driven state machine
+ * Comprehensive control, state and debug information
+ */
+
+
+#include "Arduino.h"
+#include "MTD2A_const.h"
+#include "MTD2A_base.h"
+#include "MTD2A_base_isr.h"
+
+
+// Linked only by sketches calling MTD2A_globalAdcScan (). AVR: The ADC vector is claimed here, otherwise it is free for other libraries
+using MTD2A_isr::adcScanTable;
+using MTD2A_isr::adcScanSize;
+using MTD2A_isr::adcScanMask;
+using MTD2A_isr::adcScanFront;
+using MTD2A_isr::adcScanCount;
+
+
+// ========== ADC scan engine (double buffer)
+// Round robin over the attached channels. Each conversion is stored in the back buffer. When all channels
+// are converted, front and back buffers are swapped. Readers always see a complete round (no blocking).
+// AVR: Conversion complete interrupt starts the next channel (AVcc reference). analogRead () must not be used meanwhile
+// Other boards: MTD2A_ADC_POLL_SAMPLES analogRead () per MTD2A_loop_execute () (polled start / complete split)
+// Sum, sum of squares, min and max per channel are collected for MTD2A_adc_scan_stats () (current_detector)
+#if defined(__AVR__)  &&  defined(ADC_vect)
+  #define MTD2A_ADC_SCAN_AVR
+#endif
+static constexpr uint8_t ADC_SCAN_MAX {16};  // One bit per slot in adcScanMask
+static volatile uint8_t  adcScanSlot  {0};   // Slot being converted
+
+
+static void MTD2A_ISR_ATTR MTD2A_adc_scan_store (const uint16_t adcValue) {
+  if (adcScanMask == 0)
+    return;
+  const uint8_t adcBack {(uint8_t)(adcScanFront ^ 1)};
+  uint8_t nextSlot {adcScanSlot};
+  volatile MTD2A_adc_scan_entry &scanEntry = adcScanTable[nextSlot];
+  scanEntry.scanValue[adcBack] = adcValue;
+  volatile MTD2A_adc_stats &slotStats = scanEntry.scanStats;
+  if (slotStats.sampleCount < MTD2A_const::MAX_BYTE_VALUE) {
+    if (slotStats.sampleCount == 0  ||  adcValue < slotStats.minValue)
+      slotStats.minValue = adcValue;
+    if (slotStats.sampleCount == 0  ||  adcValue > slotStats.maxValue)
+      slotStats.maxValue = adcValue;
+    slotStats.sumValue  += adcValue;
+    slotStats.sumSquare += (uint32_t)adcValue * adcValue;
+    slotStats.sampleCount++;
+  }
+  do {
+    if (++nextSlot >= adcScanSize) {
+      nextSlot = 0;
+      adcScanFront = adcBack;
+      adcScanCount++;
+    }
+  } while ((adcScanMask & (1U << nextSlot)) == 0);
+  adcScanSlot = nextSlot;
+}
+
+#if defined(MTD2A_ADC_SCAN_AVR)
+  static void MTD2A_adc_scan_start (const uint8_t adcPin) {
+    uint8_t adcChannel {adcPin};
+    #if defined(A0)
+      if (adcChannel >= A0)
+        adcChannel -= A0;
+    #endif
+    #if defined(analogPinToChannel)
+      adcChannel = analogPinToChannel(adcChannel);
+    #endif
+    #if defined(MUX5)
+      ADCSRB = (uint8_t)((ADCSRB & ~(1 << MUX5)) | (((adcChannel >> 3) & 0x01) << MUX5));
+    #endif
+    ADMUX  = (uint8_t)((DEFAULT << 6) | (adcChannel & 0x07));
+    ADCSRA |= (uint8_t)((1 << ADSC) | (1 << ADIE));
+  }
+
+  ISR(ADC_vect) {
+    MTD2A_adc_scan_store (ADC);
+    if (adcScanMask != 0)
+      MTD2A_adc_scan_start (adcScanTable[adcScanSlot].pinNumber);
+    else
+      ADCSRA &= (uint8_t)~(1 << ADIE);
+  }
+#else
+  static void MTD2A_adc_scan_poll () {
+    for (uint8_t pollSample {0}; pollSample < MTD2A_ADC_POLL_SAMPLES  &&  adcScanMask != 0; pollSample++)
+      MTD2A_adc_scan_store ((uint16_t)analogRead (adcScanTable[adcScanSlot].pinNumber));
+  }
+#endif
+
+
+static uint8_t MTD2A_adc_scan_slot (const uint8_t &attachPinNumber, uint8_t &adcSlot) {
+  uint8_t freeSlot {0};
+  while (freeSlot < adcScanSize  &&  (adcScanMask & (1U << freeSlot)))
+    freeSlot++;
+  if (freeSlot >= adcScanSize)
+    return 30;
+  adcScanTable[freeSlot].pinNumber = attachPinNumber;
+  noInterrupts();
+  adcScanTable[freeSlot].scanStats.sampleCount = 0;
+  const bool scanStart {adcScanMask == 0};
+  adcScanMask |= (uint16_t)(1U << freeSlot);
+  if (scanStart) {
+    adcScanSlot = freeSlot;
+    #if defined(MTD2A_ADC_SCAN_AVR)
+      MTD2A_adc_scan_start (attachPinNumber);
+    #endif
+  }
+  interrupts();
+  adcSlot = freeSlot;
+  return 0;
+} // MTD2A_adc_scan_slot
+
+
+void MTD2A::set_globalAdcScan (MTD2A_adc_scan_entry *setAdcScanTable, const uint8_t &setAdcScanSize) {
+  // Attached channels keep running in the old table. Call before set_adcScan ()
+  if (adcScanMask != 0)
+    return;
+  adcScanTable = setAdcScanTable;
+  adcScanSize  = (setAdcScanTable != nullptr) ? min(setAdcScanSize, ADC_SCAN_MAX) : 0;
+  MTD2A_isr::adcScanAttach = (adcScanSize > 0) ? MTD2A_adc_scan_slot : nullptr;
+#if !defined(MTD2A_ADC_SCAN_AVR)
+  MTD2A_isr::adcScanPoll   = (adcScanSize > 0) ? MTD2A_adc_scan_poll : nullptr;
+#endif
+} // set_globalAdcScan
+// ========== ADC scan engine
@@ -0,0 +1,234 @@
+/**
+ ******************************************************************************
+ * @file    MTD2A_base_interrupt.cpp
+ * @author  Joergen Bo Madsen
+ * @version 1.0.0
+ * @date    18. October 2026
+ * @brief   Pin change interrupt and external interrupt slots of the MTD2A base class (Model Train Detection And Action)
+ *
+ * Supporting a vast variety of input sensors and output devices
+ * Simple to use to build complex solutions
+ * Non blocking, simple, yet efficient event-driven state machine
+ * Comprehensive control, state and debug information
+ */
+
+
+#include "Arduino.h"
+#include "MTD2A_const.h"
+#include "MTD2A_base.h"
+#include "MTD2A_base_isr.h"
+
+
+// Linked only with interrupt inputs (set_pinInterrupt, set_microTiming, encoder_input, distance_input).
+// AVR: The PCINT vectors are claimed here. Sketches without interrupt inputs leave them to other libraries (SoftwareSerial)
+using MTD2A_isr::PIN_DIRTY_BYTES;
+using MTD2A_isr::pinDirtyMap;
+using MTD2A_isr::pinEdgeCount;
+
+
+// ========== Pin change interrupt
+// The pin change handle is the bit index in the dirty bitmap and the edge counter array
+// AVR: PCINT group * 8 + port bit. The ISR compares a port snapshot and only marks changed pins
+// ESP32 / ESP8266: Pin number. One interrupt per pin with the pin number as argument
+#if MTD2A_PIN_CHANGE_ISR == 1  &&  defined(PCICR)  &&  defined(digitalPinToPCICR)
+  #define MTD2A_PIN_CHANGE_AVR
+  static volatile uint8_t *pinChangePort[3]     {nullptr, nullptr, nullptr};  // Port input register per PCINT group
+  static volatile uint8_t  pinChangeSnapshot[3] {0};                          // Last port value per PCINT group
+  static          uint8_t  pinChangeMask[3]     {0};                          // Attached port bits per PCINT group
+  static volatile uint8_t  pinChangeIsrSlot[24] {0};                          // External interrupt slot + 1 per handle (0 = none)
+  static void MTD2A_isr_slot_call (const uint8_t isrSlot);
+
+  static inline void MTD2A_pin_change_group (const uint8_t group) {
+    const uint8_t portValue   {*pinChangePort[group]};
+    const uint8_t changedBits {(uint8_t)((portValue ^ pinChangeSnapshot[group]) & pinChangeMask[group])};
+    pinChangeSnapshot[group] = portValue;
+    if (changedBits != 0) {
+      pinDirtyMap[group] |= changedBits;
+      for (uint8_t bitNumber {0}; bitNumber < 8; bitNumber++) {
+        if ((changedBits & (1 << bitNumber)) == 0)
+          continue;
+        if (pinEdgeCount[group * 8 + bitNumber] < MTD2A_const::MAX_BYTE_VALUE)
+          pinEdgeCount[group * 8 + bitNumber]++;
+        // Pins without external interrupt attached by MTD2A_attach_isr_slot ()
+        if (pinChangeIsrSlot[group * 8 + bitNumber] != 0)
+          MTD2A_isr_slot_call (pinChangeIsrSlot[group * 8 + bitNumber] - 1);
+      }
+    }
+  }
+  #if defined(PCINT0_vect)
+    ISR(PCINT0_vect) { MTD2A_pin_change_group (0); }
+  #endif
+  #if defined(PCINT1_vect)
+    ISR(PCINT1_vect) { MTD2A_pin_change_group (1); }
+  #endif
+  #if defined(PCINT2_vect)
+    ISR(PCINT2_vect) { MTD2A_pin_change_group (2); }
+  #endif
+#elif MTD2A_PIN_CHANGE_ISR == 1  &&  (defined(ESP32)  ||  defined(ESP8266))
+  #define MTD2A_PIN_CHANGE_ARG
+  static void MTD2A_ISR_ATTR MTD2A_pin_change_arg (void *pinArgument) {
+    const uint8_t dirtyPin = (uint8_t)(uintptr_t)pinArgument;
+    pinDirtyMap[dirtyPin >> 3] |= (uint8_t)(1 << (dirtyPin & 7));
+    if (pinEdgeCount[dirtyPin] < MTD2A_const::MAX_BYTE_VALUE)
+      pinEdgeCount[dirtyPin]++;
+  }
+#endif
+
+
+uint8_t MTD2A::MTD2A_attach_pin_change (const uint8_t &attachPinNumber, uint8_t &pinChangeHandle) {
+  pinChangeHandle = PIN_ERROR_NO;
+  if (attachPinNumber == PIN_ERROR_NO)
+    return 1;
+  #if defined(MTD2A_PIN_CHANGE_AVR)
+    if (digitalPinToPCICR(attachPinNumber) == nullptr)
+      return 7;
+    const uint8_t pinChangeGroup = digitalPinToPCICRbit(attachPinNumber);
+    volatile uint8_t *pinInput = portInputRegister(digitalPinToPort(attachPinNumber));
+    const uint8_t pinBitMask = digitalPinToBitMask(attachPinNumber);
+    // One port per PCINT group (Mega PCINT1 mix PORTE and PORTJ)
+    if (pinChangeGroup > 2  ||  (pinChangePort[pinChangeGroup] != nullptr  &&  pinChangePort[pinChangeGroup] != pinInput))
+      return 7;
+    uint8_t bitNumber {0};
+    while ((pinBitMask >> bitNumber) > 1)
+      bitNumber++;
+    noInterrupts();
+    pinChangePort[pinChangeGroup]      = pinInput;
+    pinChangeSnapshot[pinChangeGroup]  = *pinInput;
+    pinChangeMask[pinChangeGroup]     |= pinBitMask;
+    *digitalPinToPCMSK(attachPinNumber) |= (uint8_t)(1 << digitalPinToPCMSKbit(attachPinNumber));
+    *digitalPinToPCICR(attachPinNumber) |= (uint8_t)(1 << pinChangeGroup);
+    interrupts();
+    pinChangeHandle = pinChangeGroup * 8 + bitNumber;
+  #elif defined(MTD2A_PIN_CHANGE_ARG)
+    if (attachPinNumber >= PIN_DIRTY_BYTES * 8)
+      return 2;
+    attachInterruptArg(digitalPinToInterrupt(attachPinNumber), MTD2A_pin_change_arg, (void *)(uintptr_t)attachPinNumber, CHANGE);
+    pinChangeHandle = attachPinNumber;
+  #else
+    return 133;  // Warning, continue pin polling
+  #endif
+  // First loop must read the pin
+  MTD2A_set_pin_dirty (pinChangeHandle);
+  MTD2A_isr::pinChangeDetach = MTD2A_pin_change_release;
+  return 0;
+} // MTD2A_attach_pin_change
+
+
+void MTD2A::MTD2A_pin_change_release (const uint8_t &detachPinNumber, const uint8_t &pinChangeHandle) {
+  #if defined(MTD2A_PIN_CHANGE_AVR)
+    noInterrupts();
+    pinChangeMask[pinChangeHandle >> 3] &= (uint8_t)~(1 << (pinChangeHandle & 7));
+    *digitalPinToPCMSK(detachPinNumber) &= (uint8_t)~(1 << digitalPinToPCMSKbit(detachPinNumber));
+    interrupts();
+  #elif defined(MTD2A_PIN_CHANGE_ARG)
+    (void)pinChangeHandle;
+    detachInterrupt(digitalPinToInterrupt(detachPinNumber));
+  #else
+    (void)detachPinNumber;
+    (void)pinChangeHandle;
+  #endif
+} // MTD2A_pin_change_release
+// ========== Pin change interrupt
+
+
+// ========== External interrupt slots
+// attachInterrupt() has no argument. One trampoline function per slot calls the object ISR function
+// AVR: Pins without external interrupt use the pin change interrupt (PCINT) and call the slot from the PCINT ISR
+#if defined(__AVR__)
+  static constexpr uint8_t MAX_ISR_SLOTS {4};
+#else
+  static constexpr uint8_t MAX_ISR_SLOTS {8};
+#endif
+static MTD2A *isrSlotObject[MAX_ISR_SLOTS]                  {nullptr};
+static void (*volatile isrSlotFunction[MAX_ISR_SLOTS])(MTD2A*) {nullptr};
+
+template <uint8_t isrSlot>
+static void MTD2A_ISR_ATTR MTD2A_isr_slot () {
+  if (isrSlotFunction[isrSlot] != nullptr)
+    isrSlotFunction[isrSlot](isrSlotObject[isrSlot]);
+}
+
+static void (*const isrSlotTrampoline[MAX_ISR_SLOTS])() {
+  MTD2A_isr_slot<0>, MTD2A_isr_slot<1>, MTD2A_isr_slot<2>, MTD2A_isr_slot<3>
+  #if !defined(__AVR__)
+  , MTD2A_isr_slot<4>, MTD2A_isr_slot<5>, MTD2A_isr_slot<6>, MTD2A_isr_slot<7>
+  #endif
+};
+
+#if defined(MTD2A_PIN_CHANGE_AVR)
+  static uint8_t isrSlotHandle[MAX_ISR_SLOTS] {MTD2A_const::PIN_ERROR_NO, MTD2A_const::PIN_ERROR_NO, MTD2A_const::PIN_ERROR_NO, MTD2A_const::PIN_ERROR_NO};
+
+  static void MTD2A_isr_slot_call (const uint8_t isrSlot) {
+    if (isrSlot < MAX_ISR_SLOTS)
+      isrSlotTrampoline[isrSlot]();
+  }
+#endif
+
+
+uint8_t MTD2A::MTD2A_attach_isr_slot (const uint8_t &attachPinNumber, MTD2A *isrObject, function_type isrFunction, uint8_t &isrSlot) {
+  isrSlot = PIN_ERROR_NO;
+  if (attachPinNumber == PIN_ERROR_NO)
+    return 1;
+  bool pinChangeOnly {false};
+  #if defined(digitalPinToInterrupt)
+    if ((int)digitalPinToInterrupt(attachPinNumber) == (int)NOT_AN_INTERRUPT) {
+      #if defined(MTD2A_PIN_CHANGE_AVR)
+        pinChangeOnly = true;
+      #else
+        return 7;
+      #endif
+    }
+  #endif
+  for (uint8_t slotNumber {0}; slotNumber < MAX_ISR_SLOTS; slotNumber++) {
+    if (isrSlotFunction[slotNumber] == nullptr) {
+      // Pointer writes are not atomic on 8 bit processors. The slot ISR must not see a half written slot
+      noInterrupts();
+      isrSlotObject[slotNumber]   = isrObject;
+      isrSlotFunction[slotNumber] = isrFunction;
+      interrupts();
+      if (pinChangeOnly) {
+        #if defined(MTD2A_PIN_CHANGE_AVR)
+          uint8_t pinChangeHandle;
+          const uint8_t attachErrorNumber = MTD2A_attach_pin_change (attachPinNumber, pinChangeHandle);
+          if (attachErrorNumber != 0) {
+            noInterrupts();
+            isrSlotFunction[slotNumber] = nullptr;
+            isrSlotObject[slotNumber]   = nullptr;
+            interrupts();
+            return attachErrorNumber;
+          }
+          isrSlotHandle[slotNumber] = pinChangeHandle;
+          pinChangeIsrSlot[pinChangeHandle] = slotNumber + 1;
+        #endif
+      }
+      else {
+        attachInterrupt(digitalPinToInterrupt(attachPinNumber), isrSlotTrampoline[slotNumber], CHANGE);
+      }
+      isrSlot = slotNumber;
+      MTD2A_isr::isrSlotDetach = MTD2A_isr_slot_release;
+      return 0;
+    }
+  }
+  return 17;
+} // MTD2A_attach_isr_slot
+
+
+void MTD2A::MTD2A_isr_slot_release (const uint8_t &detachPinNumber, uint8_t &isrSlot) {
+  if (isrSlot < MAX_ISR_SLOTS) {
+    #if defined(MTD2A_PIN_CHANGE_AVR)
+      if (isrSlotHandle[isrSlot] != PIN_ERROR_NO) {
+        pinChangeIsrSlot[isrSlotHandle[isrSlot]] = 0;
+        MTD2A_detach_pin_change (detachPinNumber, isrSlotHandle[isrSlot]);
+        isrSlotHandle[isrSlot] = PIN_ERROR_NO;
+      }
+      else
+    #endif
+    detachInterrupt(digitalPinToInterrupt(detachPinNumber));
+    noInterrupts();
+    isrSlotFunction[isrSlot] = nullptr;
+    isrSlotObject[isrSlot]   = nullptr;
+    interrupts();
+  }
+  isrSlot = PIN_ERROR_NO;
+} // MTD2A_isr_slot_release
+// ========== External interrupt slots
@@ -0,0 +1,172 @@
+/**
+ ******************************************************************************
+ * @file    MTD2A_base_ir.cpp
+ * @author  Joergen Bo Madsen
+ * @version 1.0.0
+ * @date    19. October 2026
+ * @brief   Modulated IR demodulator of the MTD2A base class (Model Train Detection And Action)
+ *
+ * Supporting a vast variety of input sensors and output devices
+ * Simple to use to build complex solutions
+ * Non blocking, simple, yet efficient event-driven state machine
+ * Comprehensive control, state and debug information
+ */
+
+
+#include "Arduino.h"
+#include "MTD2A_const.h"
+#include "MTD2A_base.h"
+#include "MTD2A_base_isr.h"
+
+
+// Linked only with ir_input. AVR: The timer 0 compare A vector is claimed here, otherwise it is free for other libraries
+
+
+// ========== Modulated IR demodulator (synchronous detection)
+// Each channel pulses its IR LED with a Walsh code (odd row 2 * slot + 1 of the 16 x 16 Hadamard matrix) and
+// correlates the receiver pin with the LED state: +1 when the receiver is HIGH with the LED on, -1 with the LED off.
+// Ambient and layout light is the same in both LED states and cancels out. The odd rows change the LED state
+// every one or two samples (high pass) and are orthogonal, so neighbour channels do not see each other.
+// AVR: Timer 0 compare A interrupt (about 1 kHz, no change of millis () or PWM). Direct port access
+// Other boards: One sample per MTD2A_loop_execute () (polled)
+static_assert(MTD2A_IR_WINDOW >= 1  &&  MTD2A_IR_WINDOW <= 16, "MTD2A_IR_WINDOW 1 - 16");
+#if defined(__AVR__)  &&  defined(TIMER0_COMPA_vect)  &&  defined(TIMSK0)
+  #define MTD2A_IR_AVR
+#endif
+static constexpr uint8_t IR_CHANNELS_MAX {8};             // One bit per channel in irMask
+static MTD2A_ir_channel *irChannel       {nullptr};       // Channel table in the sketch (MTD2A_globalIrChannels)
+static uint8_t           irChannelSize   {0};
+static volatile uint8_t  irMask          {0};             // Attached channels. One bit per channel
+static volatile uint16_t irSample        {0};             // Sample in window {0 - 16 * MTD2A_IR_WINDOW - 1}
+static volatile uint16_t irWindowCount   {0};             // Completed windows
+
+
+static void MTD2A_ISR_ATTR MTD2A_ir_sample () {
+  const uint8_t codeBit {(uint8_t)(irSample & 0x0F)};
+  const uint8_t nextBit {(uint8_t)((codeBit + 1) & 0x0F)};
+  for (uint8_t irSlot {0}; irSlot < irChannelSize; irSlot++) {
+    if ((irMask & (1 << irSlot)) == 0)
+      continue;
+    MTD2A_ir_channel &channel = irChannel[irSlot];
+    // Receiver response to the LED state of the last sample period
+    #if defined(MTD2A_IR_AVR)
+      const bool receiverHigh {(*channel.receiverPort & channel.receiverMask) != 0};
+    #else
+      const bool receiverHigh {digitalRead (channel.receiverPin) == HIGH};
+    #endif
+    if (receiverHigh)
+      channel.sumValue += (channel.walshCode & (1U << codeBit)) ? 1 : -1;
+    const bool ledOn {(channel.walshCode & (1U << nextBit)) != 0};
+    #if defined(MTD2A_IR_AVR)
+      if (ledOn)
+        *channel.ledPort |= channel.ledMask;
+      else
+        *channel.ledPort &= (uint8_t)~channel.ledMask;
+    #else
+      digitalWrite (channel.ledPin, ledOn ? HIGH : LOW);
+    #endif
+  }
+  if (++irSample >= 16 * MTD2A_IR_WINDOW) {
+    irSample = 0;
+    for (uint8_t irSlot {0}; irSlot < irChannelSize; irSlot++) {
+      irChannel[irSlot].windowValue = irChannel[irSlot].sumValue;
+      irChannel[irSlot].sumValue    = 0;
+    }
+    irWindowCount++;
+  }
+}
+
+#if defined(MTD2A_IR_AVR)
+  ISR(TIMER0_COMPA_vect) {
+    MTD2A_ir_sample ();
+  }
+#endif
+
+
+void MTD2A::set_globalIrChannels (MTD2A_ir_channel *setIrChannels, const uint8_t &setIrSize) {
+  // Attached channels keep running in the old table. Call before initialize () of the ir_input objects
+  if (irMask != 0)
+    return;
+  irChannel     = setIrChannels;
+  irChannelSize = (setIrChannels != nullptr) ? min(setIrSize, IR_CHANNELS_MAX) : 0;
+} // set_globalIrChannels
+
+
+uint16_t MTD2A::get_globalIrWindowCount () {
+  noInterrupts();
+  const uint16_t windowCount = irWindowCount;
+  interrupts();
+  return windowCount;
+} // get_globalIrWindowCount
+
+
+uint8_t MTD2A::MTD2A_ir_attach (const uint8_t &ledPinNumber, const uint8_t &receiverPinNumber, uint8_t &irSlot) {
+  irSlot = PIN_ERROR_NO;
+  if (ledPinNumber == PIN_ERROR_NO  ||  receiverPinNumber == PIN_ERROR_NO)
+    return 1;
+  uint8_t freeSlot {0};
+  while (freeSlot < irChannelSize  &&  (irMask & (1 << freeSlot)))
+    freeSlot++;
+  if (freeSlot >= irChannelSize)
+    return 31;
+  // Walsh row 2 * slot + 1: LED on when parity (row & sample) is even
+  const uint8_t walshRow {(uint8_t)(freeSlot * 2 + 1)};
+  uint16_t walshCode {0};
+  for (uint8_t codeBit {0}; codeBit < 16; codeBit++) {
+    uint8_t parityBits {(uint8_t)(walshRow & codeBit)};
+    parityBits ^= parityBits >> 2;
+    parityBits ^= parityBits >> 1;
+    if ((parityBits & 1) == 0)
+      walshCode |= (uint16_t)(1U << codeBit);
+  }
+  MTD2A_ir_channel &channel = irChannel[freeSlot];
+  noInterrupts();
+  channel.ledPin       = ledPinNumber;
+  channel.receiverPin  = receiverPinNumber;
+  #if defined(__AVR__)
+    channel.ledPort      = portOutputRegister(digitalPinToPort(ledPinNumber));
+    channel.ledMask      = digitalPinToBitMask(ledPinNumber);
+    channel.receiverPort = portInputRegister(digitalPinToPort(receiverPinNumber));
+    channel.receiverMask = digitalPinToBitMask(receiverPinNumber);
+  #endif
+  channel.walshCode   = walshCode;
+  channel.sumValue    = 0;
+  channel.windowValue = 0;
+  irMask |= (uint8_t)(1 << freeSlot);
+  #if defined(MTD2A_IR_AVR)
+    TIMSK0 |= (uint8_t)(1 << OCIE0A);
+  #else
+    MTD2A_isr::irSamplePoll = MTD2A_ir_sample;
+  #endif
+  interrupts();
+  irSlot = freeSlot;
+  return 0;
+} // MTD2A_ir_attach
+
+
+void MTD2A::MTD2A_ir_detach (uint8_t &irSlot) {
+  if (irSlot < irChannelSize) {
+    noInterrupts();
+    irMask &= (uint8_t)~(1 << irSlot);
+    #if defined(MTD2A_IR_AVR)
+      *irChannel[irSlot].ledPort &= (uint8_t)~irChannel[irSlot].ledMask;
+      if (irMask == 0)
+        TIMSK0 &= (uint8_t)~(1 << OCIE0A);
+    #else
+      digitalWrite (irChannel[irSlot].ledPin, LOW);
+      if (irMask == 0)
+        MTD2A_isr::irSamplePoll = nullptr;
+    #endif
+    interrupts();
+  }
+  irSlot = PIN_ERROR_NO;
+} // MTD2A_ir_detach
+
+
+int16_t MTD2A::MTD2A_ir_value (const uint8_t &irSlot) {
+  noInterrupts();
+  const int16_t correlationValue = irChannel[irSlot].windowValue;
+  interrupts();
+  return correlationValue;
+} // MTD2A_ir_value
+// ========== Modulated IR demodulator
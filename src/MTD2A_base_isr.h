@@ -0,0 +1,60 @@
+/*
+ ******************************************************************************
+ * @file    MTD2A_base_isr.h
+ * @author  Joergen Bo Madsen
+ * @version 1.0.0
+ * @date    18. October 2026
+ * @brief   Internal interrupt engines of the MTD2A base class (not for use in sketches)
+ *
+ * Supporting a vast variety of input sensors and output devices
+ * Simple to use to build complex solutions
+ * Non blocking, simple, yet efficient event-driven state machine
+ * Comprehensive control, state and debug information
+ */
+
+
+
+#ifndef _MTD2A_base_isr_H_
+#define _MTD2A_base_isr_H_
+
+
+#include "Arduino.h"
+#include "MTD2A_base.h"
+
+
+// Interrupt vectors are defined in translation units of their own (MTD2A_base_interrupt.cpp).
+// The library is linked as an archive (library.properties dot_a_linkage), so a vector is only claimed when
+// a sketch uses the engine (attach function). Otherwise other libraries can use it (SoftwareSerial PCINT etc.)
+
+
+namespace MTD2A_isr
+{
+  // Pin change interrupt dirty bitmap (one bit per pin change handle) and edge counters (MTD2A_base.cpp)
+  #if defined(PCICR)
+    constexpr uint8_t PIN_DIRTY_BYTES {3};  // AVR: Three PCINT groups of 8 pins
+  #elif defined(NUM_DIGITAL_PINS)
+    constexpr uint8_t PIN_DIRTY_BYTES {(NUM_DIGITAL_PINS + 7) / 8};
+  #else
+    constexpr uint8_t PIN_DIRTY_BYTES {13}; // Safe default for most Arduino boards (100 pins)
+  #endif
+  extern volatile uint8_t pinDirtyMap[PIN_DIRTY_BYTES];
+  extern volatile uint8_t pinEdgeCount[PIN_DIRTY_BYTES * 8];
+  // External interrupt slot detach (MTD2A_isr_slot_release). Set by MTD2A_attach_isr_slot (), so destructors do not link the slots
+  extern void (*isrSlotDetach) (const uint8_t &detachPinNumber, uint8_t &isrSlot);
+  // Pin change detach (MTD2A_pin_change_release). Set by MTD2A_attach_pin_change (), so destructors do not link the PCINT vectors
+  extern void (*pinChangeDetach) (const uint8_t &detachPinNumber, const uint8_t &pinChangeHandle);
+  // ADC scan channels (MTD2A_base.cpp). Table, attach and poll are set by set_globalAdcScan () (MTD2A_base_adc_scan.cpp),
+  // so analog_input and current_detector do not link the ADC interrupt vector
+  extern volatile MTD2A_adc_scan_entry *adcScanTable;
+  extern uint8_t                        adcScanSize;
+  extern volatile uint16_t              adcScanMask;   // Attached slots. One bit per slot
+  extern volatile uint8_t               adcScanFront;  // Buffer read by objects
+  extern volatile uint16_t              adcScanCount;  // Completed rounds
+  extern uint8_t (*adcScanAttach) (const uint8_t &attachPinNumber, uint8_t &adcSlot);
+  extern void    (*adcScanPoll)   ();
+  // Polled IR sample per MTD2A_loop_execute (MTD2A_base_ir.cpp). Set by MTD2A_ir_attach () on boards without the AVR timer 0 interrupt
+  extern void (*irSamplePoll) ();
+} // namespace MTD2A_isr
+
+
+#endif
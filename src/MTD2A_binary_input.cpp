@@ -42,6 +42,11 @@ constexpr bool    MTD2A_binary_input::MONO_STABLE;
 constexpr bool    MTD2A_binary_input::TIME_DELAY;
 // Timer
 constexpr uint8_t MTD2A_binary_input::RESET_TIMER;
+// Debounce filter
+constexpr uint8_t MTD2A_binary_input::NO_DEBOUNCE;
+constexpr uint8_t MTD2A_binary_input::DEBOUNCE_SHIFT;
+constexpr uint8_t MTD2A_binary_input::DEBOUNCE_INTEGRATE;
+constexpr uint8_t MTD2A_binary_input::MAX_DEBOUNCE;
 // Phases
 constexpr uint8_t MTD2A_binary_input::RESET_PHASE; 
 constexpr uint8_t MTD2A_binary_input::FIRST_TIME_PHASE;
@@ -67,7 +72,17 @@ MTD2A_binary_input::MTD2A_binary_input
     MTD2A{[](MTD2A* funcPtr) { static_cast<MTD2A_binary_input*>(funcPtr)->loop_fast(); }}
   {
     MTD2A_add_function_pointer_loop_fast(this);
-    objectName  = MTD2A_set_object_name(setObjectName);
+    MTD2A_set_object_name(setObjectName);
+  }
+// MTD2A_binary_input
+
+
+// Constructor F("Object name")
+MTD2A_binary_input::MTD2A_binary_input
+  (const __FlashStringHelper *setObjectName, const uint32_t setDelayTimeMS, const bool setFirstOrLast, const bool setTimeOrMono, const uint32_t setPinBlockMS)
+  : MTD2A_binary_input ((const char *)nullptr, setDelayTimeMS, setFirstOrLast, setTimeOrMono, setPinBlockMS)
+  {
+    MTD2A_set_object_name(setObjectName);
   }
 // MTD2A_binary_input
 
@@ -76,12 +91,13 @@ void MTD2A_binary_input::initialize (const uint8_t &setPinNumber, const bool &se
   // Check for instantiated object error
   delayTimeMS = check_set_time (delayTimeMS);
   pinBlockMS  = check_set_time (pinBlockMS);
-  //
-  errorNumber = MTD2A_reserve_and_check_pin (setPinNumber, DIGITAL_FLAG_0 | INPUT_FLAG_2 | PULLUP_FLAG_3);
+  // Configuration block (MTD2A_globalConfig) overrides the arguments
+  const uint8_t configPinNumber = (uint8_t)MTD2A_config_value (CONFIG_PIN_NUMBER, setPinNumber);
+  errorNumber = MTD2A_reserve_and_check_pin (configPinNumber, DIGITAL_FLAG_0 | INPUT_FLAG_2 | PULLUP_FLAG_3);
   if (errorNumber == 0) {
     pinReadToggl = ENABLE;
-    pinNumber = setPinNumber;
-    pinReadMode = setPinNomalOrInverted;
+    pinNumber = configPinNumber;
+    pinReadMode = (bool)MTD2A_config_value (CONFIG_PIN_MODE, setPinNomalOrInverted);
     if (setPinPullupOrInput == (uint8_t)INPUT  ||  setPinPullupOrInput == (uint8_t)INPUT_PULLUP) 
       pinType = setPinPullupOrInput;
     else {
@@ -124,6 +140,28 @@ void MTD2A_binary_input::set_inputState (const bool &setInputLowOrHigh, const bo
 } // set_inputState
 
 
+void MTD2A_binary_input::set_debounce (const uint8_t &setDebounceMode, const uint8_t &setDebounceSamples) {
+  if (setDebounceMode > DEBOUNCE_INTEGRATE) {
+    print_error_text (161);
+    return;
+  }
+  debounceMode    = setDebounceMode;
+  debounceSamples = setDebounceSamples;
+  if (debounceMode != NO_DEBOUNCE  &&  (debounceSamples == 0  ||  debounceSamples > MAX_DEBOUNCE)) {
+    print_error_text (160);
+    debounceSamples = MAX_DEBOUNCE;
+  }
+  // Start settled at the current pin state
+  if (debounceMode == DEBOUNCE_INTEGRATE)
+    debounceValue = (pinState == HIGH) ? debounceSamples : 0;
+  else
+    debounceValue = (pinState == HIGH) ? MAX_BYTE_VALUE : 0;
+} // set_debounce
+
+
+// set_pinInterrupt () and set_microTiming (): MTD2A_binary_input_interrupt.cpp
+
+
 void MTD2A_binary_input::set_delayTimeMS (const uint32_t &setDelayTimeMS) {
   if (processState == COMPLETE) {
     delayTimeMS = check_set_time (setDelayTimeMS);
@@ -216,6 +254,79 @@ bool const &MTD2A_binary_input::get_inputGoHigh () const {
 }
 
 
+uint16_t const &MTD2A_binary_input::get_fallEdgeCount () const {
+  return fallEdgeCount;
+}
+
+
+uint16_t const &MTD2A_binary_input::get_riseEdgeCount () const {
+  return riseEdgeCount;
+}
+
+
+uint16_t const &MTD2A_binary_input::get_activateCount () const {
+  return activateCount;
+}
+
+
+uint16_t const &MTD2A_binary_input::get_completeCount () const {
+  return completeCount;
+}
+
+
+uint16_t const &MTD2A_binary_input::get_lostEdgeCount () const {
+  return lostEdgeCount;
+}
+
+
+uint8_t const &MTD2A_binary_input::get_tickEdgeCount () const {
+  return tickEdgeCount;
+}
+
+
+bool MTD2A_binary_input::get_microTiming () const {
+  return (microTiming != nullptr);
+}
+
+
+uint32_t MTD2A_binary_input::get_firstTimeUS () const {
+  if (microTiming == nullptr)
+    return 0;
+  return microTiming->firstTimeUS;
+}
+
+
+uint32_t MTD2A_binary_input::get_lastTimeUS () const {
+  if (microTiming == nullptr)
+    return 0;
+  return microTiming->lastTimeUS;
+}
+
+
+uint32_t MTD2A_binary_input::get_pulseWidthUS () const {
+  if (microTiming == nullptr)
+    return 0;
+  return read_micro_timing (microTiming->pulseWidthUS);
+}
+
+
+uint32_t MTD2A_binary_input::get_periodUS () const {
+  if (microTiming == nullptr)
+    return 0;
+  return read_micro_timing (microTiming->periodUS);
+}
+
+
+double MTD2A_binary_input::get_frequencyHz () const {
+  if (microTiming == nullptr)
+    return 0.0;
+  uint32_t meanPeriodUS = read_micro_timing (microTiming->meanPeriodUS);
+  if (meanPeriodUS == 0)
+    return 0.0;
+  return 1000000.0 / (double)meanPeriodUS;
+} // get_frequencyHz
+
+
 uint8_t const MTD2A_binary_input::get_reset_error () {
   uint8_t tempErrorNumber = errorNumber;
   errorNumber = 0;
@@ -226,9 +337,61 @@ uint8_t const MTD2A_binary_input::get_reset_error () {
 // Internal -----------------------------------------------
 
 
+void MTD2A_ISR_ATTR MTD2A_binary_input::isr_micro_timing (MTD2A *isrObject) {
+  MTD2A_binary_input *input = static_cast<MTD2A_binary_input*>(isrObject);
+  MTD2A_micro_timing *timing = input->microTiming;
+  const uint32_t edgeTimeUS = micros();
+  bool pinRead = digitalRead(input->pinNumber);
+  if (input->pinReadMode == INVERTED)
+    pinRead = !pinRead;
+  if (pinRead == LOW) { // Active edge
+    if (timing->fallValid == true) {
+      timing->periodUS = edgeTimeUS - timing->fallTimeUS;
+      if (timing->meanPeriodUS == 0)
+        timing->meanPeriodUS = timing->periodUS;
+      else
+        timing->meanPeriodUS = timing->meanPeriodUS - (timing->meanPeriodUS >> 3) + (timing->periodUS >> 3);
+    }
+    timing->fallTimeUS = edgeTimeUS;
+    timing->fallValid  = true;
+  }
+  else {
+    timing->riseTimeUS = edgeTimeUS;
+    // No pulse width before the first active edge (pin active at set_microTiming () or rising edge first)
+    if (timing->fallValid == true)
+      timing->pulseWidthUS = edgeTimeUS - timing->fallTimeUS;
+  }
+} // isr_micro_timing
+
+
+uint32_t MTD2A_binary_input::read_micro_timing (const volatile uint32_t &readTimeUS) const {
+  // 32 bit read is not atomic on 8 bit processors
+  noInterrupts();
+  uint32_t timeUS = readTimeUS;
+  interrupts();
+  return timeUS;
+} // read_micro_timing
+
+
 void MTD2A_binary_input::loop_fast () {
   phaseChange = false;
-  loop_fast_input ();
+  if (pinInterrupt == ENABLE) {
+    tickEdgeCount = MTD2A_get_reset_pin_edges (pinChangeHandle);
+    // Unchanged pin and no running timers. Nothing to do
+    if (tickEdgeCount == 0  &&  loop_fast_idle () == true) {
+      inputGoLow  = false;
+      inputGoHigh = false;
+      return;
+    }
+    bool lastPinState = pinState;
+    loop_fast_input ();
+    // Short pulses within one loop are not seen as a pin state change. Lost edges come in pairs
+    uint8_t seenEdgeCount = (pinState != lastPinState) ? 1 : 0;
+    if (pinReadToggl == ENABLE  &&  tickEdgeCount > seenEdgeCount)
+      lostEdgeCount += (tickEdgeCount - seenEdgeCount) & 0xFE;
+  }
+  else
+    loop_fast_input ();
   if (delayTimeMS == 0) {
     loop_fast_binary ();
   }
@@ -244,11 +407,31 @@ void MTD2A_binary_input::loop_fast () {
 } // loop_fast
 
 
+bool MTD2A_binary_input::loop_fast_idle () {
+  if (inputState == LOW)
+    return false;
+  if (debounceMode != NO_DEBOUNCE  &&  debounce_settled () == false)
+    return false;
+  // Stale state (PULSE set_inputState, LINK_ACTIVATE etc.). The pending edge must be evaluated first
+  bool settledState = (pinState == LOW || inputState == LOW) ? LOW : HIGH;
+  if (currentState != settledState  ||  lastState != currentState)
+    return false;
+  if (processState == COMPLETE)
+    return true;
+  // Binary mode (no delay timer) only change state on input edges
+  return (delayTimeMS == 0  &&  pinBlockState == DISABLE);
+} // loop_fast_idle
+
+
 void MTD2A_binary_input::loop_fast_input () {
   if (pinReadToggl == ENABLE) {
-    pinState = digitalRead(pinNumber);
+    bool pinRead = loop_fast_read ();
     if (pinReadMode== INVERTED) 
-      pinState = !pinState;
+      pinRead = !pinRead;
+    if (debounceMode == NO_DEBOUNCE)
+      pinState = pinRead;
+    else
+      pinState = loop_fast_debounce (pinRead);
   }
   if (pinState == LOW || inputState == LOW)
     currentState = LOW;
@@ -259,9 +442,63 @@ void MTD2A_binary_input::loop_fast_input () {
   //
   inputGoLow  = (lastState == HIGH && currentState == LOW);
   inputGoHigh = (lastState == LOW && currentState == HIGH);
+  if (inputGoLow)
+    fallEdgeCount++;
+  if (inputGoHigh)
+    riseEdgeCount++;
 } // loop_fast_input
 
 
+bool MTD2A_binary_input::loop_fast_read () {
+  // Analog input overrides with threshold and hysteresis (MTD2A_analog_input)
+  return digitalRead(pinNumber);
+} // loop_fast_read
+
+
+bool MTD2A_binary_input::loop_fast_debounce (const bool &pinRead) {
+  if (debounceMode == DEBOUNCE_SHIFT) {
+    // Shift in new sample and count HIGH samples in the window (Hamming weight)
+    debounceValue = (uint8_t)(debounceValue << 1) | (uint8_t)pinRead;
+    uint8_t highCount = debounceValue & (uint8_t)(MAX_BYTE_VALUE >> (MAX_DEBOUNCE - debounceSamples));
+    highCount = (highCount & 0x55) + ((highCount >> 1) & 0x55);
+    highCount = (highCount & 0x33) + ((highCount >> 2) & 0x33);
+    highCount = (highCount & 0x0F) + (highCount >> 4);
+    // Majority. A tie (even samples) keeps the current state
+    if (highCount * 2 > debounceSamples)
+      return HIGH;
+    if (highCount * 2 < debounceSamples)
+      return LOW;
+    return pinState;
+  }
+  else { // DEBOUNCE_INTEGRATE
+    if (pinRead == HIGH) {
+      if (debounceValue < debounceSamples)
+        debounceValue++;
+    }
+    else {
+      if (debounceValue > 0)
+        debounceValue--;
+    }
+    // Hysteresis. Change state at the integrator limits only
+    if (debounceValue == debounceSamples)
+      return HIGH;
+    if (debounceValue == 0)
+      return LOW;
+    return pinState;
+  }
+} // loop_fast_debounce
+
+
+bool MTD2A_binary_input::debounce_settled () const {
+  if (debounceMode == DEBOUNCE_SHIFT) {
+    uint8_t sampleMask = (uint8_t)(MAX_BYTE_VALUE >> (MAX_DEBOUNCE - debounceSamples));
+    return (debounceValue & sampleMask) == ((pinState == HIGH) ? sampleMask : 0);
+  }
+  else // DEBOUNCE_INTEGRATE
+    return debounceValue == ((pinState == HIGH) ? debounceSamples : 0);
+} // debounce_settled
+
+
 void MTD2A_binary_input::loop_fast_binary () {
   if (inputGoLow)
     begin_state ();
@@ -300,6 +537,8 @@ void MTD2A_binary_input::loop_fast_last () {
       phaseChange = true;
       phaseNumber = LAST_TIME_PHASE;
       lastTimeMS  = globalSyncTimeMS;
+      if (microTiming != nullptr)
+        microTiming->lastTimeUS = read_micro_timing (microTiming->riseTimeUS);
       print_phase_line ();
     }
     //
@@ -322,6 +561,11 @@ void MTD2A_binary_input::begin_state () {
   lastTimeMS   = firstTimeMS;
   phaseChange  = true;
   phaseNumber  = FIRST_TIME_PHASE;
+  activateCount++;
+  if (microTiming != nullptr) {
+    microTiming->firstTimeUS = read_micro_timing (microTiming->fallTimeUS);
+    microTiming->lastTimeUS  = microTiming->firstTimeUS;
+  }
   print_phase_line ();
 } // begin_state
 
@@ -353,6 +597,7 @@ void MTD2A_binary_input::complete_state () {
   phaseChange  = true;
   processState = COMPLETE;
   phaseNumber  = COMPLETE_PHASE;
+  completeCount++;
   print_phase_line();
 } // ending_state
 
@@ -367,6 +612,7 @@ void MTD2A_binary_input::reset () {
   stopBlockTM   = DISABLE;  
   pinState      = HIGH;
   inputState    = HIGH;
+  debounceValue = (debounceMode == DEBOUNCE_INTEGRATE) ? debounceSamples : MAX_BYTE_VALUE;
   processState  = COMPLETE;
   pinBlockState = DISABLE;
   currentState  = HIGH;
@@ -379,6 +625,8 @@ void MTD2A_binary_input::reset () {
     pinReadToggl = DISABLE;
   else
     pinReadToggl = ENABLE;
+  if (pinInterrupt == ENABLE)
+    MTD2A_set_pin_dirty (pinChangeHandle);
   print_phase_line ();
 }  // reset
 
@@ -396,12 +644,16 @@ uint32_t MTD2A_binary_input::check_set_time (const uint32_t &setCheckTimeMS) {
 
 void MTD2A_binary_input::print_error_text (const uint8_t setErrorNumber) {
   errorNumber = setErrorNumber;
-  MTD2A_print_object_name (objectName);
-  MTD2A_print_error_text ((debugPrint == ENABLE || errorPrint == ENABLE), errorNumber, pinNumber);
+  MTD2A_trace_phase (phaseNumber, errorNumber);
+  if (globalTraceMode == TRACE_OFF) {
+    MTD2A_print_object_name ();
+    MTD2A_print_error_text ((debugPrint == ENABLE || errorPrint == ENABLE), errorNumber, pinNumber);
+  }
 } // print_error_text
 
 
 void MTD2A_binary_input::print_phase_text() {
+#if MTD2A_LOG_LEVEL >= MTD2A_LOG_DEBUG
   switch(phaseNumber) {
     case 0: PortPrintln(F("[0] Reset"));         break;
     case 1: PortPrintln(F("[1] First time"));    break;
@@ -409,24 +661,70 @@ void MTD2A_binary_input::print_phase_text() {
     case 3: PortPrintln(F("[3] Pin blocking"));  break;
     case 4: PortPrintln(F("[4] Complete"));      break;
   }
+#endif
 } // print_phase_text
 
 
+#if MTD2A_OBJECT_STATE > 0
+void MTD2A_binary_input::MTD2A_snapshot_state (MTD2A_snapshot_record &snapshotRecord) const {
+  // timeMS: Start time of FIRST_TIME_PHASE (globalSyncTimeMS, ACTIVE)
+  snapshotRecord.objectType  = SNAPSHOT_INPUT;
+  snapshotRecord.phaseNumber = phaseNumber;
+  snapshotRecord.stateFlags  = (uint8_t)(processState | (phaseChange << 1));
+  snapshotRecord.errorNumber = errorNumber;
+  snapshotRecord.pinNumber   = pinNumber;
+  snapshotRecord.pinValue    = pinState;
+  if (processState == ACTIVE)
+    snapshotRecord.timeMS = firstTimeMS;
+} // MTD2A_snapshot_state
+#endif
+
+
+bool MTD2A_binary_input::MTD2A_link_action (const uint8_t &linkAction, const uint8_t &actionValue, const bool &executeAction) {
+  (void)actionValue;
+  switch (linkAction) {
+    case LINK_ACTIVATE: if (executeAction) set_inputState (LOW, PULSE); return true;
+    case LINK_RESET:    if (executeAction) reset ();                    return true;
+  }
+  return false;
+} // MTD2A_link_action
+
+
+#if MTD2A_CONFIG > 0
+bool MTD2A_binary_input::MTD2A_config_field (const uint8_t &fieldId, const uint32_t &fieldValue, const bool &applyField) {
+  // Values are validated by MTD2A_config_check (). CONFIG_PIN_NUMBER is used by initialize ()
+  switch (fieldId) {
+    case CONFIG_PIN_NUMBER:                                                 return true;
+    case CONFIG_PIN_MODE:   if (applyField) pinReadMode = (bool)fieldValue; return true;
+    case CONFIG_DELAY_TIME: if (applyField) delayTimeMS = fieldValue;       return true;
+    case CONFIG_BLOCK_TIME: if (applyField) pinBlockMS  = fieldValue;       return true;
+  }
+  return false;
+} // MTD2A_config_field
+#endif
+
+
 void MTD2A_binary_input::print_phase_line (const uint8_t &printRestartTimer) {
-  if (debugPrint == ENABLE  ||  globalDebugPrint == ENABLE) {
-    MTD2A_print_object_name (objectName);
+  MTD2A_trace_phase (phaseNumber);
+#if MTD2A_LOG_LEVEL >= MTD2A_LOG_DEBUG
+  if (globalTraceMode == TRACE_OFF  &&  (debugPrint == ENABLE  ||  globalDebugPrint == ENABLE)) {
+    MTD2A_print_object_name ();
     if (printRestartTimer == RESET_TIMER) {
       PortPrint(F(": Reset timer >"));
     }
     PortPrint(F(" "));
     print_phase_text ();
   }
+#else
+  (void)printRestartTimer;
+#endif
 } // print_phase_line
 
 
 void MTD2A_binary_input::print_conf () {
+#if MTD2A_LOG_LEVEL >= MTD2A_LOG_DEBUG
   PortPrintln(F("MTD2A_binary_input: "));
-  MTD2A_print_name_state (objectName, processState);
+  MTD2A_print_name_state (processState);
   PortPrint  (F("  phaseText    : ")); print_phase_text ();
   MTD2A_print_debug_error (debugPrint, errorPrint, errorNumber);
   //
@@ -438,6 +736,8 @@ void MTD2A_binary_input::print_conf () {
   PortPrint  (F("  pinReadToggl : ")); MTD2A_print_enable_disable  (pinReadToggl);
   PortPrint  (F("  pinReadMode  : ")); MTD2A_print_normal_inverted (pinReadMode);
   PortPrint  (F("  inputMode    : ")); MTD2A_print_pulse_fixed     (inputMode);
+  PortPrint  (F("  pinInterrupt : ")); MTD2A_print_enable_disable  (pinInterrupt);
+  PortPrint  (F("  debounceMode : ")); PortPrint(debounceMode); PortPrint(F(" / ")); PortPrintln(debounceSamples);
   // timers
   PortPrint  (F("  delayTimeMS  : ")); PortPrintln(delayTimeMS);
   PortPrint  (F("  firstTimeMS  : ")); PortPrintln(firstTimeMS);
@@ -447,5 +747,16 @@ void MTD2A_binary_input::print_conf () {
   // state loggic
   PortPrint  (F("  pinState     : ")); MTD2A_print_value_binary (BINARY, pinState);
   PortPrint  (F("  inputState   : ")); MTD2A_print_value_binary (BINARY, inputState);
+  if (microTiming != nullptr) {
+    PortPrint  (F("  pulseWidthUS : ")); PortPrintln(get_pulseWidthUS());
+    PortPrint  (F("  periodUS     : ")); PortPrintln(get_periodUS());
+  }
+  // Counters
+  PortPrint  (F("  activateCount: ")); PortPrintln(activateCount);
+  PortPrint  (F("  completeCount: ")); PortPrintln(completeCount);
+  PortPrint  (F("  fallEdgeCount: ")); PortPrintln(fallEdgeCount);
+  PortPrint  (F("  riseEdgeCount: ")); PortPrintln(riseEdgeCount);
+  PortPrint  (F("  lostEdgeCount: ")); PortPrintln(lostEdgeCount);
+#endif
 } // print_conf 
 
@@ -34,8 +34,26 @@
 #define _MTD2A_binary_input_H_
 
 
+// Microsecond edge timing (set_microTiming). Allocated when enabled
+struct MTD2A_micro_timing {
+  volatile uint32_t fallTimeUS   {0};  // Last active edge (HIGH -> LOW) written by ISR
+  volatile uint32_t riseTimeUS   {0};  // Last inactive edge (LOW -> HIGH) written by ISR
+  volatile uint32_t pulseWidthUS {0};  // Active (LOW) pulse width written by ISR
+  volatile uint32_t periodUS     {0};  // Time between two active edges written by ISR
+  volatile uint32_t meanPeriodUS {0};  // Rolling mean period (1/8 weight) written by ISR
+  uint32_t          firstTimeUS  {0};  // Active edge of FIRST_TIME_PHASE
+  uint32_t          lastTimeUS   {0};  // Inactive edge of LAST_TIME_PHASE (firstTimeUS until then)
+  volatile bool     fallValid    {false}; // fallTimeUS is a real active edge (period and pulse width valid)
+};
+
+
 class MTD2A_binary_input: public MTD2A
 {
+  friend class MTD2A_analog_input;
+  friend class MTD2A_current_detector;
+  friend class MTD2A_distance_input;
+  friend class MTD2A_ir_input;
+
   private:
     // Specific global constants from MTD2A_binary_output.h (MTD2A_const.h)
     static constexpr bool     FIRST_TRIGGER    {MTD2A_const::FIRST_TRIGGER};
@@ -44,6 +62,11 @@ class MTD2A_binary_input: public MTD2A
     static constexpr bool     MONO_STABLE      {MTD2A_const::MONO_STABLE};
     // Timer
     static constexpr uint8_t  RESET_TIMER      {MTD2A_const::RESET_TIMER};
+    // Debounce filter
+    static constexpr uint8_t  NO_DEBOUNCE        {MTD2A_const::NO_DEBOUNCE};
+    static constexpr uint8_t  DEBOUNCE_SHIFT     {MTD2A_const::DEBOUNCE_SHIFT};
+    static constexpr uint8_t  DEBOUNCE_INTEGRATE {MTD2A_const::DEBOUNCE_INTEGRATE};
+    static constexpr uint8_t  MAX_DEBOUNCE       {MTD2A_const::MAX_DEBOUNCE};
     // Phases 
     static constexpr uint8_t  RESET_PHASE      {MTD2A_const::RESET_PHASE}; 
     static constexpr uint8_t  FIRST_TIME_PHASE {MTD2A_const::FIRST_TIME_PHASE};
@@ -52,7 +75,6 @@ class MTD2A_binary_input: public MTD2A
     static constexpr uint8_t  COMPLETE_PHASE   {MTD2A_const::COMPLETE_PHASE};
     
     // Arguments
-    char    *objectName    {nullptr};        // Constructor initialized (User defined name to display identification)
     uint32_t delayTimeMS   {0};              // Constructor default argument (Milliseconds)
     bool     triggerMode   {LAST_TRIGGER};   // Constructor default argument (FIRST_TRIGGER / LAST_TRIGGER)
     bool     timerMode     {TIME_DELAY};     // Constructor default argument (MONO_STABLE / TIME_DELAY)
@@ -63,6 +85,15 @@ class MTD2A_binary_input: public MTD2A
     bool     pinReadToggl  {DISABLE};        // initialize () default argument / ENABLE
     bool     pinReadMode   {NORMAL};         // initialize () and set_PinReadMode () default argument / INVERTED
     bool     inputMode     {PULSE};          // set_InputState () default argument / FIXED
+    bool     pinInterrupt  {DISABLE};        // set_pinInterrupt () default argument / ENABLE
+    uint8_t  pinChangeHandle {PIN_ERROR_NO}; // Pin change interrupt dirty bitmap and edge counter index
+    // Debounce filter
+    uint8_t  debounceMode    {NO_DEBOUNCE};  // set_debounce () default argument / DEBOUNCE_SHIFT / DEBOUNCE_INTEGRATE
+    uint8_t  debounceSamples {0};            // set_debounce () default argument {1 - 8} samples (loops)
+    uint8_t  debounceValue   {MAX_BYTE_VALUE}; // Shift register (one bit per sample) or integrator count
+    // Microsecond timing
+    uint8_t  isrSlot         {PIN_ERROR_NO}; // set_microTiming () External interrupt slot
+    MTD2A_micro_timing *microTiming {nullptr}; // set_microTiming () Edge time stamps
     // Debug and error
     bool     debugPrint    {DISABLE};        // set_debugPrint () default argument / ENABLE
     bool     errorPrint    {DISABLE};        // set_errorPrint () default argument / ENABLE
@@ -86,6 +117,13 @@ class MTD2A_binary_input: public MTD2A
     uint8_t  phaseNumber   {COMPLETE_PHASE}; // Reset= 0, active = 1, Set last time = 2, Pin block = 3, Complete = 4 
     bool     inputGoLow    {false};          // Falling edge
     bool     inputGoHigh   {false};          // Rising edge
+    // Event counters (uint16_t wrap around. Use the difference between two readings)
+    uint16_t fallEdgeCount {0};              // get_fallEdgeCount () inputGoLow
+    uint16_t riseEdgeCount {0};              // get_riseEdgeCount () inputGoHigh
+    uint16_t activateCount {0};              // get_activateCount () FIRST_TIME_PHASE
+    uint16_t completeCount {0};              // get_completeCount () COMPLETE_PHASE
+    uint16_t lostEdgeCount {0};              // get_lostEdgeCount () Pin edges within one loop not seen (set_pinInterrupt)
+    uint8_t  tickEdgeCount {0};              // get_tickEdgeCount () Pin edges within the last loop (set_pinInterrupt)
 
   public:
     // Constructor initializers
@@ -104,12 +142,23 @@ class MTD2A_binary_input: public MTD2A
       const bool     setTimeOrMono  = TIME_DELAY, 
       const uint32_t setPinBlockMS  = 0
     );
+    // F("Object name") flash memory name (only legal inside functions). Names are not copied, see set_objectName ()
+    MTD2A_binary_input (
+      const __FlashStringHelper *setObjectName,
+      const uint32_t setDelayTimeMS = 0,
+      const bool     setFirstOrLast = LAST_TRIGGER,
+      const bool     setTimeOrMono  = TIME_DELAY,
+      const uint32_t setPinBlockMS  = 0
+    );
 
     // Destructor
     ~MTD2A_binary_input () { 
-      if (objectName != nullptr) {
-        delete [] objectName; 
-        objectName = nullptr;
+      if (pinInterrupt == ENABLE)
+        MTD2A_detach_pin_change (pinNumber, pinChangeHandle);
+      if (microTiming != nullptr) {
+        MTD2A_detach_isr_slot (pinNumber, isrSlot);
+        delete microTiming;
+        microTiming = nullptr;
       }
       if (globalObjectCount > 0 )
         globalObjectCount--;
@@ -193,6 +242,33 @@ class MTD2A_binary_input: public MTD2A
     void set_inputState (const bool &setInputLowOrHigh = LOW, const bool &setPulseOrFixed = PULSE);
 
     
+    /**
+     * @brief Filter pin readings. Majority of the last samples (DEBOUNCE_SHIFT) or count up/down integrator with hysteresis (DEBOUNCE_INTEGRATE)
+     * @name object_name.set_debounce
+     * @param ( {NO_DEBOUNCE | DEBOUNCE_SHIFT | DEBOUNCE_INTEGRATE}, {1 - 8} samples );
+     * @return none
+     */
+    void set_debounce (const uint8_t &setDebounceMode = DEBOUNCE_SHIFT, const uint8_t &setDebounceSamples = 4);
+
+
+    /**
+     * @brief Only read pin and run state logic when a pin change interrupt has occurred or timers are running.
+     * @name object_name.set_pinInterrupt
+     * @param ( {ENABLE | DISABLE} );
+     * @return none
+     */
+    void set_pinInterrupt (const bool &setEnableOrDisable = ENABLE);
+
+
+    /**
+     * @brief Time stamp pin edges in microseconds by external interrupt. Pin must support attachInterrupt () (AVR: or pin change interrupt).
+     * @name object_name.set_microTiming
+     * @param ( {ENABLE | DISABLE} );
+     * @return none
+     */
+    void set_microTiming (const bool &setEnableOrDisable = ENABLE);
+
+
     /**
      * @brief Set new delay time in milliseconds.
      * @name object_name.set_delayTimeMS
@@ -330,6 +406,114 @@ class MTD2A_binary_input: public MTD2A
     bool const &get_inputGoLow () const;
 
 
+    /**
+     * @brief Get number of falling edges (inputGoLow). Counter wraps around at 65535
+     * @name object_name.get_fallEdgeCount ();
+     * @param none
+     * @return uint16_t count
+     */
+    uint16_t const &get_fallEdgeCount () const;
+
+
+    /**
+     * @brief Get number of rising edges (inputGoHigh). Counter wraps around at 65535
+     * @name object_name.get_riseEdgeCount ();
+     * @param none
+     * @return uint16_t count
+     */
+    uint16_t const &get_riseEdgeCount () const;
+
+
+    /**
+     * @brief Get number of activations (FIRST_TIME_PHASE). Counter wraps around at 65535
+     * @name object_name.get_activateCount ();
+     * @param none
+     * @return uint16_t count
+     */
+    uint16_t const &get_activateCount () const;
+
+
+    /**
+     * @brief Get number of completions (COMPLETE_PHASE). Counter wraps around at 65535
+     * @name object_name.get_completeCount ();
+     * @param none
+     * @return uint16_t count
+     */
+    uint16_t const &get_completeCount () const;
+
+
+    /**
+     * @brief Get number of pin edges lost between two loops. Requires set_pinInterrupt (ENABLE);
+     * @name object_name.get_lostEdgeCount ();
+     * @param none
+     * @return uint16_t count
+     */
+    uint16_t const &get_lostEdgeCount () const;
+
+
+    /**
+     * @brief Get number of pin edges within the last loop. Requires set_pinInterrupt (ENABLE);
+     * @name object_name.get_tickEdgeCount ();
+     * @param none
+     * @return uint8_t count
+     */
+    uint8_t const &get_tickEdgeCount () const;
+
+
+    /**
+     * @brief Get microsecond timing state
+     * @name object_name.get_microTiming ();
+     * @param none
+     * @return bool {ENABLE | DISABLE}
+     */
+    bool get_microTiming () const;
+
+
+    /**
+     * @brief Get time of the active edge that started FIRST_TIME_PHASE. Requires set_microTiming (ENABLE);
+     * @name object_name.get_firstTimeUS ();
+     * @param none
+     * @return uint32_t Microseconds
+     */
+    uint32_t get_firstTimeUS () const;
+
+
+    /**
+     * @brief Get time of the inactive edge that started LAST_TIME_PHASE. Requires set_microTiming (ENABLE);
+     * @name object_name.get_lastTimeUS ();
+     * @param none
+     * @return uint32_t Microseconds
+     */
+    uint32_t get_lastTimeUS () const;
+
+
+    /**
+     * @brief Get last active (LOW) pulse width. Requires set_microTiming (ENABLE);
+     * @name object_name.get_pulseWidthUS ();
+     * @param none
+     * @return uint32_t Microseconds
+     */
+    uint32_t get_pulseWidthUS () const;
+
+
+    /**
+     * @brief Get last period between two active edges. Requires set_microTiming (ENABLE);
+     * @name object_name.get_periodUS ();
+     * @param none
+     * @return uint32_t Microseconds
+     */
+    uint32_t get_periodUS () const;
+
+
+    /**
+     * @brief Get frequency from rolling mean period. Requires set_microTiming (ENABLE);
+     * @name object_name.get_frequencyHz ();
+     * @param none
+     * @return double Hertz
+     */
+    double get_frequencyHz () const;
+
+
     /**
      * @brief Get and reset error number to zero 
      * @name object_name.get_reset_error ();
@@ -342,7 +526,13 @@ class MTD2A_binary_input: public MTD2A
   private: // Functions
   
     void     loop_fast        ();
+    static void isr_micro_timing (MTD2A *isrObject);
+    uint32_t read_micro_timing (const volatile uint32_t &readTimeUS) const;
+    bool     loop_fast_idle   ();
     void     loop_fast_input  ();
+    virtual bool loop_fast_read ();
+    bool     loop_fast_debounce (const bool &pinRead);
+    bool     debounce_settled () const;
     void     loop_fast_binary ();
     void     loop_fast_first  ();
     void     loop_fast_last   ();
@@ -350,6 +540,13 @@ class MTD2A_binary_input: public MTD2A
     void     end_state        ();
     void     complete_state   ();
     uint32_t check_set_time   (const uint32_t &setCheckTimeMS);
+#if MTD2A_OBJECT_STATE > 0
+    void     MTD2A_snapshot_state (MTD2A_snapshot_record &snapshotRecord) const override;
+#endif
+    bool     MTD2A_link_action    (const uint8_t &linkAction, const uint8_t &actionValue, const bool &executeAction) override;
+#if MTD2A_CONFIG > 0
+    bool     MTD2A_config_field   (const uint8_t &fieldId, const uint32_t &fieldValue, const bool &applyField) override;
+#endif
     void     print_error_text (const uint8_t setErrorNumber);
     void     print_phase_text ();
     void     print_phase_line (const uint8_t &printRestartTimer = MAX_BYTE_VALUE);
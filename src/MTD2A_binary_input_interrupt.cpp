@@ -0,0 +1,66 @@
+/**
+ ******************************************************************************
+ * @file    MTD2A_binary_input_interrupt.cpp
+ * @author  Joergen Bo Madsen
+ * @version 1.0.0
+ * @date    18. October 2026
+ * @brief   Interrupt functions for MTD2A_binary_input.h (Model Train Detection And Action)
+ *
+ * Supporting a vast variety of input sensors and output devices
+ * Simple to use to build complex solutions
+ * Non blocking, simple, yet efficient event-driven state machine
+ * Comprehensive control, state and debug information
+ */
+
+
+#include "Arduino.h"
+#include "MTD2A_base.h"
+#include "MTD2A_binary_input.h"
+
+
+// Translation unit of its own: Only sketches calling set_pinInterrupt () or set_microTiming () link the
+// pin change interrupt and the external interrupt slots (MTD2A_base_interrupt.cpp, AVR PCINT vectors)
+
+
+void MTD2A_binary_input::set_pinInterrupt (const bool &setEnableOrDisable) {
+  if (setEnableOrDisable == ENABLE) {
+    if (pinInterrupt == DISABLE) {
+      uint8_t attachErrorNumber = MTD2A_attach_pin_change (pinNumber, pinChangeHandle);
+      if (attachErrorNumber == 0)
+        pinInterrupt = ENABLE;
+      else
+        print_error_text (attachErrorNumber);
+    }
+  }
+  else {
+    if (pinInterrupt == ENABLE)
+      MTD2A_detach_pin_change (pinNumber, pinChangeHandle);
+    pinInterrupt = DISABLE;
+  }
+} // set_pinInterrupt
+
+
+void MTD2A_binary_input::set_microTiming (const bool &setEnableOrDisable) {
+  if (setEnableOrDisable == ENABLE) {
+    if (microTiming == nullptr) {
+      microTiming = new MTD2A_micro_timing;
+      if (microTiming == nullptr) {
+        print_error_text (18);
+        return;
+      }
+      uint8_t attachErrorNumber = MTD2A_attach_isr_slot (pinNumber, this, isr_micro_timing, isrSlot);
+      if (attachErrorNumber != 0) {
+        delete microTiming;
+        microTiming = nullptr;
+        print_error_text (attachErrorNumber);
+      }
+    }
+  }
+  else {
+    if (microTiming != nullptr) {
+      MTD2A_detach_isr_slot (pinNumber, isrSlot);
+      delete microTiming;
+      microTiming = nullptr;
+    }
+  }
+} // set_microTiming
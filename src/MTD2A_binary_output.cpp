@@ -89,20 +89,42 @@ MTD2A_binary_output::MTD2A_binary_output
     pinOutputMode {setPinOutputMode}, 
     pinBeginValue {setPinBeginValue}, 
     pinEndValue   {setPinEndValue},
+    // Bit packed control flags
+    stopOutputTM  {DISABLE},
+    stopBeginTM   {DISABLE},
+    stopEndTM     {DISABLE},
+    resetOutputTM {DISABLE},
+    resetBeginTM  {DISABLE},
+    resetEndTM    {DISABLE},
+    startPhase    {false},
+    setStartPhase {false},
+    errorPrint    {DISABLE},
+    debugPrint    {DISABLE},
     // Instatiated funtion pointer
     MTD2A{[](MTD2A* funcPtr) { static_cast<MTD2A_binary_output*>(funcPtr)->loop_fast(); }}
   {
     MTD2A_add_function_pointer_loop_fast(this);
-    objectName = MTD2A_set_object_name(setObjectName);
+    MTD2A_set_object_name(setObjectName);
+  }
+// MTD2A_binary_output
+
+
+// Constructor F("Object name")
+MTD2A_binary_output::MTD2A_binary_output
+  (const __FlashStringHelper *setObjectName, const uint32_t setOutputTimeMS, const uint32_t setBeginDelayMS, const uint32_t setEndDelayMS, const bool setPinOutputMode, const uint8_t setPinBeginValue, const uint8_t setPinEndValue)
+  : MTD2A_binary_output ((const char *)nullptr, setOutputTimeMS, setBeginDelayMS, setEndDelayMS, setPinOutputMode, setPinBeginValue, setPinEndValue)
+  {
+    MTD2A_set_object_name(setObjectName);
   }
 // MTD2A_binary_output
 
 
 void MTD2A_binary_output::initialize (const uint8_t &setPinNumber, const bool &setPinNomalOrInverted, const uint8_t &setpinStartValue) {
-  pinWriteMode  = setPinNomalOrInverted;
+  // Configuration block (MTD2A_globalConfig) overrides the arguments
+  pinWriteMode  = (bool)MTD2A_config_value (CONFIG_PIN_MODE, setPinNomalOrInverted);
   pinStartValue = check_pin_value (setpinStartValue);
   if (pinWriteToggl == ENABLE)
-    check_pin_init (setPinNumber);
+    check_pin_init ((uint8_t)MTD2A_config_value (CONFIG_PIN_NUMBER, setPinNumber));
   else
     pinNumber = PIN_ERROR_NO;
   // Check for previous instantiated object error
@@ -381,6 +403,14 @@ uint8_t const &MTD2A_binary_output::get_phaseNumber () const {
 }
 
 
+uint16_t MTD2A_binary_output::get_phaseCount (const uint8_t &getPhaseNumber) const {
+  if (getPhaseNumber <= COMPLETE_PHASE)
+    return phaseCount[getPhaseNumber];
+  else
+    return 0;
+} // get_phaseCount
+
+
 uint32_t const &MTD2A_binary_output::get_setBeginMS () const {
   return setBeginMS;
 }
@@ -463,14 +493,14 @@ uint8_t MTD2A_binary_output::check_PWM_curve (const uint8_t &checkPWMcurveType)
 void MTD2A_binary_output::PWM_curve_begin_end () {
   if (pinEndValue > pinBeginValue) {
     PWMoffstePoint = pinBeginValue;
-    PWMscaleFactor = ((double)pinEndValue - (double)pinBeginValue) / (double)MAX_BYTE_VALUE;
+    PWMscaleFactor = ((float)pinEndValue - (float)pinBeginValue) / (float)MAX_BYTE_VALUE;
     if (PWMcurveType >= FALLING_XY && PWMcurveType <= FALLING_SM5) {
       print_error_text (154);
     }
   }
   else {
     PWMoffstePoint = pinEndValue;
-    PWMscaleFactor = ((double)pinBeginValue - (double)pinEndValue) / (double)MAX_BYTE_VALUE;
+    PWMscaleFactor = ((float)pinBeginValue - (float)pinEndValue) / (float)MAX_BYTE_VALUE;
     if (PWMcurveType >= RISING_XY && PWMcurveType <= RISING_SM5) {
       print_error_text (155);
     }
@@ -481,7 +511,7 @@ void MTD2A_binary_output::PWM_curve_begin_end () {
     print_error_text (150);
   }
   else {
-    PWMtimeStep = (double)outputTimeMS / (double)MAX_BYTE_VALUE;
+    PWMtimeStep = (float)outputTimeMS / (float)MAX_BYTE_VALUE;
   }
   PWMlastPoint = MAX_BYTE_VALUE;
   PWMcurrPoint = 0;
@@ -500,6 +530,12 @@ void MTD2A_binary_output::PWM_curve_step () {
 
 
 uint8_t MTD2A_binary_output::PWM_curve_point (const uint8_t &curvePointX, const uint8_t &curveType) {
+  return PWM_scale_point (PWM_curve_y (curvePointX, curveType));
+} // PWM_curve_point
+
+
+double MTD2A_binary_output::PWM_curve_y (const uint8_t &curvePointX, const uint8_t &curveType) {
+  // Unscaled curve {0 - 255}. Also used by MTD2A_encoder_input (set_target)
   double curvePointY {0};
   //
   switch (curveType) {
@@ -555,8 +591,8 @@ uint8_t MTD2A_binary_output::PWM_curve_point (const uint8_t &curvePointX, const
     curvePointY = pow (2, (((double)MAX_BYTE_VALUE - (double)curvePointX) / LEDfactor)) - 1;
     break;
   }
-  return PWM_scale_point (curvePointY);
-} // PWM_curve_point
+  return curvePointY;
+} // PWM_curve_y
 
 
 double MTD2A_binary_output::PWM_sigmoid_5 (const uint8_t &curvePointX5) {
@@ -613,6 +649,7 @@ void MTD2A_binary_output::loop_fast_begin_start () {
     startPhase   = false;
     processState = ACTIVE;
     phaseChange  = true;
+    phaseCount[phaseNumber]++;
     setBeginMS   = globalSyncTimeMS;
     print_phase_line ();
   }
@@ -654,6 +691,7 @@ void MTD2A_binary_output::loop_fast_out_start () {
     startPhase   = false;
     processState = ACTIVE;
     phaseChange  = true;
+    phaseCount[phaseNumber]++;
     setOutputMS  = globalSyncTimeMS;
     if (pinStartValue != pinBeginValue) 
       write_pin_value (pinBeginValue);
@@ -697,6 +735,7 @@ void MTD2A_binary_output::loop_fast_end_start () {
     startPhase  = false;
     processState = ACTIVE;
     phaseChange = true;
+    phaseCount[phaseNumber]++;
     setEndMS    = globalSyncTimeMS;
     print_phase_line ();
   }
@@ -724,6 +763,7 @@ void MTD2A_binary_output::loop_fast_complete () {
   if (startPhase == true) {
     startPhase = false;
     phaseChange = true;
+    phaseCount[phaseNumber]++;
     print_phase_line ();
   } 
 } // loop_fast_complete
@@ -739,6 +779,7 @@ void MTD2A_binary_output::reset () {
   startPhase     = false; 
   phaseChange    = true;
   phaseNumber    = RESET_PHASE;
+  phaseCount[phaseNumber]++;
   stopOutputTM   = DISABLE;
   stopBeginTM    = DISABLE;
   stopEndTM      = DISABLE;
@@ -760,12 +801,16 @@ void MTD2A_binary_output::reset () {
 
 void MTD2A_binary_output::print_error_text (const uint8_t setErrorNumber) {
   errorNumber = setErrorNumber;
-  MTD2A_print_object_name (objectName);
-  MTD2A_print_error_text ((debugPrint == ENABLE || errorPrint == ENABLE), errorNumber, pinNumber);
+  MTD2A_trace_phase (phaseNumber, errorNumber);
+  if (globalTraceMode == TRACE_OFF) {
+    MTD2A_print_object_name ();
+    MTD2A_print_error_text ((debugPrint == ENABLE || errorPrint == ENABLE), errorNumber, pinNumber);
+  }
 } // print_error_text
 
 
 void MTD2A_binary_output::print_phase_text () {
+#if MTD2A_LOG_LEVEL >= MTD2A_LOG_DEBUG
   switch(phaseNumber) {
     case 0: PortPrintln(F("[0] Reset"));        break;
     case 1: PortPrintln(F("[1] Begin delay"));  break;
@@ -773,24 +818,113 @@ void MTD2A_binary_output::print_phase_text () {
     case 3: PortPrintln(F("[3] End delay"));    break;
     case 4: PortPrintln(F("[4] Complete"));     break;
   }
+#endif
 } // print_phase_text
 
 
+#if MTD2A_OBJECT_STATE > 0
+void MTD2A_binary_output::MTD2A_snapshot_state (MTD2A_snapshot_record &snapshotRecord) const {
+  // timeMS: Start time of the current phase (globalSyncTimeMS, ACTIVE)
+  snapshotRecord.objectType  = SNAPSHOT_OUTPUT;
+  snapshotRecord.phaseNumber = phaseNumber;
+  snapshotRecord.stateFlags  = (uint8_t)(processState | (phaseChange << 1));
+  snapshotRecord.errorNumber = errorNumber;
+  snapshotRecord.pinNumber   = pinNumber;
+  snapshotRecord.pinValue    = pinOutputValue;
+  if (processState == ACTIVE) {
+    switch (phaseNumber) {
+      case BEGIN_PHASE:  snapshotRecord.timeMS = setBeginMS;  break;
+      case OUTPUT_PHASE: snapshotRecord.timeMS = setOutputMS; break;
+      case END_PHASE:    snapshotRecord.timeMS = setEndMS;    break;
+    }
+  }
+} // MTD2A_snapshot_state
+#endif
+
+
+bool MTD2A_binary_output::MTD2A_link_action (const uint8_t &linkAction, const uint8_t &actionValue, const bool &executeAction) {
+  switch (linkAction) {
+    case LINK_ACTIVATE: if (executeAction) activate ();                    return true;
+    case LINK_RESET:    if (executeAction) reset ();                       return true;
+    case LINK_STOP:     if (executeAction) set_outputTimer (STOP_TIMER);   return true;
+    case LINK_WRITE:    if (executeAction) set_pinWriteValue (actionValue); return true;
+  }
+  return false;
+} // MTD2A_link_action
+
+
+#if MTD2A_CONFIG > 0
+bool MTD2A_binary_output::MTD2A_config_field (const uint8_t &fieldId, const uint32_t &fieldValue, const bool &applyField) {
+  // Values are validated by MTD2A_config_check (). CONFIG_PIN_NUMBER is used by initialize ()
+  switch (fieldId) {
+    case CONFIG_PIN_NUMBER:                                                                   break;
+    case CONFIG_PIN_MODE:    if (applyField) pinWriteMode  = (bool)fieldValue;                break;
+    case CONFIG_OUTPUT_TIME: if (applyField) outputTimeMS  = fieldValue;                      break;
+    case CONFIG_BEGIN_DELAY: if (applyField) beginDelayMS  = fieldValue;                      break;
+    case CONFIG_END_DELAY:   if (applyField) endDelayMS    = fieldValue;                      break;
+    case CONFIG_BEGIN_VALUE: if (applyField) pinBeginValue = check_pin_value ((uint8_t)fieldValue); break;
+    case CONFIG_END_VALUE:   if (applyField) pinEndValue   = check_pin_value ((uint8_t)fieldValue); break;
+    case CONFIG_PWM_CURVE:   if (applyField) PWMcurveType  = (uint8_t)fieldValue;             break;
+    default: return false;
+  }
+  // Same as activate (pinBeginValue, pinEndValue, PWMcurveType) until reset ()
+  if (applyField == true  &&  PWMcurveType != NO_CURVE) {
+    pinOutputMode = P_W_M;
+    if (outputTimeMS > 0)
+      PWM_curve_begin_end ();
+  }
+  return true;
+} // MTD2A_config_field
+#endif
+
+
+#if MTD2A_WARM > 0
+bool MTD2A_binary_output::MTD2A_warm_restore (const MTD2A_snapshot_record &warmRecord) {
+  // timeMS: Phase start time on the clock of the last warm save. pinValue: Pin value as written (after NORMAL / INVERTED)
+  if ((warmRecord.stateFlags & 1) != ACTIVE  ||  warmRecord.phaseNumber < BEGIN_PHASE  ||  warmRecord.phaseNumber > END_PHASE)
+    return false;
+  processState   = ACTIVE;
+  phaseNumber    = warmRecord.phaseNumber;
+  setPhaseNumber = warmRecord.phaseNumber;
+  startPhase     = false;
+  setStartPhase  = false;
+  PWMcurveType   = NO_CURVE;
+  const uint32_t phaseTimeMS = globalSyncTimeMS - (MTD2A_warm_time () - warmRecord.timeMS);
+  switch (phaseNumber) {
+    case BEGIN_PHASE:  setBeginMS  = phaseTimeMS; break;
+    case OUTPUT_PHASE: setOutputMS = phaseTimeMS; break;
+    case END_PHASE:    setEndMS    = phaseTimeMS; break;
+  }
+  uint8_t restorePinValue = warmRecord.pinValue;
+  if (pinWriteMode == INVERTED)
+    restorePinValue = (pinOutputMode == BINARY) ? !restorePinValue : MAX_BYTE_VALUE - restorePinValue;
+  write_pin_value (restorePinValue);
+  return true;
+} // MTD2A_warm_restore
+#endif
+
+
 void MTD2A_binary_output::print_phase_line (const uint8_t &printResetTimer) {
-  if (debugPrint == ENABLE  ||  globalDebugPrint == ENABLE) {
-    MTD2A_print_object_name (objectName);
+  MTD2A_trace_phase (phaseNumber);
+#if MTD2A_LOG_LEVEL >= MTD2A_LOG_DEBUG
+  if (globalTraceMode == TRACE_OFF  &&  (debugPrint == ENABLE  ||  globalDebugPrint == ENABLE)) {
+    MTD2A_print_object_name ();
     if (printResetTimer == RESET_TIMER) {
       PortPrint(F(": Reset timer >"));
     }
     PortPrint(F(" "));  
     print_phase_text ();
   }
+#else
+  (void)printResetTimer;
+#endif
 } // print_phase_line
 
 
 void MTD2A_binary_output::print_conf () {
+#if MTD2A_LOG_LEVEL >= MTD2A_LOG_DEBUG
   PortPrintln(F("MTD2A_binary_output: "));
-  MTD2A_print_name_state (objectName, processState);
+  MTD2A_print_name_state (processState);
   PortPrint  (F("  phaseText    : ")); print_phase_text ();
   MTD2A_print_debug_error  (debugPrint, errorPrint, errorNumber);
   //
@@ -811,4 +945,5 @@ void MTD2A_binary_output::print_conf () {
   PortPrint  (F("  setOutputMS  : ")); PortPrintln(setOutputMS);
   PortPrint  (F("  setBeginMS   : ")); PortPrintln(setBeginMS);
   PortPrint  (F("  setEndMS     : ")); PortPrintln(setEndMS);
+#endif
 } // print_conf 
@@ -36,6 +36,8 @@
 
 class MTD2A_binary_output: public MTD2A
 {
+  friend class MTD2A_encoder_input;
+
   private:
     // Specific global constants from MTD2A_binary_output.h (MTD2A_const.h)
     static constexpr bool    P_W_M          {MTD2A_const::P_W_M};
@@ -72,53 +74,57 @@ class MTD2A_binary_output: public MTD2A
     // Base
     static constexpr uint8_t MAX_PWM_CURVES {MTD2A::MAX_PWM_CURVES};
 
+    // Fields are grouped by size (no padding) and bool control flags are bit packed (1 bit each).
+    // Hot fields read every MTD2A_loop_execute () are placed together at the top.
+    // No structure of arrays pool: AVR has no data cache, ESP32 internal RAM is not cached, and every update reads cold fields too.
+    // State control (hot)
+    uint8_t  phaseNumber    {COMPLETE_PHASE}; // reset = 0, Begin delay = 1, Output = 2, End delay = 3, Complete = 4
+    uint8_t  setPhaseNumber {COMPLETE_PHASE}; // Set phase number to execute (loop_fast ();)
+    bool     phaseChange    {false};          // true = change in timing state
+    bool     processState   {COMPLETE};       // process state / ACTIVE
+    // Timers (hot)
+    uint32_t setOutputMS    {0};              // Milliseconds (output start time)
+    uint32_t setBeginMS     {0};              // Milliseconds (begin start time)
+    uint32_t setEndMS       {0};              // Milliseconds (end start time)
     // Arguments
-    char    *objectName     {nullptr};        // Constructor default argument (User defined name to display identification)
     uint32_t outputTimeMS   {0};              // Constructor default argument (Milliseconds) 
     uint32_t beginDelayMS   {0};              // Constructor default argument (Milliseconds)  
     uint32_t endDelayMS     {0};              // Constructor default argument (Milliseconds)
-    bool     pinOutputMode  {BINARY};         // Constructor default argument (BINARY/P_W_M)
-    uint8_t  pinBeginValue  {HIGH};           // Constructor default argument BINARY {HIGH | LOW} / P_W_M {0-255} 
-    uint8_t  pinEndValue    {LOW};            // Constructor default argument BINARY {HIGH | LOW} / P_W_M {0-255}
+    // PWM curves
+    float    PWMscaleFactor {0.0};            // PWM scaling factor {-1 - 1} Zero results in a straight line
+    float    PWMtimeStep    {0.0};            // PWM curve time stepping factor
+    uint16_t phaseCount[COMPLETE_PHASE + 1] {0}; // get_phaseCount () Phase transitions per phase (uint16_t wrap around)
+    uint8_t  PWMcurveType   {NO_CURVE};       // PWM curve selection   
+    uint8_t  PWMoffstePoint {0};              // PWM start (rising) or end (falling) value
+    uint8_t  PWMcurrPoint   {0};              // Current calculatede point {0-255}
+    uint8_t  PWMlastPoint   {MAX_BYTE_VALUE}; // Last to tjek for dublets (don't write)
+    uint8_t  PWMpinValue    {0};              // Final curve calculated pin vallue    
     // pin and input setup
     uint8_t  pinNumber      {PIN_ERROR_NO};   // initialize () default argument
     uint8_t  pinOutputValue {LOW};            // Current value to write to output. get_pinOuputValue ()
-    bool     pinWriteToggl  {ENABLE};         // set_pinWriteToggl ()
-    bool     pinWriteMode   {NORMAL};         // initialize () and set_pinWriteMode () default argument / INVERTED
+    uint8_t  pinBeginValue  {HIGH};           // Constructor default argument BINARY {HIGH | LOW} / P_W_M {0-255} 
+    uint8_t  pinEndValue    {LOW};            // Constructor default argument BINARY {HIGH | LOW} / P_W_M {0-255}
     uint8_t  pinStartValue  {LOW};            // initialize () default argument BINARY {HIGH | LOW} / P_W_M {0-255}
     uint8_t  pinWriteValue  {LOW};            // set_pinWriteValue () default argument BINARY {HIGH | LOW} / P_W_M {0-255}
-    bool     processState   {COMPLETE};       // process state / ACTIVE
-    // Timers
-    uint32_t setOutputMS    {0};              // Milliseconds (output start time)
-    uint32_t setBeginMS     {0};              // Milliseconds (begin start time)
-    uint32_t setEndMS       {0};              // Milliseconds (end start time)
+    uint8_t  errorNumber    {0};              // get_reset_error () Error {1-127} and Warning {128-255}
+    bool     pinOutputMode  {BINARY};         // Constructor default argument (BINARY/P_W_M)
+    bool     pinWriteToggl  {ENABLE};         // set_pinWriteToggl ()
+    bool     pinWriteMode   {NORMAL};         // initialize () and set_pinWriteMode () default argument / INVERTED
+    // Bit packed control flags. Initialized DISABLE / false by the constructor (no default member initializer for bit-fields in C++11)
     // Stop timer
-    bool     stopOutputTM   {DISABLE};        // stop output timer process when executing MTD2A_loop_execute ();
-    bool     stopBeginTM    {DISABLE};        // stop begin delay timer proces when executing MTD2A_loop_execute ();
-    bool     stopEndTM      {DISABLE};        // stop end delay timer proces when executing MTD2A_loop_execute ();
+    bool     stopOutputTM   : 1;              // stop output timer process when executing MTD2A_loop_execute ();
+    bool     stopBeginTM    : 1;              // stop begin delay timer proces when executing MTD2A_loop_execute ();
+    bool     stopEndTM      : 1;              // stop end delay timer proces when executing MTD2A_loop_execute ();
     // sync time control
-    bool     resetOutputTM  {DISABLE};          // Reset outputTimeMS when executing MTD2A_loop_execute ();
-    bool     resetBeginTM   {DISABLE};          // Reset beginDelayMS when executing MTD2A_loop_execute ();
-    bool     resetEndTM     {DISABLE};          // Reset endDelayMS when executing MTD2A_loop_execute ();
-    // Debug and error
-    bool     errorPrint     {DISABLE};        // set_errorPrint () default argument ENABLE
-    bool     debugPrint     {DISABLE};        // set_debugPrint () print debug & error. default argument ENABLE
-    uint8_t  errorNumber    {0};              // get_reset_error () Error {1-127} and Warning {128-255}
+    bool     resetOutputTM  : 1;              // Reset outputTimeMS when executing MTD2A_loop_execute ();
+    bool     resetBeginTM   : 1;              // Reset beginDelayMS when executing MTD2A_loop_execute ();
+    bool     resetEndTM     : 1;              // Reset endDelayMS when executing MTD2A_loop_execute ();
     // state control
-    bool     startPhase     {false};          // Start phase procedure execution
-    bool     setStartPhase  {false};          // Activate start phase procedure execution
-    bool     phaseChange    {false};          // true = change in timing state
-    uint8_t  phaseNumber    {COMPLETE_PHASE}; // reset = 0, Begin delay = 1, Output = 2, End delay = 3, Complete = 4
-    uint8_t  setPhaseNumber {COMPLETE_PHASE}; // Set phase number to execute (loop_fast ();)
-
-    // PWM curves
-    uint8_t  PWMcurveType   {NO_CURVE};       // PWM curve selection   
-    uint8_t  PWMoffstePoint {0};              // PWM start (rising) or end (falling) value
-    uint8_t  PWMcurrPoint   {0};              // Current calculatede point {0-255}
-    uint8_t  PWMlastPoint   {MAX_BYTE_VALUE}; // Last to tjek for dublets (don't write)
-    uint8_t  PWMpinValue    {0};              // Final curve calculated pin vallue    
-    double   PWMscaleFactor {0.0};            // PWM scaling factor {-1 - 1} Zero results in a straight line
-    double   PWMtimeStep    {0.0};            // PWM curve time stepping factor
+    bool     startPhase     : 1;              // Start phase procedure execution
+    bool     setStartPhase  : 1;              // Activate start phase procedure execution
+    // Debug and error
+    bool     errorPrint     : 1;              // set_errorPrint () default argument ENABLE
+    bool     debugPrint     : 1;              // set_debugPrint () print debug & error. default argument ENABLE
 
     // PWM power curve calculations
     static constexpr double  powPotens05  {0.50};
@@ -152,12 +158,18 @@ class MTD2A_binary_output: public MTD2A
       const uint8_t  setPinBeginValue = HIGH, 
       const uint8_t  setPinEndValue   = LOW
     );
+    // F("Object name") flash memory name (only legal inside functions). Names are not copied, see set_objectName ()
+    MTD2A_binary_output (
+      const __FlashStringHelper *setObjectName,
+      const uint32_t setOutputTimeMS  = 0,
+      const uint32_t setBeginDelayMS  = 0,
+      const uint32_t setEndDelayMS    = 0,
+      const bool     setPinOutputMode = BINARY,
+      const uint8_t  setPinBeginValue = HIGH,
+      const uint8_t  setPinEndValue   = LOW
+    );
     // Destructor
     ~MTD2A_binary_output () { 
-      if (objectName != nullptr) {
-        delete [] objectName; 
-        objectName = nullptr;
-      }
       if (globalObjectCount > 0 )
         globalObjectCount--;
     };
@@ -401,6 +413,15 @@ class MTD2A_binary_output: public MTD2A
     uint8_t const &get_phaseNumber () const;
   
 
+    /**
+     * @brief get number of transitions to a phase. Counter wraps around at 65535
+     * @name object_name.get_phaseCount
+     * @param ( {RESET_PHASE | BEGIN_PHASE | OUTPUT_PHASE | END_PHASE | COMPLETE_PHASE} );
+     * @return uint16_t count
+     */  
+    uint16_t get_phaseCount (const uint8_t &getPhaseNumber) const;
+
+
     /**
      * @brief Get begin start time
      * @name object_name.get_setBeginMS ();
@@ -451,6 +472,7 @@ class MTD2A_binary_output: public MTD2A
     double   PWM_sigmoid_5         (const uint8_t  &curvePointX5);
     double   PWM_sigmoid_8         (const uint8_t  &curvePointX8);
     uint8_t  PWM_curve_point       (const uint8_t  &curvePointX, const uint8_t &curveType);
+    double   PWM_curve_y           (const uint8_t  &curvePointX, const uint8_t &curveType);
     void     PWM_curve_step        ();
     void     loop_fast_begin_start ();
     void     loop_fast_begin_timer ();
@@ -459,6 +481,16 @@ class MTD2A_binary_output: public MTD2A
     void     loop_fast_end_start   ();
     void     loop_fast_end_timer   ();
     void     loop_fast_complete    ();
+#if MTD2A_OBJECT_STATE > 0
+    void     MTD2A_snapshot_state (MTD2A_snapshot_record &snapshotRecord) const override;
+#endif
+    bool     MTD2A_link_action    (const uint8_t &linkAction, const uint8_t &actionValue, const bool &executeAction) override;
+#if MTD2A_CONFIG > 0
+    bool     MTD2A_config_field   (const uint8_t &fieldId, const uint32_t &fieldValue, const bool &applyField) override;
+#endif
+#if MTD2A_WARM > 0
+    bool     MTD2A_warm_restore   (const MTD2A_snapshot_record &warmRecord) override;
+#endif
     void     print_error_text      (const uint8_t setErrorNumber);
     void     print_phase_text      ();
     void     print_phase_line      (const uint8_t  &printRestartTimer = MAX_BYTE_VALUE);
@@ -46,13 +46,40 @@ namespace MTD2A_const {
   constexpr bool     BINARY         = true,  P_W_M        = false;
   constexpr uint8_t  DELAY_10MS     = 10,    DELAY_5MS    = 5,    DELAY_1MS      = 1;
   constexpr uint8_t  MAX_BYTE_VALUE = 255,   PIN_ERROR_NO = 255;
+  constexpr uint8_t  TRACE_OFF      = 0,     TRACE_TEXT   = 1,    TRACE_RAW      = 2;
+  // Debounce filter - binary_input
+  constexpr uint8_t  NO_DEBOUNCE      = 0,  DEBOUNCE_SHIFT  = 1,  DEBOUNCE_INTEGRATE = 2;
+  constexpr uint8_t  MAX_DEBOUNCE     = 8;  // Samples (loops)
+  constexpr uint8_t  MAX_OVERSAMPLING = 16; // analogRead samples per loop - analog_input
+  // Current detector
+  constexpr uint8_t  DETECT_RMS       = 0,  DETECT_PEAK     = 1;
   // Timers
   constexpr uint8_t  RESET_TIMER      = 0,  START_TIMER     = 1,  PAUSE_TIMER    = 2,  STOP_TIMER = 3;
   // Process phases
   constexpr uint8_t  RESET_PHASE      = 0; 
   constexpr uint8_t  BEGIN_PHASE      = 1,  OUTPUT_PHASE    = 2,  END_PHASE      = 3; // binary_input 
   constexpr uint8_t  FIRST_TIME_PHASE = 1,  LAST_TIME_PHASE = 2,  BLOCKING_PHASE = 3; // binary_output
+  constexpr uint8_t  ENTRY_PHASE      = 1,  SPEED_PHASE     = 2,  LENGTH_PHASE   = 3; // speed_trap
+  constexpr uint8_t  RUN_PHASE        = 1,  PAUSE_PHASE     = 2;                      // sequence
+  constexpr uint8_t  TURN_PHASE       = 1;                                              // encoder_input
   constexpr uint8_t  COMPLETE_PHASE   = 4;
+  constexpr uint8_t  ALL_PHASES       = 0xFF; // set_callback () phase mask. One phase: (1 << COMPLETE_PHASE)
+  // Link actions - MTD2A_link ()
+  constexpr uint8_t  LINK_ACTIVATE    = 1,  LINK_RESET      = 2,  LINK_STOP      = 3,  LINK_PAUSE = 4;
+  constexpr uint8_t  LINK_WRITE       = 5;
+  // Sequence step table memory - sequence
+  constexpr bool     FLASH_TABLE      = true,  RAM_TABLE    = false;
+  // Script code memory - script
+  constexpr uint8_t  SCRIPT_RAM       = 0,  SCRIPT_FLASH    = 1,  SCRIPT_EEPROM  = 2;
+  // Configuration block fields (object index, field, value) - MTD2A_globalConfig
+  constexpr uint8_t  CONFIG_PIN_NUMBER  = 1,  CONFIG_PIN_MODE    = 2,  CONFIG_DELAY_TIME = 3,  CONFIG_BLOCK_TIME  = 4;
+  constexpr uint8_t  CONFIG_OUTPUT_TIME = 5,  CONFIG_BEGIN_DELAY = 6,  CONFIG_END_DELAY  = 7,  CONFIG_BEGIN_VALUE = 8;
+  constexpr uint8_t  CONFIG_END_VALUE   = 9,  CONFIG_PWM_CURVE   = 10, CONFIG_COUNT_DOWN = 11, CONFIG_DISTANCE    = 12;
+  constexpr uint8_t  CONFIG_TIME_OUT    = 13, CONFIG_THRESHOLD   = 14, CONFIG_HYSTERESIS = 15;
+  // Direction - speed_trap
+  constexpr uint8_t  NO_DIRECTION     = 0,  LEFT_TO_RIGHT   = 1,  RIGHT_TO_LEFT  = 2;
+  // Direction - encoder_input
+  constexpr uint8_t  CLOCKWISE        = 1,  COUNTER_CLOCKWISE = 2;
   // PWM rising curves - binary_output
   constexpr uint8_t  MIN_PWM_VALUE = 0,   MAX_PWM_VALUE = 255;  
   constexpr uint8_t  NO_CURVE      = 0; 
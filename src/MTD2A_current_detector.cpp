@@ -0,0 +1,184 @@
+/*
+ ******************************************************************************
+ * @file    MTD2A_current_detector.cpp
+ * @author  Joergen Bo Madsen
+ * @version 1.0.0
+ * @date    18. October 2026
+ * @brief   functions for MTD2A_current_detector.h (Model Train Detection And Action)
+ *
+ * Supporting a vast variety of input sensors and output devices
+ * Simple to use to build complex solutions
+ * Non blocking, simple, yet efficient event-driven state machine
+ * Comprehensive control, state and debug information
+ */
+
+
+#include "Arduino.h"
+#include "MTD2A_base.h"
+#include "MTD2A_binary_input.h"
+#include "MTD2A_analog_input.h"
+#include "MTD2A_current_detector.h"
+
+
+// Specific global constants from MTD2A_current_detector.h (MTD2A_const.h)
+constexpr uint8_t  MTD2A_current_detector::DETECT_RMS;
+constexpr uint8_t  MTD2A_current_detector::DETECT_PEAK;
+constexpr uint16_t MTD2A_current_detector::MAX_WINDOW_SAMPLES;
+
+
+// Integer square root (bit by bit). uint32_t on AVR, uint64_t on other boards
+template <typename sqrt_type>
+static uint32_t MTD2A_isqrt (sqrt_type squareValue) {
+  sqrt_type rootValue {0};
+  sqrt_type rootBit   {(sqrt_type)1 << (sizeof(sqrt_type) * 8 - 2)};
+  while (rootBit > squareValue)
+    rootBit >>= 2;
+  while (rootBit != 0) {
+    if (squareValue >= rootValue + rootBit) {
+      squareValue -= rootValue + rootBit;
+      rootValue = (rootValue >> 1) + rootBit;
+    }
+    else
+      rootValue >>= 1;
+    rootBit >>= 2;
+  }
+  return (uint32_t)rootValue;
+} // MTD2A_isqrt
+
+
+// Constructor
+MTD2A_current_detector::MTD2A_current_detector
+  (
+    const char    *setObjectName,
+    const uint32_t setDelayTimeMS,
+    const bool     setFirstOrLast,
+    const bool     setTimeOrMono,
+    const uint32_t setPinBlockMS
+  )
+  : MTD2A_analog_input (setObjectName, setDelayTimeMS, setFirstOrLast, setTimeOrMono, setPinBlockMS)
+  {}
+// MTD2A_current_detector
+
+
+// Constructor F("Object name")
+MTD2A_current_detector::MTD2A_current_detector
+  (const __FlashStringHelper *setObjectName, const uint32_t setDelayTimeMS, const bool setFirstOrLast, const bool setTimeOrMono, const uint32_t setPinBlockMS)
+  : MTD2A_current_detector ((const char *)nullptr, setDelayTimeMS, setFirstOrLast, setTimeOrMono, setPinBlockMS)
+  {
+    MTD2A_set_object_name(setObjectName);
+  }
+// MTD2A_current_detector
+
+
+void MTD2A_current_detector::initialize (const uint8_t &setPinNumber, const uint16_t &setThreshold, const uint16_t &setHysteresis, const uint8_t &setDetectMode, const uint32_t &setWindowMS) {
+  // Above threshold (HIGH) is active
+  MTD2A_analog_input::initialize (setPinNumber, setThreshold, setHysteresis, INVERTED);
+  set_detectMode (setDetectMode, setWindowMS);
+  // Scan engine if the sketch set a scan table (MTD2A_globalAdcScan). Otherwise warning 134 and analogRead () without a
+  // blocking burst (set_oversampling (), default 1 sample per loop: the window collects the samples of several loops)
+  if (pinNumber != PIN_ERROR_NO)
+    set_adcScan (ENABLE);
+} // initialize
+
+
+void MTD2A_current_detector::set_detectMode (const uint8_t &setDetectMode, const uint32_t &setWindowMS) {
+  if (setDetectMode > DETECT_PEAK) {
+    print_error_text (163);
+    detectMode = DETECT_RMS;
+  }
+  else {
+    detectMode = setDetectMode;
+  }
+  windowMS      = check_set_time (setWindowMS);
+  windowStartMS = globalSyncTimeMS;
+  windowCount   = 0;
+} // set_detectMode
+
+
+//  Getters ----------------------------------------------------------------------------
+
+
+uint16_t const &MTD2A_current_detector::get_windowSamples () const {
+  return windowSamples;
+}
+
+
+uint8_t const &MTD2A_current_detector::get_detectMode () const {
+  return detectMode;
+}
+
+
+//  Private ----------------------------------------------------------------------------
+
+
+bool MTD2A_current_detector::loop_fast_value () {
+  MTD2A_adc_stats tickStats;
+  if (adcSlot != PIN_ERROR_NO) {
+    MTD2A_adc_scan_stats (adcSlot, tickStats);
+  }
+  else {
+    for (uint8_t sampleIndex = 0; sampleIndex < oversampling; sampleIndex++) {
+      const uint16_t sampleValue = (uint16_t)analogRead(pinNumber);
+      if (tickStats.sampleCount == 0  ||  sampleValue < tickStats.minValue)
+        tickStats.minValue = sampleValue;
+      if (tickStats.sampleCount == 0  ||  sampleValue > tickStats.maxValue)
+        tickStats.maxValue = sampleValue;
+      tickStats.sumValue  += sampleValue;
+      tickStats.sumSquare += (uint32_t)sampleValue * sampleValue;
+      tickStats.sampleCount++;
+    }
+  }
+  // Add the loop samples to the window (a full window keeps its samples until the window time ends)
+  if (tickStats.sampleCount > 0  &&  (uint32_t)windowCount + tickStats.sampleCount <= MAX_WINDOW_SAMPLES) {
+    if (windowCount == 0  ||  tickStats.minValue < windowMin)
+      windowMin = tickStats.minValue;
+    if (windowCount == 0  ||  tickStats.maxValue > windowMax)
+      windowMax = tickStats.maxValue;
+    windowSum    += tickStats.sumValue;
+    windowSquare += tickStats.sumSquare;
+    windowCount  += tickStats.sampleCount;
+  }
+  if (globalSyncTimeMS - windowStartMS < windowMS  ||  windowCount == 0)
+    return false;
+  windowStartMS = globalSyncTimeMS;
+  analogValue   = window_level ();
+  windowSamples = windowCount;
+  windowSum     = 0;
+  windowSquare  = 0;
+  windowCount   = 0;
+  return true;
+} // loop_fast_value
+
+
+uint16_t MTD2A_current_detector::window_level () const {
+  if (detectMode == DETECT_PEAK)
+    return (windowMax - windowMin) / 2;
+  // count * variance = sum(x²) - sum(x)² / count. With mean = sum / count and rest = sum % count:
+  // sum(x)² / count = mean * (sum + rest) + rest² / count. No overflow and no negative values
+  const uint32_t windowMean = windowSum / windowCount;
+  const uint32_t windowRest = windowSum % windowCount;
+  window_sum_type squareDeviation = windowSquare - (window_sum_type)windowMean * (windowSum + windowRest);
+  const uint32_t restSquare = windowRest * windowRest / windowCount;
+  squareDeviation = (squareDeviation > restSquare) ? squareDeviation - restSquare : 0;
+  return (uint16_t)MTD2A_isqrt (squareDeviation / windowCount);
+} // window_level
+
+
+#if MTD2A_OBJECT_STATE > 0
+void MTD2A_current_detector::MTD2A_snapshot_state (MTD2A_snapshot_record &snapshotRecord) const {
+  // pinValue: RMS or peak level / 4 (0 - 255). timeMS as binary_input
+  MTD2A_analog_input::MTD2A_snapshot_state (snapshotRecord);
+  snapshotRecord.objectType = SNAPSHOT_CURRENT;
+} // MTD2A_snapshot_state
+#endif
+
+
+void MTD2A_current_detector::print_conf () {
+#if MTD2A_LOG_LEVEL >= MTD2A_LOG_DEBUG
+  MTD2A_analog_input::print_conf ();
+  PortPrintln(F("MTD2A_current_detector: "));
+  PortPrint  (F("  detectMode   : ")); if (detectMode == DETECT_PEAK) PortPrintln(F("DETECT_PEAK")); else PortPrintln(F("DETECT_RMS"));
+  PortPrint  (F("  windowMS     : ")); PortPrintln(windowMS);
+  PortPrint  (F("  windowSamples: ")); PortPrintln(windowSamples);
+#endif
+} // print_conf
@@ -0,0 +1,154 @@
+/*
+ ******************************************************************************
+ * @file    MTD2A_current_detector.h
+ * @author  Joergen Bo Madsen
+ * @version 1.0.0
+ * @date    18. October 2026
+ * @brief   Current sense block occupancy detector with windowed RMS or peak (analog_input state machine)
+ *
+ * Supporting a vast variety of input sensors and output devices
+ * Simple to use to build complex solutions
+ * Non blocking, simple, yet efficient event-driven state machine
+ * Comprehensive control, state and debug information
+ */
+
+
+
+#ifndef _MTD2A_current_detector_H_
+#define _MTD2A_current_detector_H_
+
+
+#include "Arduino.h"
+#include "MTD2A_base.h"
+#include "MTD2A_binary_input.h"
+#include "MTD2A_analog_input.h"
+
+
+// Samples are collected by the ADC scan engine between two loops (AVR: about 9600 conversions per second shared by all channels).
+// Every windowMS the level is calculated with integer math and compared with threshold and hysteresis (MTD2A_analog_input):
+//   DETECT_RMS : AC RMS = sqrt(mean(x²) - mean(x)²). Sensor DC offset (e.g. ACS712 at VCC/2) is removed. DCC and PWM track current
+//   DETECT_PEAK: (max - min) / 2 within the window
+// Above threshold = occupied = active (FIRST_TIME_PHASE). Phases, timers and counters are the binary_input ones.
+// DC track current: use MTD2A_analog_input (mean value)
+
+
+class MTD2A_current_detector: public MTD2A_analog_input
+{
+  private:
+    // Specific global constants from MTD2A_current_detector.h (MTD2A_const.h)
+    static constexpr uint8_t  DETECT_RMS   {MTD2A_const::DETECT_RMS};
+    static constexpr uint8_t  DETECT_PEAK  {MTD2A_const::DETECT_PEAK};
+#if defined(__AVR__)
+    // 10 bit ADC: 4096 samples * 1023² fits in uint32_t (no 64 bit division on AVR)
+    using window_sum_type = uint32_t;
+    static constexpr uint16_t MAX_WINDOW_SAMPLES {4096};
+#else
+    using window_sum_type = uint64_t;
+    static constexpr uint16_t MAX_WINDOW_SAMPLES {65535};
+#endif
+
+    // Arguments
+    uint8_t  detectMode    {DETECT_RMS};     // initialize () and set_detectMode () default argument / DETECT_PEAK
+    uint32_t windowMS      {20};             // initialize () and set_detectMode () default argument (Milliseconds)
+    // Window
+    uint32_t windowStartMS {0};              // Window start time
+    uint32_t windowSum     {0};              // Sum of samples
+    window_sum_type windowSquare {0};        // Sum of squared samples
+    uint16_t windowMin     {0};              // Lowest sample
+    uint16_t windowMax     {0};              // Highest sample
+    uint16_t windowCount   {0};              // Samples in the current window
+    uint16_t windowSamples {0};              // get_windowSamples () Samples in the last complete window
+
+  public:
+    // Constructor initializers
+
+    /**
+     * @class MTD2A_current_detector
+     * @brief Create object and set configuration parameters or use defaults
+     * @param ( "Object Name", delayTimeMS, {FIRST_TRIGGER | LAST_TRIGGER}, {TIME_DELAY | MONO_STABLE}, pinBlocTimeMS );
+     * @param delayTimeMS & pinblockTimeMS {0 - 4294967295} milliseconds
+     * @return none
+     */
+    MTD2A_current_detector (
+      const char    *setObjectName  = "Object name",
+      const uint32_t setDelayTimeMS = 0,
+      const bool     setFirstOrLast = LAST_TRIGGER,
+      const bool     setTimeOrMono  = TIME_DELAY,
+      const uint32_t setPinBlockMS  = 0
+    );
+    // F("Object name") flash memory name (only legal inside functions). Names are not copied, see set_objectName ()
+    MTD2A_current_detector (
+      const __FlashStringHelper *setObjectName,
+      const uint32_t setDelayTimeMS = 0,
+      const bool     setFirstOrLast = LAST_TRIGGER,
+      const bool     setTimeOrMono  = TIME_DELAY,
+      const uint32_t setPinBlockMS  = 0
+    );
+
+    // Destructor (scan channel and globalObjectCount are released by the base classes)
+    ~MTD2A_current_detector () {};
+
+  public: // Functions
+    /**
+     * @brief Initalize analog pin, threshold, hysteresis and detect mode. The pin is read by the ADC scan engine (set_adcScan) if the sketch set a scan table (MTD2A_globalAdcScan), otherwise warning 134 and set_oversampling () analogRead () samples per loop (default 1).
+     * @name object_name.initialize
+     * @param ( {A0 - A(NUM_ANALOG_INPUTS - 1) | 255}, threshold {0 - 65535}, hysteresis {0 - 65535}, {DETECT_RMS | DETECT_PEAK}, windowMS );
+     * @return none
+     */
+    void initialize (const uint8_t &setPinNumber = PIN_ERROR_NO, const uint16_t &setThreshold = 20, const uint16_t &setHysteresis = 4, const uint8_t &setDetectMode = DETECT_RMS, const uint32_t &setWindowMS = 20);
+
+
+    /*
+     * @brief print configuration parameters, timers and state logic.
+     * @name object_name.print_conf ();
+     * @param none
+     * @return none
+     */
+    void print_conf ();
+
+
+    // Setters -----------------------------------------------
+
+
+    /**
+     * @brief Set detect mode and window time. Window 0 = every loop. Use at least one track waveform period (e.g. 20 ms for 50 Hz PWM)
+     * @name object_name.set_detectMode
+     * @param ( {DETECT_RMS | DETECT_PEAK}, windowMS {0 | globalDelayTimeMS - 4294967295} );
+     * @return none
+     */
+    void set_detectMode (const uint8_t &setDetectMode = DETECT_RMS, const uint32_t &setWindowMS = 20);
+
+
+    // Getters -----------------------------------------------
+
+
+    /**
+     * @brief Get number of samples in the last complete window
+     * @name object_name.get_windowSamples ();
+     * @param none
+     * @return uint16_t count
+     */
+    uint16_t const &get_windowSamples () const;
+
+
+    /**
+     * @brief Get detect mode
+     * @name object_name.get_detectMode ();
+     * @param none
+     * @return uint8_t {DETECT_RMS | DETECT_PEAK}
+     */
+    uint8_t const &get_detectMode () const;
+
+
+  private: // Functions
+
+    bool     loop_fast_value () override;
+    uint16_t window_level () const;
+#if MTD2A_OBJECT_STATE > 0
+    void     MTD2A_snapshot_state (MTD2A_snapshot_record &snapshotRecord) const override;
+#endif
+
+}; // class MTD2A_current_detector
+
+
+#endif
@@ -0,0 +1,280 @@
+/*
+ ******************************************************************************
+ * @file    MTD2A_distance_input.cpp
+ * @author  Joergen Bo Madsen
+ * @version 1.0.0
+ * @date    18. October 2026
+ * @brief   functions for MTD2A_distance_input.h (Model Train Detection And Action)
+ *
+ * Supporting a vast variety of input sensors and output devices
+ * Simple to use to build complex solutions
+ * Non blocking, simple, yet efficient event-driven state machine
+ * Comprehensive control, state and debug information
+ */
+
+
+#include "Arduino.h"
+#include "MTD2A_base.h"
+#include "MTD2A_binary_input.h"
+#include "MTD2A_distance_input.h"
+
+
+// Specific global constants from MTD2A_distance_input.h
+constexpr uint32_t MTD2A_distance_input::PING_GAP_MS;
+constexpr uint32_t MTD2A_distance_input::ECHO_TIMEOUT_MS;
+constexpr uint16_t MTD2A_distance_input::MAX_DISTANCE_MM;
+
+// Ping order linked list
+MTD2A_distance_input *MTD2A_distance_input::pingBegin {nullptr};
+MTD2A_distance_input *MTD2A_distance_input::pingTurn  {nullptr};
+uint32_t              MTD2A_distance_input::pingEndMS {0};
+
+
+// Constructor
+MTD2A_distance_input::MTD2A_distance_input
+  (
+    const char    *setObjectName,
+    const uint32_t setDelayTimeMS,
+    const bool     setFirstOrLast,
+    const bool     setTimeOrMono,
+    const uint32_t setPinBlockMS
+  )
+  : MTD2A_binary_input (setObjectName, setDelayTimeMS, setFirstOrLast, setTimeOrMono, setPinBlockMS)
+  {
+    pinType = INPUT;
+    // Ping in instantiation order
+    if (pingBegin == nullptr) {
+      pingBegin = this;
+      pingTurn  = this;
+    }
+    else {
+      MTD2A_distance_input *pingLast = pingBegin;
+      while (pingLast->pingNext != nullptr)
+        pingLast = pingLast->pingNext;
+      pingLast->pingNext = this;
+    }
+  }
+// MTD2A_distance_input
+
+
+// Constructor F("Object name")
+MTD2A_distance_input::MTD2A_distance_input
+  (const __FlashStringHelper *setObjectName, const uint32_t setDelayTimeMS, const bool setFirstOrLast, const bool setTimeOrMono, const uint32_t setPinBlockMS)
+  : MTD2A_distance_input ((const char *)nullptr, setDelayTimeMS, setFirstOrLast, setTimeOrMono, setPinBlockMS)
+  {
+    MTD2A_set_object_name(setObjectName);
+  }
+// MTD2A_distance_input
+
+
+// Destructor
+MTD2A_distance_input::~MTD2A_distance_input () {
+  if (isrSlot != PIN_ERROR_NO)
+    MTD2A_detach_isr_slot (pinNumber, isrSlot);
+  if (pingBegin == this) {
+    pingBegin = pingNext;
+  }
+  else {
+    for (MTD2A_distance_input *pingObject = pingBegin; pingObject != nullptr; pingObject = pingObject->pingNext) {
+      if (pingObject->pingNext == this) {
+        pingObject->pingNext = pingNext;
+        break;
+      }
+    }
+  }
+  if (pingTurn == this)
+    pingTurn = (pingNext != nullptr) ? pingNext : pingBegin;
+} // ~MTD2A_distance_input
+
+
+void MTD2A_distance_input::initialize (const uint8_t &setTriggerPin, const uint8_t &setEchoPin, const uint16_t &setThresholdMM, const uint16_t &setHysteresisMM, const bool &setPinNomalOrInverted) {
+  // Check for instantiated object error
+  delayTimeMS = check_set_time (delayTimeMS);
+  pinBlockMS  = check_set_time (pinBlockMS);
+  // Configuration block (MTD2A_globalConfig) overrides the arguments
+  thresholdMM  = (uint16_t)MTD2A_config_value (CONFIG_THRESHOLD,  setThresholdMM);
+  hysteresisMM = (uint16_t)MTD2A_config_value (CONFIG_HYSTERESIS, setHysteresisMM);
+  const uint8_t configPinNumber = (uint8_t)MTD2A_config_value (CONFIG_PIN_NUMBER, setEchoPin);
+  errorNumber = MTD2A_reserve_and_check_pin (setTriggerPin, DIGITAL_FLAG_0 | OUTPUT_FLAG_4);
+  if (errorNumber == 0)
+    errorNumber = MTD2A_reserve_and_check_pin (configPinNumber, DIGITAL_FLAG_0 | INPUT_FLAG_2);
+  if (errorNumber == 0)
+    errorNumber = MTD2A_attach_isr_slot (configPinNumber, this, isr_echo, isrSlot);
+  if (errorNumber == 0) {
+    pinReadToggl = ENABLE;
+    pinNumber  = configPinNumber;
+    triggerPin = setTriggerPin;
+    pinReadMode = (bool)MTD2A_config_value (CONFIG_PIN_MODE, setPinNomalOrInverted);
+    // Start inactive (no echo) until the first distance is compared
+    distanceState = HIGH;
+    pinType = INPUT;
+    pinMode(pinNumber, pinType);
+    pinMode(triggerPin, OUTPUT);
+    digitalWrite(triggerPin, LOW);
+  }
+  else {
+    print_error_text (errorNumber);
+    pinReadToggl = DISABLE;
+    pinNumber    = PIN_ERROR_NO;
+    triggerPin   = PIN_ERROR_NO;
+  }
+} // initialize
+
+
+void MTD2A_distance_input::set_threshold (const uint16_t &setThresholdMM, const uint16_t &setHysteresisMM) {
+  thresholdMM  = setThresholdMM;
+  hysteresisMM = setHysteresisMM;
+} // set_threshold
+
+
+//  Getters ----------------------------------------------------------------------------
+
+
+uint16_t const &MTD2A_distance_input::get_distanceMM () const {
+  return distanceMM;
+}
+
+
+uint32_t const &MTD2A_distance_input::get_echoTimeUS () const {
+  return echoTimeUS;
+}
+
+
+uint16_t const &MTD2A_distance_input::get_pingCount () const {
+  return pingCount;
+}
+
+
+uint16_t const &MTD2A_distance_input::get_echoLostCount () const {
+  return echoLostCount;
+}
+
+
+//  Private ----------------------------------------------------------------------------
+
+
+void MTD2A_ISR_ATTR MTD2A_distance_input::isr_echo (MTD2A *isrObject) {
+  MTD2A_distance_input *distance = static_cast<MTD2A_distance_input*>(isrObject);
+  const uint32_t edgeTimeUS = micros();
+  // Edges outside a ping (late echo after time out) are ignored
+  if (distance->echoWait == false)
+    return;
+  if (digitalRead(distance->pinNumber) == HIGH) {
+    distance->echoStartUS = edgeTimeUS;
+    distance->echoHigh    = true;
+  }
+  else if (distance->echoHigh == true) {
+    distance->echoWidthUS = edgeTimeUS - distance->echoStartUS;
+    distance->echoWait    = false;
+    distance->echoReady   = true;
+  }
+} // isr_echo
+
+
+bool MTD2A_distance_input::loop_fast_read () {
+  if (pingActive == true) {
+    if (echoReady == true) {
+      noInterrupts();
+      echoTimeUS = echoWidthUS;
+      interrupts();
+      // Speed of sound 343 m/s: 0.343 mm/us, both ways
+      const uint32_t echoDistanceMM = (echoTimeUS * 343 + 1000) / 2000;
+      if (echoDistanceMM > MAX_DISTANCE_MM) {
+        distanceMM = 0;
+        echoLostCount++;
+      }
+      else {
+        distanceMM = (uint16_t)echoDistanceMM;
+      }
+      ping_end ();
+    }
+    else if (globalSyncTimeMS - pingTimeMS >= ECHO_TIMEOUT_MS) {
+      echoTimeUS = 0;
+      distanceMM = 0;
+      echoLostCount++;
+      ping_end ();
+    }
+    else {
+      return distanceState;
+    }
+    // Comparator with hysteresis. Written without subtraction to avoid wrap around near 0
+    if (distanceMM == 0  ||  (uint32_t)distanceMM >= (uint32_t)thresholdMM + hysteresisMM)
+      distanceState = HIGH;
+    else if ((uint32_t)distanceMM + hysteresisMM <= thresholdMM)
+      distanceState = LOW;
+  }
+  else if (ping_turn () == true) {
+    ping_start ();
+  }
+  return distanceState;
+} // loop_fast_read
+
+
+bool MTD2A_distance_input::ping_turn () {
+  if (pingTurn == nullptr)
+    pingTurn = pingBegin;
+  // Skip sensors that do not read (not initialized, pin reading disabled or pin blocking time)
+  while (pingTurn != this  &&  pingTurn->pinReadToggl == DISABLE)
+    pingTurn = (pingTurn->pingNext != nullptr) ? pingTurn->pingNext : pingBegin;
+  return (pingTurn == this  &&  globalSyncTimeMS - pingEndMS >= PING_GAP_MS);
+} // ping_turn
+
+
+void MTD2A_distance_input::ping_start () {
+  echoHigh  = false;
+  echoReady = false;
+  echoWait  = true;
+  // HC-SR04 trigger: 10 us HIGH pulse. The ping starts after the falling edge
+  digitalWrite(triggerPin, HIGH);
+  delayMicroseconds(10);
+  digitalWrite(triggerPin, LOW);
+  pingActive = true;
+  pingTimeMS = globalSyncTimeMS;
+  pingCount++;
+} // ping_start
+
+
+void MTD2A_distance_input::ping_end () {
+  echoWait   = false;
+  pingActive = false;
+  pingEndMS  = globalSyncTimeMS;
+  if (pingTurn == this)
+    pingTurn = (pingNext != nullptr) ? pingNext : pingBegin;
+} // ping_end
+
+
+#if MTD2A_OBJECT_STATE > 0
+void MTD2A_distance_input::MTD2A_snapshot_state (MTD2A_snapshot_record &snapshotRecord) const {
+  // pinValue: distance in centimeters (0 - 255). timeMS as binary_input
+  MTD2A_binary_input::MTD2A_snapshot_state (snapshotRecord);
+  snapshotRecord.objectType = SNAPSHOT_DISTANCE;
+  snapshotRecord.pinValue   = (distanceMM / 10) > MAX_BYTE_VALUE ? MAX_BYTE_VALUE : (uint8_t)(distanceMM / 10);
+} // MTD2A_snapshot_state
+#endif
+
+
+#if MTD2A_CONFIG > 0
+bool MTD2A_distance_input::MTD2A_config_field (const uint8_t &fieldId, const uint32_t &fieldValue, const bool &applyField) {
+  // Values are validated by MTD2A_config_check ()
+  switch (fieldId) {
+    case CONFIG_THRESHOLD:  if (applyField) thresholdMM  = (uint16_t)fieldValue; return true;
+    case CONFIG_HYSTERESIS: if (applyField) hysteresisMM = (uint16_t)fieldValue; return true;
+  }
+  return MTD2A_binary_input::MTD2A_config_field (fieldId, fieldValue, applyField);
+} // MTD2A_config_field
+#endif
+
+
+void MTD2A_distance_input::print_conf () {
+#if MTD2A_LOG_LEVEL >= MTD2A_LOG_DEBUG
+  MTD2A_binary_input::print_conf ();
+  PortPrintln(F("MTD2A_distance_input: "));
+  PortPrint  (F("  triggerPin   : ")); PortPrintln(triggerPin);
+  PortPrint  (F("  thresholdMM  : ")); PortPrintln(thresholdMM);
+  PortPrint  (F("  hysteresisMM : ")); PortPrintln(hysteresisMM);
+  PortPrint  (F("  distanceMM   : ")); PortPrintln(distanceMM);
+  PortPrint  (F("  echoTimeUS   : ")); PortPrintln(echoTimeUS);
+  PortPrint  (F("  pingCount    : ")); PortPrintln(pingCount);
+  PortPrint  (F("  echoLostCount: ")); PortPrintln(echoLostCount);
+#endif
+} // print_conf
@@ -0,0 +1,188 @@
+/*
+ ******************************************************************************
+ * @file    MTD2A_distance_input.h
+ * @author  Joergen Bo Madsen
+ * @version 1.0.0
+ * @date    18. October 2026
+ * @brief   Non blocking ultrasonic distance input, HC-SR04 (binary_input state machine)
+ *
+ * Supporting a vast variety of input sensors and output devices
+ * Simple to use to build complex solutions
+ * Non blocking, simple, yet efficient event-driven state machine
+ * Comprehensive control, state and debug information
+ */
+
+
+
+#ifndef _MTD2A_distance_input_H_
+#define _MTD2A_distance_input_H_
+
+
+#include "Arduino.h"
+#include "MTD2A_base.h"
+#include "MTD2A_binary_input.h"
+
+
+// No pulseIn (). A 10 us trigger pulse starts the ping and the echo pin interrupt time stamps both echo edges.
+// Echo pin: External interrupt, or any pin change interrupt pin on AVR (MTD2A_attach_isr_slot).
+// Only one sensor pings at a time. The ping turn moves round robin (instantiation order) when the echo is received
+// or lost, after a PING_GAP_MS pause for remaining echoes to fade (no crosstalk between sensors).
+// Comparator (pin state) with hysteresis:
+//   LOW  (near) when distanceMM <= threshold - hysteresis
+//   HIGH (far)  when distanceMM >= threshold + hysteresis, or no echo
+// NORMAL: Near is active. INVERTED: Far is active. Phases, timers and counters are the binary_input ones.
+
+
+class MTD2A_distance_input: public MTD2A_binary_input
+{
+  private:
+    static constexpr uint32_t PING_GAP_MS     {30};    // Pause after echo before the next ping (any sensor)
+    static constexpr uint32_t ECHO_TIMEOUT_MS {40};    // HC-SR04 ends the echo pulse after about 38 ms without echo
+    static constexpr uint16_t MAX_DISTANCE_MM {4500};  // Longer echo times are no echo (out of range)
+
+    // Ping order linked list (round robin)
+    static MTD2A_distance_input *pingBegin;
+    static MTD2A_distance_input *pingTurn;   // Sensor allowed to ping
+    static uint32_t              pingEndMS;  // Last echo received or lost
+    MTD2A_distance_input *pingNext {nullptr};
+
+    // Arguments
+    uint8_t  triggerPin    {PIN_ERROR_NO};   // initialize () default argument
+    uint16_t thresholdMM   {100};            // initialize () and set_threshold () default argument
+    uint16_t hysteresisMM  {10};             // initialize () and set_threshold () default argument
+    // Ping and echo
+    bool     pingActive    {false};          // Ping sent, waiting for echo
+    uint32_t pingTimeMS    {0};              // Ping start time
+    volatile bool     echoWait    {false};   // ISR time stamps echo edges
+    volatile bool     echoHigh    {false};   // ISR echo rising edge seen
+    volatile bool     echoReady   {false};   // ISR echo falling edge seen
+    volatile uint32_t echoStartUS {0};       // ISR echo rising edge time
+    volatile uint32_t echoWidthUS {0};       // ISR echo pulse width
+    // State
+    uint16_t distanceMM    {0};              // get_distanceMM () 0 = no echo
+    uint32_t echoTimeUS    {0};              // get_echoTimeUS () Last echo pulse width. 0 = no echo
+    bool     distanceState {HIGH};           // Comparator state with hysteresis
+    uint16_t pingCount     {0};              // get_pingCount () Pings sent
+    uint16_t echoLostCount {0};              // get_echoLostCount () Pings without echo
+
+  public:
+    // Constructor initializers
+
+    /**
+     * @class MTD2A_distance_input
+     * @brief Create object and set configuration parameters or use defaults
+     * @param ( "Object Name", delayTimeMS, {FIRST_TRIGGER | LAST_TRIGGER}, {TIME_DELAY | MONO_STABLE}, pinBlocTimeMS );
+     * @param delayTimeMS & pinblockTimeMS {0 - 4294967295} milliseconds
+     * @return none
+     */
+    MTD2A_distance_input (
+      const char    *setObjectName  = "Object name",
+      const uint32_t setDelayTimeMS = 0,
+      const bool     setFirstOrLast = LAST_TRIGGER,
+      const bool     setTimeOrMono  = TIME_DELAY,
+      const uint32_t setPinBlockMS  = 0
+    );
+    // F("Object name") flash memory name (only legal inside functions). Names are not copied, see set_objectName ()
+    MTD2A_distance_input (
+      const __FlashStringHelper *setObjectName,
+      const uint32_t setDelayTimeMS = 0,
+      const bool     setFirstOrLast = LAST_TRIGGER,
+      const bool     setTimeOrMono  = TIME_DELAY,
+      const uint32_t setPinBlockMS  = 0
+    );
+
+    // Destructor (globalObjectCount is decremented by ~MTD2A_binary_input)
+    ~MTD2A_distance_input ();
+
+  public: // Functions
+    /**
+     * @brief Initalize trigger and echo pin, distance threshold and hysteresis. If illigal pin configuration, pin reading is disabled!
+     * @name object_name.initialize
+     * @param ( trigger pin, echo pin {interrupt pin}, thresholdMM {0 - 65535}, hysteresisMM {0 - 65535}, {NORMAL | INVERTED} );
+     * @return none
+     */
+    void initialize (const uint8_t &setTriggerPin = PIN_ERROR_NO, const uint8_t &setEchoPin = PIN_ERROR_NO, const uint16_t &setThresholdMM = 100, const uint16_t &setHysteresisMM = 10, const bool &setPinNomalOrInverted = NORMAL);
+
+
+    /*
+     * @brief print configuration parameters, timers and state logic.
+     * @name object_name.print_conf ();
+     * @param none
+     * @return none
+     */
+    void print_conf ();
+
+
+    // Setters -----------------------------------------------
+
+
+    /**
+     * @brief Set distance threshold and hysteresis. Near (LOW) at threshold - hysteresis and far (HIGH) at threshold + hysteresis.
+     * @name object_name.set_threshold
+     * @param ( thresholdMM {0 - 65535}, hysteresisMM {0 - 65535} );
+     * @return none
+     */
+    void set_threshold (const uint16_t &setThresholdMM, const uint16_t &setHysteresisMM = 10);
+
+
+    // Getters -----------------------------------------------
+
+
+    /**
+     * @brief Get last measured distance
+     * @name object_name.get_distanceMM ();
+     * @param none
+     * @return uint16_t millimeters. 0 = no echo (out of range)
+     */
+    uint16_t const &get_distanceMM () const;
+
+
+    /**
+     * @brief Get last echo pulse width
+     * @name object_name.get_echoTimeUS ();
+     * @param none
+     * @return uint32_t Microseconds. 0 = no echo
+     */
+    uint32_t const &get_echoTimeUS () const;
+
+
+    /**
+     * @brief Get number of pings sent (uint16_t wrap around)
+     * @name object_name.get_pingCount ();
+     * @param none
+     * @return uint16_t count
+     */
+    uint16_t const &get_pingCount () const;
+
+
+    /**
+     * @brief Get number of pings without echo (uint16_t wrap around)
+     * @name object_name.get_echoLostCount ();
+     * @param none
+     * @return uint16_t count
+     */
+    uint16_t const &get_echoLostCount () const;
+
+
+  private: // Functions
+
+    // The echo pin is time stamped by the distance ISR. Pin change polling and edge timing do not apply
+    using MTD2A_binary_input::set_pinInterrupt;
+    using MTD2A_binary_input::set_microTiming;
+
+    bool     loop_fast_read () override;
+    bool     ping_turn ();
+    void     ping_start ();
+    void     ping_end ();
+#if MTD2A_OBJECT_STATE > 0
+    void     MTD2A_snapshot_state (MTD2A_snapshot_record &snapshotRecord) const override;
+#endif
+#if MTD2A_CONFIG > 0
+    bool     MTD2A_config_field   (const uint8_t &fieldId, const uint32_t &fieldValue, const bool &applyField) override;
+#endif
+    static void isr_echo (MTD2A *isrObject);
+
+}; // class MTD2A_distance_input
+
+
+#endif
@@ -0,0 +1,466 @@
+/**
+ ******************************************************************************
+ * @file    MTD2A_encoder_input.cpp
+ * @author  Joergen Bo Madsen
+ * @version 1.0.0
+ * @date    18. October 2026
+ * @brief   functions for MTD2A_encoder_input.h (Model Train Detection And Action)
+ *
+ * Supporting a vast variety of input sensors and output devices
+ * Simple to use to build complex solutions
+ * Non blocking, simple, yet efficient event-driven state machine
+ * Comprehensive control, state and debug information
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Open source free for all</center></h2>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ ******************************************************************************
+ */
+
+
+#include "Arduino.h"
+#include "MTD2A_base.h"
+#include "MTD2A_binary_output.h"
+#include "MTD2A_encoder_input.h"
+
+
+// Specific global constants from MTD2A_encoder_input.h (MTD2A_const.h)
+constexpr uint8_t  MTD2A_encoder_input::NO_DIRECTION;
+constexpr uint8_t  MTD2A_encoder_input::CLOCKWISE;
+constexpr uint8_t  MTD2A_encoder_input::COUNTER_CLOCKWISE;
+constexpr bool     MTD2A_encoder_input::P_W_M;
+// Phases
+constexpr uint8_t  MTD2A_encoder_input::RESET_PHASE;
+constexpr uint8_t  MTD2A_encoder_input::TURN_PHASE;
+constexpr uint8_t  MTD2A_encoder_input::COMPLETE_PHASE;
+// PWM curves
+constexpr uint8_t  MTD2A_encoder_input::NO_CURVE;
+constexpr uint8_t  MTD2A_encoder_input::RISING_XY;
+// MTD2A_base
+constexpr uint8_t  MTD2A_encoder_input::NO_PRINT_PIN;
+constexpr uint8_t  MTD2A_encoder_input::MAX_PWM_CURVES;
+// Quadrature decoder
+constexpr int8_t   MTD2A_encoder_input::QUAD_INVALID;
+constexpr int8_t   MTD2A_encoder_input::QUAD_TABLE[16];
+constexpr uint32_t MTD2A_encoder_input::VELOCITY_TIME_MS;
+
+
+// Constructor
+MTD2A_encoder_input::MTD2A_encoder_input
+  (const char *setObjectName, const uint32_t setIdleTimeMS)
+  : idleTimeMS {setIdleTimeMS},
+    // Instatiated funtion pointer
+    MTD2A{[](MTD2A* funcPtr) { static_cast<MTD2A_encoder_input*>(funcPtr)->loop_fast(); }}
+  {
+    MTD2A_add_function_pointer_loop_fast(this);
+    MTD2A_set_object_name(setObjectName);
+  }
+// MTD2A_encoder_input
+
+
+// Constructor F("Object name")
+MTD2A_encoder_input::MTD2A_encoder_input
+  (const __FlashStringHelper *setObjectName, const uint32_t setIdleTimeMS)
+  : MTD2A_encoder_input ((const char *)nullptr, setIdleTimeMS)
+  {
+    MTD2A_set_object_name(setObjectName);
+  }
+// MTD2A_encoder_input
+
+
+// Destructor
+MTD2A_encoder_input::~MTD2A_encoder_input () {
+  if (isrSlotA != PIN_ERROR_NO)
+    MTD2A_detach_isr_slot (pinNumberA, isrSlotA);
+  if (isrSlotB != PIN_ERROR_NO)
+    MTD2A_detach_isr_slot (pinNumberB, isrSlotB);
+  if (globalObjectCount > 0 )
+    globalObjectCount--;
+} // ~MTD2A_encoder_input
+
+
+void MTD2A_encoder_input::initialize (const uint8_t &setPinNumberA, const uint8_t &setPinNumberB, const uint8_t &setStepsPerDetent, const uint8_t &setPinPullupOrInput) {
+  // Configuration block (MTD2A_globalConfig) overrides the arguments
+  idleTimeMS = MTD2A_config_value (CONFIG_TIME_OUT, idleTimeMS);
+  const uint8_t configPinNumber = (uint8_t)MTD2A_config_value (CONFIG_PIN_NUMBER, setPinNumberA);
+  reset ();
+  if (setStepsPerDetent == 1  ||  setStepsPerDetent == 2  ||  setStepsPerDetent == 4)
+    stepsPerDetent = setStepsPerDetent;
+  else {
+    print_error_text (180);
+    stepsPerDetent = 4;
+  }
+  if (setPinPullupOrInput == (uint8_t)INPUT  ||  setPinPullupOrInput == (uint8_t)INPUT_PULLUP)
+    pinType = setPinPullupOrInput;
+  else {
+    print_error_text (8);
+    pinType = INPUT_PULLUP;
+  }
+  errorNumber = MTD2A_reserve_and_check_pin (configPinNumber, DIGITAL_FLAG_0 | INPUT_FLAG_2 | PULLUP_FLAG_3);
+  if (errorNumber == 0)
+    errorNumber = MTD2A_reserve_and_check_pin (setPinNumberB, DIGITAL_FLAG_0 | INPUT_FLAG_2 | PULLUP_FLAG_3);
+  if (errorNumber == 0) {
+    pinNumberA = configPinNumber;
+    pinNumberB = setPinNumberB;
+    pinMode(pinNumberA, pinType);
+    pinMode(pinNumberB, pinType);
+    // Start state before the first edge
+    quadState = (uint8_t)((digitalRead(pinNumberA) << 1) | digitalRead(pinNumberB));
+    errorNumber = MTD2A_attach_isr_slot (pinNumberA, this, isr_step, isrSlotA);
+  }
+  if (errorNumber == 0)
+    errorNumber = MTD2A_attach_isr_slot (pinNumberB, this, isr_step, isrSlotB);
+  if (errorNumber != 0) {
+    print_error_text (errorNumber);
+    if (isrSlotA != PIN_ERROR_NO)
+      MTD2A_detach_isr_slot (pinNumberA, isrSlotA);
+    pinNumberA = PIN_ERROR_NO;
+    pinNumberB = PIN_ERROR_NO;
+  }
+} // initialize
+
+
+void MTD2A_encoder_input::reset () {
+  noInterrupts();
+  stepCount = 0;
+  interrupts();
+  position       = 0;
+  stepRemainder  = 0;
+  direction      = NO_DIRECTION;
+  velocity       = 0;
+  velocitySteps  = 0;
+  velocityTimeMS = globalSyncTimeMS;
+  lastMoveMS     = globalSyncTimeMS;
+  errorNumber    = 0;
+  processState   = COMPLETE;
+  phaseChange    = true;
+  phaseNumber    = RESET_PHASE;
+  limit_position ();
+  targetWrite    = true;
+  write_target ();
+  print_phase_line ();
+} // reset
+
+
+// Setters -------------------------------------------------------------
+
+
+void MTD2A_encoder_input::set_range (const int32_t &setMinPosition, const int32_t &setMaxPosition) {
+  if (setMinPosition >= setMaxPosition) {
+    print_error_text (181);
+  }
+  else {
+    rangeEnable = ENABLE;
+    minPosition = setMinPosition;
+    maxPosition = setMaxPosition;
+    limit_position ();
+    targetWrite = true;
+    write_target ();
+  }
+} // set_range
+
+
+void MTD2A_encoder_input::set_position (const int32_t &setPosition) {
+  position      = setPosition;
+  stepRemainder = 0;
+  limit_position ();
+  write_target ();
+} // set_position
+
+
+void MTD2A_encoder_input::set_target (MTD2A_binary_output &setTargetOutput, const uint8_t &setPWMcurveType, const uint8_t &setLowValue, const uint8_t &setHighValue) {
+  if (rangeEnable == DISABLE)
+    print_error_text (182);
+  if (setPWMcurveType > MAX_PWM_CURVES) {
+    print_error_text (153);
+    targetCurve = NO_CURVE;
+  }
+  else {
+    targetCurve = setPWMcurveType;
+  }
+  targetOutput = &setTargetOutput;
+  targetLow    = setLowValue;
+  targetHigh   = setHighValue;
+  targetWrite  = true;
+  write_target ();
+} // set_target
+
+
+void MTD2A_encoder_input::set_idleTimeMS (const uint32_t &setIdleTimeMS) {
+  idleTimeMS = setIdleTimeMS;
+} // set_idleTimeMS
+
+
+void MTD2A_encoder_input::set_debugPrint (const bool &setEnableOrDisable) {
+  debugPrint = setEnableOrDisable;
+} // set_debugPrint
+
+
+void MTD2A_encoder_input::set_errorPrint (const bool &setEnableOrDisable) {
+  errorPrint = setEnableOrDisable;
+} // set_errorPrint
+
+
+// getters -------------------------------------------------------------
+
+
+int32_t const &MTD2A_encoder_input::get_position () const {
+  return position;
+}
+
+
+int32_t const &MTD2A_encoder_input::get_velocity () const {
+  return velocity;
+}
+
+
+uint8_t const &MTD2A_encoder_input::get_direction () const {
+  return direction;
+}
+
+
+uint16_t MTD2A_encoder_input::get_lostStepCount () const {
+  noInterrupts();
+  const uint16_t tempLostStepCount = lostStepCount;
+  interrupts();
+  return tempLostStepCount;
+} // get_lostStepCount
+
+
+bool const &MTD2A_encoder_input::get_processState () const {
+  return processState;
+}
+
+
+bool const &MTD2A_encoder_input::get_phaseChange () const {
+  return phaseChange;
+}
+
+
+uint8_t const &MTD2A_encoder_input::get_phaseNumber () const {
+  return phaseNumber;
+}
+
+
+uint8_t const MTD2A_encoder_input::get_reset_error () {
+  uint8_t tempErrorNumber = errorNumber;
+  errorNumber = 0;
+  return tempErrorNumber;
+} // get_reset_error
+
+
+// Internal -------------------------------------------------------------
+
+
+void MTD2A_ISR_ATTR MTD2A_encoder_input::isr_step (MTD2A *isrObject) {
+  MTD2A_encoder_input *encoder = static_cast<MTD2A_encoder_input*>(isrObject);
+  // Transition index: previous A/B (bit 3-2) and new A/B (bit 1-0)
+  const uint8_t pinState  = (uint8_t)((digitalRead(encoder->pinNumberA) << 1) | digitalRead(encoder->pinNumberB));
+  const uint8_t quadIndex = (uint8_t)(((encoder->quadState << 2) | pinState) & 0x0F);
+  encoder->quadState = pinState;
+  const int8_t quadStep = QUAD_TABLE[quadIndex];
+  if (quadStep == QUAD_INVALID)
+    encoder->lostStepCount++;
+  else
+    encoder->stepCount += quadStep;
+} // isr_step
+
+
+void MTD2A_encoder_input::loop_fast () {
+  phaseChange = false;
+  if (pinNumberA == PIN_ERROR_NO)
+    return;
+  noInterrupts();
+  const int16_t stepDelta = stepCount;
+  stepCount = 0;
+  interrupts();
+  //
+  if (stepDelta != 0) {
+    // Whole detents. The remainder keeps its sign and waits for the rest of the detent
+    const int32_t stepSum = (int32_t)stepRemainder + stepDelta;
+    const int32_t moveDetents = stepSum / stepsPerDetent;
+    stepRemainder  = (int8_t)(stepSum - moveDetents * stepsPerDetent);
+    velocitySteps += stepDelta;
+    if (moveDetents != 0)
+      move_position (moveDetents);
+  }
+  if (globalSyncTimeMS - velocityTimeMS >= VELOCITY_TIME_MS) {
+    velocity       = (velocitySteps * 1000) / (int32_t)((globalSyncTimeMS - velocityTimeMS) * stepsPerDetent);
+    velocitySteps  = 0;
+    velocityTimeMS = globalSyncTimeMS;
+  }
+  if (processState == ACTIVE  &&  globalSyncTimeMS - lastMoveMS >= idleTimeMS)
+    complete_state ();
+} // loop_fast
+
+
+void MTD2A_encoder_input::move_position (const int32_t &moveDetents) {
+  direction  = (moveDetents > 0) ? CLOCKWISE : COUNTER_CLOCKWISE;
+  position  += moveDetents;
+  lastMoveMS = globalSyncTimeMS;
+  limit_position ();
+  write_target ();
+  if (processState == COMPLETE)
+    turn_state ();
+} // move_position
+
+
+void MTD2A_encoder_input::limit_position () {
+  if (rangeEnable == ENABLE) {
+    if (position < minPosition)
+      position = minPosition;
+    else if (position > maxPosition)
+      position = maxPosition;
+  }
+} // limit_position
+
+
+void MTD2A_encoder_input::write_target () {
+  if (targetOutput == nullptr  ||  rangeEnable == DISABLE)
+    return;
+  // Position range to curve x {0 - 255}, curve y {0 - 255} to lowValue - highValue
+  const uint8_t curvePointX = (uint8_t)(((double)position - (double)minPosition) * MAX_BYTE_VALUE / ((double)maxPosition - (double)minPosition) + 0.5);
+  double curvePointY = curvePointX;
+  if (targetCurve != NO_CURVE)
+    curvePointY = targetOutput->PWM_curve_y (curvePointX, targetCurve);
+  int16_t scalePointY = (int16_t)targetLow + (int16_t)round(curvePointY * ((double)targetHigh - (double)targetLow) / MAX_BYTE_VALUE);
+  if (scalePointY < 0)
+    scalePointY = 0;
+  else if (scalePointY > MAX_BYTE_VALUE)
+    scalePointY = MAX_BYTE_VALUE;
+  if (targetWrite == true  ||  (uint8_t)scalePointY != targetValue) {
+    targetWrite = false;
+    targetValue = (uint8_t)scalePointY;
+    targetOutput->set_pinWriteValue (targetValue, P_W_M);
+  }
+} // write_target
+
+
+void MTD2A_encoder_input::turn_state () {
+  processState = ACTIVE;
+  phaseChange  = true;
+  phaseNumber  = TURN_PHASE;
+  print_phase_line ();
+} // turn_state
+
+
+void MTD2A_encoder_input::complete_state () {
+  phaseChange  = true;
+  processState = COMPLETE;
+  phaseNumber  = COMPLETE_PHASE;
+  print_phase_line ();
+} // complete_state
+
+
+#if MTD2A_OBJECT_STATE > 0
+void MTD2A_encoder_input::MTD2A_snapshot_state (MTD2A_snapshot_record &snapshotRecord) const {
+  // pinValue: Position (low byte). timeMS: Time of the last detent (globalSyncTimeMS)
+  snapshotRecord.objectType  = SNAPSHOT_ENCODER;
+  snapshotRecord.phaseNumber = phaseNumber;
+  snapshotRecord.stateFlags  = (uint8_t)(processState | (phaseChange << 1));
+  snapshotRecord.errorNumber = errorNumber;
+  snapshotRecord.pinNumber   = pinNumberA;
+  snapshotRecord.pinValue    = (uint8_t)position;
+  snapshotRecord.timeMS      = lastMoveMS;
+} // MTD2A_snapshot_state
+#endif
+
+
+bool MTD2A_encoder_input::MTD2A_link_action (const uint8_t &linkAction, const uint8_t &actionValue, const bool &executeAction) {
+  (void)actionValue;
+  switch (linkAction) {
+    case LINK_RESET:    if (executeAction) reset (); return true;
+  }
+  return false;
+} // MTD2A_link_action
+
+
+#if MTD2A_CONFIG > 0
+bool MTD2A_encoder_input::MTD2A_config_field (const uint8_t &fieldId, const uint32_t &fieldValue, const bool &applyField) {
+  // Values are validated by MTD2A_config_check (). CONFIG_PIN_NUMBER (pin A) is used by initialize ()
+  switch (fieldId) {
+    case CONFIG_PIN_NUMBER:                                   return true;
+    case CONFIG_TIME_OUT:   if (applyField) idleTimeMS = fieldValue; return true;
+  }
+  return false;
+} // MTD2A_config_field
+#endif
+
+
+void MTD2A_encoder_input::print_phase_line () {
+  MTD2A_trace_phase (phaseNumber);
+#if MTD2A_LOG_LEVEL >= MTD2A_LOG_DEBUG
+  if (globalTraceMode == TRACE_OFF  &&  (debugPrint == ENABLE  ||  globalDebugPrint == ENABLE)) {
+    MTD2A_print_object_name ();
+    PortPrint(F(" "));
+    print_phase_text ();
+    switch (phaseNumber) {
+      case TURN_PHASE:
+        if (direction == CLOCKWISE) PortPrint(F(" > Clockwise")); else PortPrint(F(" > Counter clockwise"));
+      break;
+      case COMPLETE_PHASE:
+        PortPrint(F(" > ")); PortPrint(position);
+      break;
+    }
+    PortPrintln();
+  }
+#endif
+} // print_phase_line
+
+
+void MTD2A_encoder_input::print_phase_text () {
+#if MTD2A_LOG_LEVEL >= MTD2A_LOG_DEBUG
+  switch(phaseNumber) {
+    case 0: PortPrint(F("[0] Reset"));     break;
+    case 1: PortPrint(F("[1] Turn"));      break;
+    case 4: PortPrint(F("[4] Complete"));  break;
+  }
+#endif
+} // print_phase_text
+
+
+void MTD2A_encoder_input::print_error_text (const uint8_t setErrorNumber) {
+  errorNumber = setErrorNumber;
+  MTD2A_trace_phase (phaseNumber, errorNumber);
+  if (globalTraceMode == TRACE_OFF) {
+    MTD2A_print_object_name ();
+    MTD2A_print_error_text ((debugPrint == ENABLE || errorPrint == ENABLE), errorNumber, NO_PRINT_PIN);
+  }
+} // print_error_text
+
+
+void MTD2A_encoder_input::print_conf () {
+#if MTD2A_LOG_LEVEL >= MTD2A_LOG_DEBUG
+  PortPrintln(F("MTD2A_encoder_input: "));
+  MTD2A_print_name_state (processState);
+  PortPrint  (F("  phaseText    : ")); print_phase_text (); PortPrintln();
+  MTD2A_print_debug_error (debugPrint, errorPrint, errorNumber);
+  // Setup
+  PortPrint  (F("  pinNumberA   : ")); PortPrintln(pinNumberA);
+  PortPrint  (F("  pinNumberB   : ")); PortPrintln(pinNumberB);
+  PortPrint  (F("  stepsDetent  : ")); PortPrintln(stepsPerDetent);
+  PortPrint  (F("  idleTimeMS   : ")); PortPrintln(idleTimeMS);
+  PortPrint  (F("  range        : ")); MTD2A_print_enable_disable (rangeEnable);
+  PortPrint  (F("  minPosition  : ")); PortPrintln(minPosition);
+  PortPrint  (F("  maxPosition  : ")); PortPrintln(maxPosition);
+  PortPrint  (F("  target       : ")); MTD2A_print_enable_disable (targetOutput != nullptr);
+  PortPrint  (F("  targetValue  : ")); PortPrintln(targetValue);
+  // Measurements
+  PortPrint  (F("  position     : ")); PortPrintln(position);
+  PortPrint  (F("  velocity     : ")); PortPrintln(velocity);
+  PortPrint  (F("  direction    : ")); PortPrintln(direction);
+  PortPrint  (F("  lostSteps    : ")); PortPrintln(get_lostStepCount ());
+#endif
+} // print_conf
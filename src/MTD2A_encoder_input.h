@@ -0,0 +1,321 @@
+/*
+ ******************************************************************************
+ * @file    MTD2A_encoder_input.h
+ * @author  Joergen Bo Madsen
+ * @version 1.0.0
+ * @date    18. October 2026
+ * @brief   Quadrature (incremental) rotary encoder input. Position, velocity and direction
+ *
+ * Supporting a vast variety of input sensors and output devices
+ * Simple to use to build complex solutions
+ * Non blocking, simple, yet efficient event-driven state machine
+ * Comprehensive control, state and debug information
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Open source free for all</center></h2>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ ******************************************************************************
+ */
+
+
+#ifndef _MTD2A_encoder_input_H_
+#define _MTD2A_encoder_input_H_
+
+
+#include "Arduino.h"
+#include "MTD2A_base.h"
+#include "MTD2A_binary_output.h"
+
+
+// Both encoder pins interrupt on change (MTD2A_attach_isr_slot: external interrupt, or pin change interrupt on AVR).
+// The ISR looks up the previous and new A/B state in a 16 entry transition table: +1, -1, 0 (bounce) or invalid (lost step).
+// No steps are lost between loops, no matter how fast the knob is turned. MTD2A_loop_execute () converts steps to detents.
+// Position: detents, limited by set_range (). Velocity: detents per second (signed), measured every VELOCITY_TIME_MS.
+// TURN_PHASE while turning and COMPLETE_PHASE after idle time without a detent. Phases can be linked (set_link).
+// set_target (): The position range is mapped through a PWM curve to a MTD2A_binary_output (set_pinWriteValue P_W_M).
+
+
+class MTD2A_encoder_input: public MTD2A
+{
+  private:
+    // Specific global constants from MTD2A_encoder_input.h (MTD2A_const.h)
+    static constexpr uint8_t  NO_DIRECTION      {MTD2A_const::NO_DIRECTION};
+    static constexpr uint8_t  CLOCKWISE         {MTD2A_const::CLOCKWISE};
+    static constexpr uint8_t  COUNTER_CLOCKWISE {MTD2A_const::COUNTER_CLOCKWISE};
+    static constexpr bool     P_W_M             {MTD2A_const::P_W_M};
+    // Phases
+    static constexpr uint8_t  RESET_PHASE       {MTD2A_const::RESET_PHASE};
+    static constexpr uint8_t  TURN_PHASE        {MTD2A_const::TURN_PHASE};
+    static constexpr uint8_t  COMPLETE_PHASE    {MTD2A_const::COMPLETE_PHASE};
+    // PWM curves
+    static constexpr uint8_t  NO_CURVE          {MTD2A_const::NO_CURVE};
+    static constexpr uint8_t  RISING_XY         {MTD2A_const::RISING_XY};
+    // MTD2A_base
+    static constexpr uint8_t  NO_PRINT_PIN      {MTD2A::NO_PRINT_PIN};
+    static constexpr uint8_t  MAX_PWM_CURVES    {MTD2A::MAX_PWM_CURVES};
+    // Quadrature decoder
+    static constexpr int8_t   QUAD_INVALID      {2};     // Both pins changed (one transition lost)
+    static constexpr int8_t   QUAD_TABLE[16]    {0, -1, 1, QUAD_INVALID, 1, 0, QUAD_INVALID, -1, -1, QUAD_INVALID, 0, 1, QUAD_INVALID, 1, -1, 0};
+    static constexpr uint32_t VELOCITY_TIME_MS  {100};   // Velocity measurement window
+
+    // Arguments
+    uint8_t  pinNumberA     {PIN_ERROR_NO};   // initialize () default argument
+    uint8_t  pinNumberB     {PIN_ERROR_NO};   // initialize () default argument
+    uint8_t  pinType        {INPUT_PULLUP};   // initialize () default argument
+    uint8_t  stepsPerDetent {4};              // initialize () default argument {1, 2, 4}
+    uint32_t idleTimeMS     {500};            // Constructor default argument. No detent for idleTimeMS = COMPLETE_PHASE
+    // Range
+    bool     rangeEnable    {DISABLE};        // set_range ()
+    int32_t  minPosition    {0};              // set_range ()
+    int32_t  maxPosition    {0};              // set_range ()
+    // ISR quadrature decoder
+    uint8_t           isrSlotA      {PIN_ERROR_NO};   // External or pin change interrupt slot
+    uint8_t           isrSlotB      {PIN_ERROR_NO};
+    volatile uint8_t  quadState     {0};      // Previous (bit 3-2) and current (bit 1-0) A/B state
+    volatile int16_t  stepCount     {0};      // Steps since last loop
+    volatile uint16_t lostStepCount {0};      // get_lostStepCount () Invalid transitions (uint16_t wrap around)
+    // Measurements
+    int32_t  position       {0};              // get_position () Detents
+    int8_t   stepRemainder  {0};              // Steps not yet a detent
+    uint8_t  direction      {NO_DIRECTION};   // get_direction () Last detent CLOCKWISE / COUNTER_CLOCKWISE
+    int32_t  velocity       {0};              // get_velocity () Detents per second (negative = COUNTER_CLOCKWISE)
+    int32_t  velocitySteps  {0};              // Steps in the velocity window
+    uint32_t velocityTimeMS {0};              // Velocity window start
+    uint32_t lastMoveMS     {0};              // Last detent
+    // Target output
+    MTD2A_binary_output *targetOutput {nullptr}; // set_target ()
+    uint8_t  targetCurve    {RISING_XY};      // set_target () PWM curve
+    uint8_t  targetLow      {0};              // set_target () P_W_M value at minimum position
+    uint8_t  targetHigh     {MAX_BYTE_VALUE}; // set_target () P_W_M value at maximum position
+    uint8_t  targetValue    {0};              // Last written P_W_M value
+    bool     targetWrite    {false};          // Write target even if the value is unchanged
+    // Debug and error
+    bool     debugPrint     {DISABLE};        // set_debugPrint  () default argument / ENABLE
+    bool     errorPrint     {DISABLE};        // set_errorPrint  () default argument / ENABLE
+    uint8_t  errorNumber    {0};              // get_reset_error () Error {1-127} and Warning {128-255}
+    // State control
+    bool     processState   {COMPLETE};       // get_processState () / ACTIVE
+    bool     phaseChange    {false};          // true = change in phase state (one loop)
+    uint8_t  phaseNumber    {COMPLETE_PHASE}; // Reset = 0, Turn = 1, Complete = 4
+
+  public:
+    // Constructor inittializers
+    /**
+     * @class MTD2A_encoder_input
+     * @brief Create object and set configuration parameter or use defaults
+     * @param ( "Object Name", idleTimeMS {0 - 4294967295} );
+     * @return none
+     */
+    MTD2A_encoder_input (
+      const char    *setObjectName = "Object name",
+      const uint32_t setIdleTimeMS = 500
+    );
+    // F("Object name") flash memory name (only legal inside functions). Names are not copied, see set_objectName ()
+    MTD2A_encoder_input (
+      const __FlashStringHelper *setObjectName,
+      const uint32_t setIdleTimeMS = 500
+    );
+
+    // Destructor
+    ~MTD2A_encoder_input ();
+
+    public: // Functions
+
+    /**
+     * @brief Initialize encoder pins A and B (interrupt pins) and steps per detent. If illigal pin configuration, the encoder is disabled!
+     * @brief Steps per detent: 4 = full cycle per detent (KY-040, EC11), 2 = half cycle, 1 = no detents (every edge counts)
+     * @name object_name.initialize
+     * @param ( pin A, pin B, stepsPerDetent {1 | 2 | 4}, {INPUT | INPUT_PULLUP} );
+     * @return none
+     */
+    void initialize (const uint8_t &setPinNumberA = PIN_ERROR_NO, const uint8_t &setPinNumberB = PIN_ERROR_NO, const uint8_t &setStepsPerDetent = 4, const uint8_t &setPinPullupOrInput = INPUT_PULLUP);
+
+
+    /**
+     * @brief Reset position (0, or range minimum), velocity, direction and state logic. Ready to start.
+     * @name object_name.reset ();
+     * @param none
+     * @return none
+     */
+    void reset ();
+
+
+    /**
+     * @brief print configuration parameters, measurements and state logic.
+     * @name object_name.print_conf ();
+     * @param none
+     * @return none
+     */
+    void print_conf ();
+
+    // setters -------------------------------------------------------------
+
+
+    /**
+     * @brief Limit position to a range. Turning beyond the limits is ignored (no wrap around).
+     * @name object_name.set_range
+     * @param ( minPosition, maxPosition ); Detents {-2147483648 - 2147483647}. minPosition < maxPosition
+     * @return none
+     */
+    void set_range (const int32_t &setMinPosition, const int32_t &setMaxPosition);
+
+
+    /**
+     * @brief Set position (limited to range). The target output is updated
+     * @name object_name.set_position
+     * @param ( position ); Detents
+     * @return none
+     */
+    void set_position (const int32_t &setPosition);
+
+
+    /**
+     * @brief Map the position range through a PWM curve to a binary_output (P_W_M). Requires set_range ()
+     * @brief Minimum position = lowValue and maximum position = highValue. Written on every change
+     * @name object_name.set_target
+     * @param ( binary_output_object, PWM curve {NO_CURVE | RISING_XY | ... | FALLING_LED}, lowValue {0 - 255}, highValue {0 - 255} );
+     * @return none
+     */
+    void set_target (MTD2A_binary_output &setTargetOutput, const uint8_t &setPWMcurveType = RISING_XY, const uint8_t &setLowValue = 0, const uint8_t &setHighValue = MAX_BYTE_VALUE);
+
+
+    /**
+     * @brief Set time without detent before COMPLETE_PHASE
+     * @name object_name.set_idleTimeMS
+     * @param ( {0 - 4294967295} ); Milliseconds
+     * @return none
+     */
+    void set_idleTimeMS (const uint32_t &setIdleTimeMS);
+
+
+    /**
+     * @brief Enable print phase state number, phase state text and error text.
+     * @name object_name.set_debugPrint
+     * @param ( {ENABLE | DISABLE} );
+     * @return none
+     */
+    void set_debugPrint (const bool &setEnableOrDisable = ENABLE);
+
+
+    /**
+     * @brief Enable error print text.
+     * @name object_name.set_errorPrint
+     * @param ( {ENABLE | DISABLE} );
+     * @return none
+     */
+    void set_errorPrint (const bool &setEnableOrDisable = ENABLE);
+
+
+    // getters -------------------------------------------------------------
+
+
+    /**
+     * @brief Get position
+     * @name object_name.get_position ();
+     * @param none
+     * @return int32_t Detents
+     */
+    int32_t const &get_position () const;
+
+
+    /**
+     * @brief Get velocity, updated every 100 milliseconds
+     * @name object_name.get_velocity ();
+     * @param none
+     * @return int32_t Detents per second. Positive = CLOCKWISE, negative = COUNTER_CLOCKWISE
+     */
+    int32_t const &get_velocity () const;
+
+
+    /**
+     * @brief Get direction of the last detent
+     * @name object_name.get_direction ();
+     * @param none
+     * @return uint8_t NO_DIRECTION = 0, CLOCKWISE = 1, COUNTER_CLOCKWISE = 2
+     */
+    uint8_t const &get_direction () const;
+
+
+    /**
+     * @brief Get number of invalid transitions (both pins changed between two interrupts). Turned too fast or pin noise
+     * @name object_name.get_lostStepCount ();
+     * @param none
+     * @return uint16_t count (wrap around)
+     */
+    uint16_t get_lostStepCount () const;
+
+
+    /**
+     * @brief Get processState
+     * @name object_name.get_processState ();
+     * @param none
+     * @return bool {ACTIVE | COMPLETE}
+     */
+    bool const &get_processState () const;
+
+
+    /**
+     * @brief get phaseChange
+     * @name object_name.get_phaseChange ();
+     * @param none
+     * @return bool {true | false}
+     */
+    bool const &get_phaseChange () const;
+
+
+    /**
+     * @brief get phase number.
+     * @name object_name.get_phaseNumber ();
+     * @param none
+     * @return uint8_t RESET_PHASE = 0, TURN_PHASE = 1, COMPLETE_PHASE = 4
+     */
+    uint8_t const &get_phaseNumber () const;
+
+
+    /**
+     * @brief Get and reset error number to zero
+     * @name object_name.get_reset_error ();
+     * @param none
+     * @return uint8_t Error number. Error {1-127} and Warning {128-255}
+     */
+    uint8_t const get_reset_error ();
+
+
+  private: // Internal functions
+
+    // Execute
+    void     loop_fast          ();
+    void     move_position      (const int32_t &moveDetents);
+    void     limit_position     ();
+    void     write_target       ();
+    void     turn_state         ();
+    void     complete_state     ();
+#if MTD2A_OBJECT_STATE > 0
+    void     MTD2A_snapshot_state (MTD2A_snapshot_record &snapshotRecord) const override;
+#endif
+    bool     MTD2A_link_action    (const uint8_t &linkAction, const uint8_t &actionValue, const bool &executeAction) override;
+#if MTD2A_CONFIG > 0
+    bool     MTD2A_config_field   (const uint8_t &fieldId, const uint32_t &fieldValue, const bool &applyField) override;
+#endif
+    static void isr_step (MTD2A *isrObject);
+    // print
+    void     print_phase_line   ();
+    void     print_phase_text   ();
+    void     print_error_text   (const uint8_t setErrorNumber);
+
+};  // MTD2A_encoder_input
+
+
+#endif
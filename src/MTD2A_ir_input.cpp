@@ -0,0 +1,164 @@
+/*
+ ******************************************************************************
+ * @file    MTD2A_ir_input.cpp
+ * @author  Joergen Bo Madsen
+ * @version 1.0.0
+ * @date    18. October 2026
+ * @brief   functions for MTD2A_ir_input.h (Model Train Detection And Action)
+ *
+ * Supporting a vast variety of input sensors and output devices
+ * Simple to use to build complex solutions
+ * Non blocking, simple, yet efficient event-driven state machine
+ * Comprehensive control, state and debug information
+ */
+
+
+#include "Arduino.h"
+#include "MTD2A_base.h"
+#include "MTD2A_binary_input.h"
+#include "MTD2A_ir_input.h"
+
+
+// Constructor
+MTD2A_ir_input::MTD2A_ir_input
+  (
+    const char    *setObjectName,
+    const uint32_t setDelayTimeMS,
+    const bool     setFirstOrLast,
+    const bool     setTimeOrMono,
+    const uint32_t setPinBlockMS
+  )
+  : MTD2A_binary_input (setObjectName, setDelayTimeMS, setFirstOrLast, setTimeOrMono, setPinBlockMS)
+  {}
+// MTD2A_ir_input
+
+
+// Constructor F("Object name")
+MTD2A_ir_input::MTD2A_ir_input
+  (const __FlashStringHelper *setObjectName, const uint32_t setDelayTimeMS, const bool setFirstOrLast, const bool setTimeOrMono, const uint32_t setPinBlockMS)
+  : MTD2A_ir_input ((const char *)nullptr, setDelayTimeMS, setFirstOrLast, setTimeOrMono, setPinBlockMS)
+  {
+    MTD2A_set_object_name(setObjectName);
+  }
+// MTD2A_ir_input
+
+
+void MTD2A_ir_input::initialize (const uint8_t &setLedPin, const uint8_t &setReceiverPin, const uint8_t &setThreshold, const uint8_t &setHysteresis, const bool &setPinNomalOrInverted, const uint8_t &setPinPullupOrInput) {
+  // Check for instantiated object error
+  delayTimeMS = check_set_time (delayTimeMS);
+  pinBlockMS  = check_set_time (pinBlockMS);
+  // Configuration block (MTD2A_globalConfig) overrides the arguments
+  const uint32_t configThreshold  = MTD2A_config_value (CONFIG_THRESHOLD,  setThreshold);
+  const uint32_t configHysteresis = MTD2A_config_value (CONFIG_HYSTERESIS, setHysteresis);
+  set_threshold ((configThreshold > 100) ? 100 : (uint8_t)configThreshold, (configHysteresis > 100) ? 100 : (uint8_t)configHysteresis);
+  const uint8_t configPinNumber = (uint8_t)MTD2A_config_value (CONFIG_PIN_NUMBER, setReceiverPin);
+  errorNumber = MTD2A_reserve_and_check_pin (setLedPin, DIGITAL_FLAG_0 | OUTPUT_FLAG_4);
+  if (errorNumber == 0)
+    errorNumber = MTD2A_reserve_and_check_pin (configPinNumber, DIGITAL_FLAG_0 | INPUT_FLAG_2 | PULLUP_FLAG_3);
+  if (errorNumber == 0) {
+    if (setPinPullupOrInput == (uint8_t)INPUT  ||  setPinPullupOrInput == (uint8_t)INPUT_PULLUP)
+      pinType = setPinPullupOrInput;
+    else {
+      print_error_text (8);
+      pinType = INPUT_PULLUP;
+    }
+    pinMode(configPinNumber, pinType);
+    pinMode(setLedPin, OUTPUT);
+    digitalWrite(setLedPin, LOW);
+    errorNumber = MTD2A_ir_attach (setLedPin, configPinNumber, irSlot);
+  }
+  if (errorNumber == 0) {
+    pinReadToggl  = ENABLE;
+    pinNumber     = configPinNumber;
+    ledPin        = setLedPin;
+    pinReadMode   = (bool)MTD2A_config_value (CONFIG_PIN_MODE, setPinNomalOrInverted);
+    irState       = HIGH;
+    // The window completed after the next one is the first complete window of this channel
+    irWindowLast  = get_globalIrWindowCount () + 1;
+  }
+  else {
+    print_error_text (errorNumber);
+    pinReadToggl = DISABLE;
+    pinNumber    = PIN_ERROR_NO;
+    ledPin       = PIN_ERROR_NO;
+  }
+} // initialize
+
+
+void MTD2A_ir_input::set_threshold (const uint8_t &setThreshold, const uint8_t &setHysteresis) {
+  threshold  = (setThreshold  > 100) ? 100 : setThreshold;
+  hysteresis = (setHysteresis > 100) ? 100 : setHysteresis;
+} // set_threshold
+
+
+//  Getters ----------------------------------------------------------------------------
+
+
+uint8_t const &MTD2A_ir_input::get_signalLevel () const {
+  return signalLevel;
+}
+
+
+//  Private ----------------------------------------------------------------------------
+
+
+bool MTD2A_ir_input::loop_fast_read () {
+  const uint16_t windowCount = get_globalIrWindowCount ();
+  // One comparison per complete window (signed difference is wrap around safe)
+  if ((int16_t)(windowCount - irWindowLast) > 0) {
+    irWindowLast = windowCount;
+    // Correlation counts receiver HIGH with LED on (+1) and LED off (-1). NORMAL receivers are LOW on IR light
+    int16_t correlationValue = MTD2A_ir_value (irSlot);
+    if (pinReadMode == NORMAL)
+      correlationValue = -correlationValue;
+    // Max correlation: 8 LED on samples per code period of 16 samples
+    if (correlationValue <= 0)
+      signalLevel = 0;
+    else if (correlationValue >= 8 * MTD2A_IR_WINDOW)
+      signalLevel = 100;
+    else
+      signalLevel = (uint8_t)((correlationValue * 100) / (8 * MTD2A_IR_WINDOW));
+    // Comparator with hysteresis. Written without subtraction to avoid wrap around near 0
+    if ((uint16_t)signalLevel >= (uint16_t)threshold + hysteresis)
+      irState = LOW;
+    else if ((uint16_t)signalLevel + hysteresis <= threshold)
+      irState = HIGH;
+  }
+  // pinReadMode is the receiver polarity. loop_fast_input () inverts INVERTED again: present is always active (LOW)
+  return (pinReadMode == NORMAL) ? irState : !irState;
+} // loop_fast_read
+
+
+#if MTD2A_OBJECT_STATE > 0
+void MTD2A_ir_input::MTD2A_snapshot_state (MTD2A_snapshot_record &snapshotRecord) const {
+  // pinValue: signal level {0 - 100} %. timeMS as binary_input
+  MTD2A_binary_input::MTD2A_snapshot_state (snapshotRecord);
+  snapshotRecord.objectType = SNAPSHOT_IR;
+  snapshotRecord.pinValue   = signalLevel;
+} // MTD2A_snapshot_state
+#endif
+
+
+#if MTD2A_CONFIG > 0
+bool MTD2A_ir_input::MTD2A_config_field (const uint8_t &fieldId, const uint32_t &fieldValue, const bool &applyField) {
+  // Values are validated by MTD2A_config_check (). Percent values above 100 are limited
+  switch (fieldId) {
+    case CONFIG_THRESHOLD:  if (applyField) set_threshold ((fieldValue > 100) ? 100 : (uint8_t)fieldValue, hysteresis); return true;
+    case CONFIG_HYSTERESIS: if (applyField) set_threshold (threshold, (fieldValue > 100) ? 100 : (uint8_t)fieldValue); return true;
+  }
+  return MTD2A_binary_input::MTD2A_config_field (fieldId, fieldValue, applyField);
+} // MTD2A_config_field
+#endif
+
+
+void MTD2A_ir_input::print_conf () {
+#if MTD2A_LOG_LEVEL >= MTD2A_LOG_DEBUG
+  MTD2A_binary_input::print_conf ();
+  PortPrintln(F("MTD2A_ir_input: "));
+  PortPrint  (F("  ledPin       : ")); PortPrintln(ledPin);
+  PortPrint  (F("  irSlot       : ")); PortPrintln(irSlot);
+  PortPrint  (F("  threshold    : ")); PortPrintln(threshold);
+  PortPrint  (F("  hysteresis   : ")); PortPrintln(hysteresis);
+  PortPrint  (F("  signalLevel  : ")); PortPrintln(signalLevel);
+#endif
+} // print_conf
@@ -0,0 +1,145 @@
+/*
+ ******************************************************************************
+ * @file    MTD2A_ir_input.h
+ * @author  Joergen Bo Madsen
+ * @version 1.0.0
+ * @date    18. October 2026
+ * @brief   Modulated IR presence input with synchronous detection (binary_input state machine)
+ *
+ * Supporting a vast variety of input sensors and output devices
+ * Simple to use to build complex solutions
+ * Non blocking, simple, yet efficient event-driven state machine
+ * Comprehensive control, state and debug information
+ */
+
+
+
+#ifndef _MTD2A_ir_input_H_
+#define _MTD2A_ir_input_H_
+
+
+#include "Arduino.h"
+#include "MTD2A_base.h"
+#include "MTD2A_binary_input.h"
+
+
+// The IR LED is pulsed with a code and the receiver is correlated with the LED state (MTD2A_globalIrChannels, MTD2A_IR_WINDOW).
+// Ambient and layout light is the same with LED on and off and cancels out. Neighbour sensors use orthogonal codes.
+// Signal level {0 - 100} %: 100 = receiver follows the LED in all samples, 0 = no reflection (or receiver saturated)
+// Comparator (pin state) with hysteresis:
+//   LOW  (present) when signal >= threshold + hysteresis
+//   HIGH (free)    when signal <= threshold - hysteresis
+// Present is active. Phases, timers, debounce, links and counters are the binary_input ones.
+// AVR: 1 sample per millisecond in the timer 0 compare A interrupt. Window: 64 ms (MTD2A_IR_WINDOW 4)
+// Other boards: 1 sample per MTD2A_loop_execute (). Window: 640 ms with globalDelayTimeMS 10
+// Requires a channel table in the sketch (MTD2A_globalIrChannels). Otherwise initialize () reports error 31
+
+
+class MTD2A_ir_input: public MTD2A_binary_input
+{
+  private:
+    // Arguments
+    uint8_t  ledPin        {PIN_ERROR_NO};   // initialize () default argument
+    uint8_t  threshold     {50};             // initialize () and set_threshold () default argument (%)
+    uint8_t  hysteresis    {10};             // initialize () and set_threshold () default argument (%)
+    // State
+    uint8_t  signalLevel   {0};              // get_signalLevel () Correlation of the last window (%)
+    bool     irState       {HIGH};           // Comparator state with hysteresis
+    // IR demodulator
+    uint8_t  irSlot        {PIN_ERROR_NO};   // Demodulator channel slot
+    uint16_t irWindowLast  {0};              // Window count of the last compared value
+
+  public:
+    // Constructor initializers
+
+    /**
+     * @class MTD2A_ir_input
+     * @brief Create object and set configuration parameters or use defaults
+     * @param ( "Object Name", delayTimeMS, {FIRST_TRIGGER | LAST_TRIGGER}, {TIME_DELAY | MONO_STABLE}, pinBlocTimeMS );
+     * @param delayTimeMS & pinblockTimeMS {0 - 4294967295} milliseconds
+     * @return none
+     */
+    MTD2A_ir_input (
+      const char    *setObjectName  = "Object name",
+      const uint32_t setDelayTimeMS = 0,
+      const bool     setFirstOrLast = LAST_TRIGGER,
+      const bool     setTimeOrMono  = TIME_DELAY,
+      const uint32_t setPinBlockMS  = 0
+    );
+    // F("Object name") flash memory name (only legal inside functions). Names are not copied, see set_objectName ()
+    MTD2A_ir_input (
+      const __FlashStringHelper *setObjectName,
+      const uint32_t setDelayTimeMS = 0,
+      const bool     setFirstOrLast = LAST_TRIGGER,
+      const bool     setTimeOrMono  = TIME_DELAY,
+      const uint32_t setPinBlockMS  = 0
+    );
+
+    // Destructor (globalObjectCount is decremented by ~MTD2A_binary_input)
+    ~MTD2A_ir_input () {
+      if (irSlot != PIN_ERROR_NO)
+        MTD2A_ir_detach (irSlot);
+    };
+
+  public: // Functions
+    /**
+     * @brief Initalize IR LED and receiver pin, threshold and hysteresis. If illigal pin configuration, pin reading is disabled!
+     * @brief NORMAL: Receiver LOW on IR light (FC-51, TCRT5000 modules, phototransistor to ground). INVERTED: HIGH on IR light
+     * @name object_name.initialize
+     * @param ( LED pin, receiver pin, threshold {0 - 100} %, hysteresis {0 - 100} %, {NORMAL | INVERTED}, {INPUT | INPUT_PULLUP} );
+     * @return none
+     */
+    void initialize (const uint8_t &setLedPin = PIN_ERROR_NO, const uint8_t &setReceiverPin = PIN_ERROR_NO, const uint8_t &setThreshold = 50, const uint8_t &setHysteresis = 10, const bool &setPinNomalOrInverted = NORMAL, const uint8_t &setPinPullupOrInput = INPUT_PULLUP);
+
+
+    /*
+     * @brief print configuration parameters, timers and state logic.
+     * @name object_name.print_conf ();
+     * @param none
+     * @return none
+     */
+    void print_conf ();
+
+
+    // Setters -----------------------------------------------
+
+
+    /**
+     * @brief Set signal threshold and hysteresis. Present (LOW) at threshold + hysteresis and free (HIGH) at threshold - hysteresis.
+     * @name object_name.set_threshold
+     * @param ( threshold {0 - 100} %, hysteresis {0 - 100} % );
+     * @return none
+     */
+    void set_threshold (const uint8_t &setThreshold, const uint8_t &setHysteresis = 10);
+
+
+    // Getters -----------------------------------------------
+
+
+    /**
+     * @brief Get signal level (correlation between IR LED and receiver) of the last window
+     * @name object_name.get_signalLevel ();
+     * @param none
+     * @return uint8_t {0 - 100} %
+     */
+    uint8_t const &get_signalLevel () const;
+
+
+  private: // Functions
+
+    // The receiver is sampled by the IR demodulator. Pin change interrupt and edge timing do not apply
+    using MTD2A_binary_input::set_pinInterrupt;
+    using MTD2A_binary_input::set_microTiming;
+
+    bool     loop_fast_read () override;
+#if MTD2A_OBJECT_STATE > 0
+    void     MTD2A_snapshot_state (MTD2A_snapshot_record &snapshotRecord) const override;
+#endif
+#if MTD2A_CONFIG > 0
+    bool     MTD2A_config_field   (const uint8_t &fieldId, const uint32_t &fieldValue, const bool &applyField) override;
+#endif
+
+}; // class MTD2A_ir_input
+
+
+#endif
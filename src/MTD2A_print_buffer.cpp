@@ -0,0 +1,115 @@
+/**
+ ******************************************************************************
+ * @file    MTD2A_print_buffer.cpp
+ * @author  Joergen Bo Madsen
+ * @version 1.0.0
+ * @date    18. October 2026
+ * @brief   functions for MTD2A_print_buffer.h (Model Train Detection And Action)
+ * 
+ * Supporting a vast variety of input sensors and output devices 
+ * Simple to use to build complex solutions 
+ * Non blocking, simple, yet efficient event-driven state machine
+ * Comprehensive control, state and debug information
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Open source free for all</center></h2>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ ******************************************************************************
+ */
+
+
+#include "Arduino.h"
+#include "MTD2A_base.h"
+#include "MTD2A_print_buffer.h"
+
+
+// Constructor
+MTD2A_print_buffer::MTD2A_print_buffer
+  (Print &setOutputPort, const uint16_t setDrainBytes)
+  : outputPort {&setOutputPort},
+    drainBytes {setDrainBytes}
+  {
+    if (drainBytes == 0)
+      drainBytes = 1;
+    // Drained by MTD2A_loop_execute ()
+    MTD2A::globalPrintBuffer = this;
+  }
+// MTD2A_print_buffer
+
+
+size_t MTD2A_print_buffer::write (uint8_t writeByte) {
+  if (dropLine == true) {
+    // Keep the line end so the next message starts on a new line
+    if (writeByte == '\n'  &&  store_byte (writeByte) == true)
+      dropLine = false;
+    return 1;
+  }
+  if (store_byte (writeByte) == false) {
+    dropLine = true;
+    if (dropCount < UINT16_MAX)
+      dropCount++;
+  }
+  return 1;
+} // write
+
+
+size_t MTD2A_print_buffer::write (const uint8_t *writeBuffer, size_t writeSize) {
+  for (size_t i {0}; i < writeSize; i++)
+    write (writeBuffer[i]);
+  return writeSize;
+} // write
+
+
+int MTD2A_print_buffer::availableForWrite () {
+  return MTD2A_PRINT_BUFFER_SIZE - bufferCount;
+} // availableForWrite
+
+
+void MTD2A_print_buffer::drain () {
+  int freeBytes = outputPort->availableForWrite();
+  uint16_t writeBytes = min((uint16_t)bufferCount, drainBytes);
+  if (freeBytes < (int)writeBytes)
+    writeBytes = (freeBytes > 0) ? (uint16_t)freeBytes : 0;
+  while (writeBytes > 0) {
+    // Contiguous part of the ring buffer
+    uint16_t chunkBytes = min(writeBytes, (uint16_t)(MTD2A_PRINT_BUFFER_SIZE - bufferTail));
+    outputPort->write(&ringBuffer[bufferTail], chunkBytes);
+    bufferTail   = (uint16_t)((bufferTail + chunkBytes) % MTD2A_PRINT_BUFFER_SIZE);
+    bufferCount -= chunkBytes;
+    writeBytes  -= chunkBytes;
+  }
+} // drain
+
+
+uint16_t const &MTD2A_print_buffer::get_bufferCount () const {
+  return bufferCount;
+}
+
+
+uint16_t MTD2A_print_buffer::get_reset_dropCount () {
+  uint16_t tempDropCount = dropCount;
+  dropCount = 0;
+  return tempDropCount;
+} // get_reset_dropCount
+
+
+bool MTD2A_print_buffer::store_byte (const uint8_t &storeByte) {
+  if (bufferCount >= MTD2A_PRINT_BUFFER_SIZE)
+    return false;
+  ringBuffer[bufferHead] = storeByte;
+  bufferHead = (uint16_t)((bufferHead + 1) % MTD2A_PRINT_BUFFER_SIZE);
+  bufferCount++;
+  return true;
+} // store_byte
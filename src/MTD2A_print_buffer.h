@@ -0,0 +1,111 @@
+/*
+ ******************************************************************************
+ * @file    MTD2A_print_buffer.h
+ * @author  Joergen Bo Madsen
+ * @version 1.0.0
+ * @date    18. October 2026
+ * @brief   Non blocking RAM ring buffer print port for MTD2A (Model Train Detection And Action)
+ * 
+ * Supporting a vast variety of input sensors and output devices 
+ * Simple to use to build complex solutions 
+ * Non blocking, simple, yet efficient event-driven state machine
+ * Comprehensive control, state and debug information
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Open source free for all</center></h2>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ ******************************************************************************
+ */
+
+
+#ifndef _MTD2A_print_buffer_H_
+#define _MTD2A_print_buffer_H_
+
+
+#include "Arduino.h"
+#include "MTD2A_base.h"
+
+// Ring buffer size in bytes {16 - 65535}
+#ifndef MTD2A_PRINT_BUFFER_SIZE
+  #define MTD2A_PRINT_BUFFER_SIZE 128
+#endif
+
+
+class MTD2A_print_buffer: public Print
+{
+  private:
+    Print   *outputPort     {nullptr};   // Constructor. Must support availableForWrite () (HardwareSerial)
+    uint16_t drainBytes     {32};        // Constructor default argument. Max bytes per MTD2A_loop_execute ()
+    uint8_t  ringBuffer[MTD2A_PRINT_BUFFER_SIZE];
+    uint16_t bufferHead     {0};         // Next write position
+    uint16_t bufferTail     {0};         // Next drain position
+    uint16_t bufferCount    {0};         // Bytes waiting
+    uint16_t dropCount      {0};         // get_reset_dropCount () Messages (lines) truncated (saturates at 65535)
+    bool     dropLine       {false};     // Rest of current line is dropped
+
+  public:
+    // Constructor initializers
+    /**
+     * @class MTD2A_print_buffer
+     * @brief Create print buffer. Use as print port: MTD2A_globalPrintPort (object_name);
+     * @param ( {Serial | Serial1 | ...}, drainBytes {1 - 65535} per loop );
+     * @return none
+     */
+    MTD2A_print_buffer (
+      Print         &setOutputPort,
+      const uint16_t setDrainBytes = 32
+    );
+
+    // Print interface (never blocks)
+    size_t write (uint8_t writeByte) override;
+    size_t write (const uint8_t *writeBuffer, size_t writeSize) override;
+    int    availableForWrite () override;
+    using  Print::write;
+
+
+    /**
+     * @brief Write waiting bytes to the output port. Called by MTD2A_loop_execute ()
+     * @brief Writes at most drainBytes and never more than the free output buffer space.
+     * @name object_name.drain ();
+     * @param none
+     * @return none
+     */
+    void drain ();
+
+
+    /**
+     * @brief Get number of bytes waiting in the buffer
+     * @name object_name.get_bufferCount ();
+     * @param none
+     * @return uint16_t bytes
+     */
+    uint16_t const &get_bufferCount () const;
+
+
+    /**
+     * @brief Get and reset number of dropped (truncated) messages because the buffer was full
+     * @name object_name.get_reset_dropCount ();
+     * @param none
+     * @return uint16_t count
+     */
+    uint16_t get_reset_dropCount ();
+
+  private: // Internal functions
+    bool store_byte (const uint8_t &storeByte);
+
+};  // MTD2A_print_buffer
+
+
+#endif
@@ -0,0 +1,539 @@
+/**
+ ******************************************************************************
+ * @file    MTD2A_script.cpp
+ * @author  Joergen Bo Madsen
+ * @version 1.0.0
+ * @date    18. October 2026
+ * @brief   functions for MTD2A_script.h (Model Train Detection And Action)
+ *
+ * Supporting a vast variety of input sensors and output devices
+ * Simple to use to build complex solutions
+ * Non blocking, simple, yet efficient event-driven state machine
+ * Comprehensive control, state and debug information
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Open source free for all</center></h2>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ ******************************************************************************
+ */
+
+
+
+
+#include "Arduino.h"
+#include "MTD2A_base.h"
+#include "MTD2A_script.h"
+#if MTD2A_CONFIG > 0
+  #include "EEPROM.h"
+#endif
+
+
+// Specific global constants from MTD2A_script.h (MTD2A_const.h)
+constexpr uint8_t MTD2A_script::SCRIPT_RAM;
+constexpr uint8_t MTD2A_script::SCRIPT_FLASH;
+constexpr uint8_t MTD2A_script::SCRIPT_EEPROM;
+// Phases
+constexpr uint8_t MTD2A_script::RESET_PHASE;
+constexpr uint8_t MTD2A_script::RUN_PHASE;
+constexpr uint8_t MTD2A_script::COMPLETE_PHASE;
+// MTD2A_base
+constexpr uint8_t MTD2A_script::NO_PRINT_PIN;
+// Script
+constexpr uint8_t MTD2A_script::MAX_REGISTERS;
+constexpr uint8_t MTD2A_script::IMAGE_MAGIC;
+constexpr uint8_t MTD2A_script::IMAGE_HEADER;
+
+// Instruction length in bytes (opcode included). Index = opcode
+static const uint8_t instructionLength[] PROGMEM {1, 4, 6, 3, 3, 3, 4, 4, 3, 4, 4, 5, 3, 2, 1};
+static constexpr uint8_t MAX_OPCODE {sizeof(instructionLength) - 1};
+
+
+// Constructor
+MTD2A_script::MTD2A_script
+  (const char *setObjectName, const uint8_t setMaxSteps)
+  : maxSteps {setMaxSteps},
+    // Instatiated funtion pointer
+    MTD2A{[](MTD2A* funcPtr) { static_cast<MTD2A_script*>(funcPtr)->loop_fast(); }}
+  {
+    MTD2A_add_function_pointer_loop_fast(this);
+    MTD2A_set_object_name(setObjectName);
+    if (maxSteps == 0)
+      maxSteps = 1;
+  }
+// MTD2A_script
+
+
+// Constructor F("Object name")
+MTD2A_script::MTD2A_script
+  (const __FlashStringHelper *setObjectName, const uint8_t setMaxSteps)
+  : MTD2A_script ((const char *)nullptr, setMaxSteps)
+  {
+    MTD2A_set_object_name(setObjectName);
+  }
+// MTD2A_script
+
+
+void MTD2A_script::initialize (const uint8_t *setScriptCode, const uint16_t &setCodeSize, const uint8_t &setCodeSource) {
+  if (setScriptCode == nullptr  ||  setCodeSize == 0  ||  setCodeSource > SCRIPT_FLASH) {
+    print_error_text (24);
+    return;
+  }
+  scriptCode = setScriptCode;
+  codeSize   = setCodeSize;
+  codeSource = setCodeSource;
+  reset ();
+} // initialize
+
+
+void MTD2A_script::initialize_EEPROM (const uint16_t &setEEPROMAddress) {
+  if (check_image (setEEPROMAddress) == false) {
+    print_error_text (24);
+    return;
+  }
+#if MTD2A_CONFIG > 0
+  scriptCode  = nullptr;
+  codeAddress = setEEPROMAddress;
+  codeSize    = (uint16_t)(EEPROM.read(codeAddress + 1) | (EEPROM.read(codeAddress + 2) << 8));
+  codeSource  = SCRIPT_EEPROM;
+  reset ();
+#endif
+} // initialize_EEPROM
+
+
+void MTD2A_script::upload_EEPROM (Stream &uploadPort, const uint16_t &setEEPROMAddress, const uint32_t &setTimeOutMS) {
+#if MTD2A_CONFIG > 0
+  const uint32_t beginTimeMS = millis();
+  // Read one byte or timeout (-1)
+  auto read_byte = [&]() -> int {
+    while (millis() - beginTimeMS < setTimeOutMS) {
+      if (uploadPort.available() > 0)
+        return uploadPort.read();
+    }
+    return -1;
+  };
+  int readValue;
+  do {
+    readValue = read_byte ();
+  } while (readValue >= 0  &&  readValue != IMAGE_MAGIC);
+  uint8_t headerBytes[IMAGE_HEADER] {IMAGE_MAGIC};
+  for (uint8_t headerIndex {1}; headerIndex < IMAGE_HEADER  &&  readValue >= 0; headerIndex++) {
+    readValue = read_byte ();
+    headerBytes[headerIndex] = (uint8_t)readValue;
+  }
+  const uint16_t imageSize = (uint16_t)(headerBytes[1] | (headerBytes[2] << 8));
+  const uint16_t imageCRC  = (uint16_t)(headerBytes[3] | (headerBytes[4] << 8));
+  if (readValue < 0  ||  imageSize == 0  ||  (uint32_t)setEEPROMAddress + IMAGE_HEADER + imageSize > EEPROM.length()) {
+    print_error_text (readValue < 0 ? 24 : 26);
+    return;
+  }
+  // Invalidate the old image until the new image is complete
+  MTD2A_config_write (setEEPROMAddress, 0xFF);
+  uint16_t codeCRC {0xFFFF};
+  for (uint16_t codeIndex {0}; codeIndex < imageSize  &&  readValue >= 0; codeIndex++) {
+    readValue = read_byte ();
+    MTD2A_config_write (setEEPROMAddress + IMAGE_HEADER + codeIndex, (uint8_t)readValue);
+    codeCRC = MTD2A_crc16 (codeCRC, (uint8_t)readValue);
+  }
+  if (readValue < 0  ||  codeCRC != imageCRC) {
+    print_error_text (24);
+    return;
+  }
+  for (uint8_t headerIndex {IMAGE_HEADER}; headerIndex > 0; headerIndex--)
+    MTD2A_config_write (setEEPROMAddress + headerIndex - 1, headerBytes[headerIndex - 1]);
+#if defined(ESP32) || defined(ESP8266)
+  EEPROM.commit();
+#endif
+  uploadPort.println(F("MTD2A script OK"));
+  initialize_EEPROM (setEEPROMAddress);
+#else
+  // No EEPROM library (MTD2A_CONFIG 0)
+  (void)uploadPort;
+  (void)setEEPROMAddress;
+  (void)setTimeOutMS;
+  print_error_text (24);
+#endif
+} // upload_EEPROM
+
+
+void MTD2A_script::start () {
+  if (codeSize == 0) {
+    print_error_text (24);
+    return;
+  }
+  programCounter = 0;
+  waitActive     = false;
+  set_phase (RUN_PHASE, ACTIVE);
+} // start
+
+
+void MTD2A_script::reset () {
+  for (uint8_t registerIndex {0}; registerIndex < MAX_REGISTERS; registerIndex++)
+    scriptRegister[registerIndex] = 0;
+  programCounter = 0;
+  waitActive     = false;
+  tickSteps      = 0;
+  errorNumber    = 0;
+  set_phase (RESET_PHASE, COMPLETE);
+} // reset
+
+
+// Setters -------------------------------------------------------------
+
+
+void MTD2A_script::set_maxSteps (const uint8_t &setMaxSteps) {
+  maxSteps = (setMaxSteps > 0) ? setMaxSteps : 1;
+} // set_maxSteps
+
+
+void MTD2A_script::set_register (const uint8_t &setRegister, const int32_t &setValue) {
+  if (setRegister < MAX_REGISTERS)
+    scriptRegister[setRegister] = setValue;
+} // set_register
+
+
+void MTD2A_script::set_debugPrint (const bool &setEnableOrDisable) {
+  debugPrint = setEnableOrDisable;
+} // set_debugPrint
+
+
+void MTD2A_script::set_errorPrint (const bool &setEnableOrDisable) {
+  errorPrint = setEnableOrDisable;
+} // set_errorPrint
+
+
+// getters -------------------------------------------------------------
+
+
+int32_t MTD2A_script::get_register (const uint8_t &getRegister) const {
+  return (getRegister < MAX_REGISTERS) ? scriptRegister[getRegister] : 0;
+} // get_register
+
+
+uint16_t const &MTD2A_script::get_programCounter () const {
+  return programCounter;
+}
+
+
+uint8_t const &MTD2A_script::get_tickSteps () const {
+  return tickSteps;
+}
+
+
+uint32_t const &MTD2A_script::get_instructionCount () const {
+  return instructionCount;
+}
+
+
+bool const &MTD2A_script::get_processState () const {
+  return processState;
+}
+
+
+bool const &MTD2A_script::get_phaseChange () const {
+  return phaseChange;
+}
+
+
+uint8_t const &MTD2A_script::get_phaseNumber () const {
+  return phaseNumber;
+}
+
+
+uint8_t const MTD2A_script::get_reset_error () {
+  uint8_t tempErrorNumber = errorNumber;
+  errorNumber = 0;
+  return tempErrorNumber;
+} // get_reset_error
+
+
+// Internal -------------------------------------------------------------
+
+
+void MTD2A_script::loop_fast () {
+  phaseChange = false;
+  tickSteps   = 0;
+  if (phaseNumber != RUN_PHASE)
+    return;
+  if (waitActive == true) {
+    if ((int32_t)(globalSyncTimeMS - waitEndMS) < 0)
+      return;
+    waitActive = false;
+  }
+  // Bounded number of instructions per loop
+  while (tickSteps < maxSteps) {
+    tickSteps++;
+    instructionCount++;
+    if (execute_step () == false)
+      break;
+  }
+} // loop_fast
+
+
+bool MTD2A_script::execute_step () {
+  // Returns false to stop executing in this loop (END, WAIT, YIELD or error)
+  if (programCounter >= codeSize) {
+    print_error_text (26);
+    set_phase (COMPLETE_PHASE, COMPLETE);
+    return false;
+  }
+  const uint8_t opcode = fetch_byte ();
+  if (opcode > MAX_OPCODE) {
+    print_error_text (25);
+    set_phase (COMPLETE_PHASE, COMPLETE);
+    return false;
+  }
+  if ((uint32_t)programCounter - 1 + pgm_read_byte(&instructionLength[opcode]) > codeSize) {
+    print_error_text (26);
+    set_phase (COMPLETE_PHASE, COMPLETE);
+    return false;
+  }
+  switch (opcode) {
+    case 0x00: // END
+      set_phase (COMPLETE_PHASE, COMPLETE);
+      return false;
+    case 0x01: { // LOAD r imm16
+      const uint8_t loadRegister = fetch_register ();
+      scriptRegister[loadRegister] = fetch_word ();
+    } break;
+    case 0x02: { // LOADL r imm32
+      const uint8_t loadRegister = fetch_register ();
+      uint32_t loadValue = fetch_word ();
+      loadValue |= (uint32_t)fetch_word () << 16;
+      scriptRegister[loadRegister] = (int32_t)loadValue;
+    } break;
+    case 0x03: { // MOV r s
+      const uint8_t toRegister = fetch_register ();
+      scriptRegister[toRegister] = scriptRegister[fetch_register ()];
+    } break;
+    case 0x04: { // ADD r s
+      const uint8_t toRegister = fetch_register ();
+      scriptRegister[toRegister] += scriptRegister[fetch_register ()];
+    } break;
+    case 0x05: { // ADDI r imm8
+      const uint8_t toRegister = fetch_register ();
+      scriptRegister[toRegister] += (int8_t)fetch_byte ();
+    } break;
+    case 0x06: { // ACT obj action value
+      MTD2A *targetObject = find_object (fetch_byte ());
+      const uint8_t linkAction  = fetch_byte ();
+      const uint8_t actionValue = fetch_byte ();
+      if (targetObject == nullptr) {
+        print_error_text (27);
+        set_phase (COMPLETE_PHASE, COMPLETE);
+        return false;
+      }
+      if (targetObject->MTD2A_link_action (linkAction, actionValue, true) == false)
+        print_error_text (21);
+    } break;
+    case 0x07: { // GET r obj field
+      const uint8_t toRegister = fetch_register ();
+      MTD2A *sourceObject = find_object (fetch_byte ());
+      const uint8_t getField = fetch_byte ();
+      if (sourceObject == nullptr) {
+        print_error_text (27);
+        set_phase (COMPLETE_PHASE, COMPLETE);
+        return false;
+      }
+#if MTD2A_OBJECT_STATE > 0
+      MTD2A_snapshot_record objectState;
+      sourceObject->MTD2A_snapshot_state (objectState);
+      switch (getField) {
+        case 0:  scriptRegister[toRegister] = objectState.phaseNumber;            break;
+        case 1:  scriptRegister[toRegister] = objectState.stateFlags & 1;         break;
+        case 2:  scriptRegister[toRegister] = (objectState.stateFlags >> 1) & 1;  break;
+        case 3:  scriptRegister[toRegister] = objectState.pinValue;               break;
+        case 4:  scriptRegister[toRegister] = (int32_t)objectState.timeMS;        break;
+        default: scriptRegister[toRegister] = objectState.errorNumber;            break;
+      }
+#else
+      (void)getField;
+      scriptRegister[toRegister] = 0;
+      print_error_text (33);
+#endif
+    } break;
+    case 0x08: // JMP addr16
+      programCounter = fetch_word ();
+    break;
+    case 0x09: { // JZ r addr16
+      const int32_t testValue = scriptRegister[fetch_register ()];
+      const uint16_t jumpAddress = fetch_word ();
+      if (testValue == 0)
+        programCounter = jumpAddress;
+    } break;
+    case 0x0A: { // JNZ r addr16
+      const int32_t testValue = scriptRegister[fetch_register ()];
+      const uint16_t jumpAddress = fetch_word ();
+      if (testValue != 0)
+        programCounter = jumpAddress;
+    } break;
+    case 0x0B: { // JEQ r imm8 addr16
+      const int32_t testValue = scriptRegister[fetch_register ()];
+      const uint8_t compareValue = fetch_byte ();
+      const uint16_t jumpAddress = fetch_word ();
+      if (testValue == compareValue)
+        programCounter = jumpAddress;
+    } break;
+    case 0x0C: // WAIT imm16
+      waitEndMS  = globalSyncTimeMS + fetch_word ();
+      waitActive = true;
+      return false;
+    case 0x0D: // WAITR r
+      waitEndMS  = globalSyncTimeMS + (uint32_t)scriptRegister[fetch_register ()];
+      waitActive = true;
+      return false;
+    case 0x0E: // YIELD
+      return false;
+  }
+  return true;
+} // execute_step
+
+
+uint8_t MTD2A_script::fetch_byte () {
+  // Bounds are checked per instruction by execute_step ()
+  const uint16_t fetchAddress = programCounter++;
+  switch (codeSource) {
+    case SCRIPT_FLASH:  return pgm_read_byte(&scriptCode[fetchAddress]);
+#if MTD2A_CONFIG > 0
+    case SCRIPT_EEPROM: return EEPROM.read(codeAddress + IMAGE_HEADER + fetchAddress);
+#endif
+    default:            return scriptCode[fetchAddress];
+  }
+} // fetch_byte
+
+
+uint16_t MTD2A_script::fetch_word () {
+  const uint8_t lowByte = fetch_byte ();
+  return (uint16_t)(lowByte | (fetch_byte () << 8));
+} // fetch_word
+
+
+uint8_t MTD2A_script::fetch_register () {
+  return fetch_byte () & (MAX_REGISTERS - 1);
+} // fetch_register
+
+
+MTD2A *MTD2A_script::find_object (const uint8_t &findObjectIndex) const {
+  MTD2A* object = begin;
+  while (object != nullptr  &&  object->objectIndex != findObjectIndex)
+    object = object->next;
+  return object;
+} // find_object
+
+
+bool MTD2A_script::check_image (const uint16_t &checkAddress) {
+#if MTD2A_CONFIG > 0
+  if ((uint32_t)checkAddress + IMAGE_HEADER > EEPROM.length()  ||  EEPROM.read(checkAddress) != IMAGE_MAGIC)
+    return false;
+  const uint16_t imageSize = (uint16_t)(EEPROM.read(checkAddress + 1) | (EEPROM.read(checkAddress + 2) << 8));
+  const uint16_t imageCRC  = (uint16_t)(EEPROM.read(checkAddress + 3) | (EEPROM.read(checkAddress + 4) << 8));
+  if (imageSize == 0  ||  (uint32_t)checkAddress + IMAGE_HEADER + imageSize > EEPROM.length())
+    return false;
+  uint16_t codeCRC {0xFFFF};
+  for (uint16_t codeIndex {0}; codeIndex < imageSize; codeIndex++)
+    codeCRC = MTD2A_crc16 (codeCRC, EEPROM.read(checkAddress + IMAGE_HEADER + codeIndex));
+  return (codeCRC == imageCRC);
+#else
+  (void)checkAddress;
+  return false;
+#endif
+} // check_image
+
+
+void MTD2A_script::set_phase (const uint8_t &setPhaseNumber, const bool &setProcessState) {
+  processState = setProcessState;
+  phaseChange  = true;
+  phaseNumber  = setPhaseNumber;
+  print_phase_line ();
+} // set_phase
+
+
+#if MTD2A_OBJECT_STATE > 0
+void MTD2A_script::MTD2A_snapshot_state (MTD2A_snapshot_record &snapshotRecord) const {
+  // pinValue: Register 0 (low byte). timeMS: Program counter
+  snapshotRecord.objectType  = SNAPSHOT_SCRIPT;
+  snapshotRecord.phaseNumber = phaseNumber;
+  snapshotRecord.stateFlags  = (uint8_t)(processState | (phaseChange << 1));
+  snapshotRecord.errorNumber = errorNumber;
+  snapshotRecord.pinNumber   = PIN_ERROR_NO;
+  snapshotRecord.pinValue    = (uint8_t)scriptRegister[0];
+  snapshotRecord.timeMS      = programCounter;
+} // MTD2A_snapshot_state
+#endif
+
+
+bool MTD2A_script::MTD2A_link_action (const uint8_t &linkAction, const uint8_t &actionValue, const bool &executeAction) {
+  (void)actionValue;
+  switch (linkAction) {
+    case LINK_ACTIVATE: if (executeAction) start ();  return true;
+    case LINK_RESET:    if (executeAction) reset ();  return true;
+  }
+  return false;
+} // MTD2A_link_action
+
+
+void MTD2A_script::print_phase_line () {
+  MTD2A_trace_phase (phaseNumber);
+#if MTD2A_LOG_LEVEL >= MTD2A_LOG_DEBUG
+  if (globalTraceMode == TRACE_OFF  &&  (debugPrint == ENABLE  ||  globalDebugPrint == ENABLE)) {
+    MTD2A_print_object_name ();
+    PortPrint(F(" "));
+    print_phase_text ();
+    PortPrintln();
+  }
+#endif
+} // print_phase_line
+
+
+void MTD2A_script::print_phase_text () {
+#if MTD2A_LOG_LEVEL >= MTD2A_LOG_DEBUG
+  switch(phaseNumber) {
+    case 0: PortPrint(F("[0] Reset"));     break;
+    case 1: PortPrint(F("[1] Run"));       break;
+    case 4: PortPrint(F("[4] Complete"));  break;
+  }
+#endif
+} // print_phase_text
+
+
+void MTD2A_script::print_error_text (const uint8_t setErrorNumber) {
+  errorNumber = setErrorNumber;
+  MTD2A_trace_phase (phaseNumber, errorNumber);
+  if (globalTraceMode == TRACE_OFF) {
+    MTD2A_print_object_name ();
+    MTD2A_print_error_text ((debugPrint == ENABLE || errorPrint == ENABLE), errorNumber, NO_PRINT_PIN);
+  }
+} // print_error_text
+
+
+void MTD2A_script::print_conf () {
+#if MTD2A_LOG_LEVEL >= MTD2A_LOG_DEBUG
+  PortPrintln(F("MTD2A_script: "));
+  MTD2A_print_name_state (processState);
+  PortPrint  (F("  phaseText    : ")); print_phase_text (); PortPrintln();
+  MTD2A_print_debug_error (debugPrint, errorPrint, errorNumber);
+  // Setup
+  PortPrint  (F("  codeSource   : ")); PortPrintln(codeSource);
+  PortPrint  (F("  codeSize     : ")); PortPrintln(codeSize);
+  PortPrint  (F("  maxSteps     : ")); PortPrintln(maxSteps);
+  // Interpreter
+  PortPrint  (F("  programCount : ")); PortPrintln(programCounter);
+  PortPrint  (F("  waitActive   : ")); PortPrintln(waitActive);
+  PortPrint  (F("  instructions : ")); PortPrintln(instructionCount);
+  for (uint8_t registerIndex {0}; registerIndex < MAX_REGISTERS; registerIndex++) {
+    PortPrint  (F("  register "));    PortPrint(registerIndex); PortPrint(F("   : "));
+    PortPrintln(scriptRegister[registerIndex]);
+  }
+#endif
+} // print_conf
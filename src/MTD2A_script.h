@@ -0,0 +1,321 @@
+/*
+ ******************************************************************************
+ * @file    MTD2A_script.h
+ * @author  Joergen Bo Madsen
+ * @version 1.0.0
+ * @date    18. October 2026
+ * @brief   Bytecode interpreter for scenario scripts in RAM, PROGMEM or EEPROM
+ *
+ * Supporting a vast variety of input sensors and output devices
+ * Simple to use to build complex solutions
+ * Non blocking, simple, yet efficient event-driven state machine
+ * Comprehensive control, state and debug information
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Open source free for all</center></h2>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ ******************************************************************************
+ */
+
+
+
+#ifndef _MTD2A_script_H_
+#define _MTD2A_script_H_
+
+
+#include "Arduino.h"
+#include "MTD2A_base.h"
+
+
+// Instruction set. Little endian operands. r/s = register {0 - 7}, obj = object index (instantiation order)
+// Assembler: extras/MTD2A_script_assembler.py
+//   0x00 END                      Script complete
+//   0x01 LOAD   r imm16           r = imm16
+//   0x02 LOADL  r imm32           r = imm32
+//   0x03 MOV    r s               r = s
+//   0x04 ADD    r s               r = r + s
+//   0x05 ADDI   r imm8            r = r + imm8 (signed)
+//   0x06 ACT    obj action value  Link action (LINK_ACTIVATE | LINK_RESET | LINK_STOP | LINK_PAUSE | LINK_WRITE)
+//   0x07 GET    r obj field       r = object field (0 phase, 1 processState, 2 phaseChange, 3 pinValue, 4 timeMS, 5 error)
+//                                 r = 0 and error 33 when built with MTD2A_SNAPSHOT 0 and MTD2A_WARM 0
+//   0x08 JMP    addr16            Jump
+//   0x09 JZ     r addr16          Jump if r == 0
+//   0x0A JNZ    r addr16          Jump if r != 0
+//   0x0B JEQ    r imm8 addr16     Jump if r == imm8
+//   0x0C WAIT   imm16             Continue after imm16 milliseconds
+//   0x0D WAITR  r                 Continue after r milliseconds
+//   0x0E YIELD                    Continue next loop
+// EEPROM image and Serial upload: 0xA7, code length (uint16_t), CRC-16/CCITT-FALSE of code (uint16_t), code
+
+
+class MTD2A_script: public MTD2A
+{
+  private:
+    // Specific global constants from MTD2A_script.h (MTD2A_const.h)
+    static constexpr uint8_t  SCRIPT_RAM     {MTD2A_const::SCRIPT_RAM};
+    static constexpr uint8_t  SCRIPT_FLASH   {MTD2A_const::SCRIPT_FLASH};
+    static constexpr uint8_t  SCRIPT_EEPROM  {MTD2A_const::SCRIPT_EEPROM};
+    // Phases
+    static constexpr uint8_t  RESET_PHASE    {MTD2A_const::RESET_PHASE};
+    static constexpr uint8_t  RUN_PHASE      {MTD2A_const::RUN_PHASE};
+    static constexpr uint8_t  COMPLETE_PHASE {MTD2A_const::COMPLETE_PHASE};
+    // MTD2A_base
+    static constexpr uint8_t  NO_PRINT_PIN   {MTD2A::NO_PRINT_PIN};
+    // Script
+    static constexpr uint8_t  MAX_REGISTERS  {8};
+    static constexpr uint8_t  IMAGE_MAGIC    {0xA7};
+    static constexpr uint8_t  IMAGE_HEADER   {5};
+
+    // Arguments
+    const uint8_t *scriptCode {nullptr};      // initialize () RAM or PROGMEM code
+    uint16_t codeSize       {0};              // initialize () Bytes
+    uint16_t codeAddress    {0};              // initialize_EEPROM () EEPROM address of the image
+    uint8_t  codeSource     {SCRIPT_RAM};     // initialize () SCRIPT_RAM / SCRIPT_FLASH / SCRIPT_EEPROM
+    uint8_t  maxSteps       {16};             // set_maxSteps () Instructions per MTD2A_loop_execute ()
+    // Interpreter
+    int32_t  scriptRegister[MAX_REGISTERS] {0}; // get_register () / set_register ()
+    uint16_t programCounter {0};              // get_programCounter ()
+    uint32_t waitEndMS      {0};              // WAIT end time
+    bool     waitActive     {false};          // WAIT in progress
+    uint8_t  tickSteps      {0};              // get_tickSteps () Instructions executed in the last loop
+    uint32_t instructionCount {0};            // get_instructionCount () Total (uint32_t wrap around)
+    // Debug and error
+    bool     debugPrint     {DISABLE};        // set_debugPrint  () default argument / ENABLE
+    bool     errorPrint     {DISABLE};        // set_errorPrint  () default argument / ENABLE
+    uint8_t  errorNumber    {0};              // get_reset_error () Error {1-127} and Warning {128-255}
+    // State control
+    bool     processState   {COMPLETE};       // get_processState () / ACTIVE
+    bool     phaseChange    {false};          // true = change in phase state (one loop)
+    uint8_t  phaseNumber    {COMPLETE_PHASE}; // Reset = 0, Run = 1, Complete = 4
+
+  public:
+    // Constructor inittializers
+    /**
+     * @class MTD2A_script
+     * @brief Create object. Set script code with initialize () or initialize_EEPROM ()
+     * @param ( "Object Name", maxSteps {1 - 255} instructions per loop );
+     * @return none
+     */
+    MTD2A_script (
+      const char    *setObjectName  = "Object name",
+      const uint8_t  setMaxSteps    = 16
+    );
+    // F("Object name") flash memory name (only legal inside functions). Names are not copied, see set_objectName ()
+    MTD2A_script (
+      const __FlashStringHelper *setObjectName,
+      const uint8_t  setMaxSteps    = 16
+    );
+
+    // Destructor
+    ~MTD2A_script () {
+      if (globalObjectCount > 0 )
+        globalObjectCount--;
+    };
+
+    public: // Functions
+
+    /**
+     * @brief Set script code in RAM or flash memory. Flash: const uint8_t name[] PROGMEM {...};
+     * @name object_name.initialize
+     * @param ( code, codeSize {1 - 65535}, {SCRIPT_RAM | SCRIPT_FLASH} );
+     * @return none
+     */
+    void initialize (const uint8_t *setScriptCode, const uint16_t &setCodeSize, const uint8_t &setCodeSource = SCRIPT_RAM);
+
+
+    /**
+     * @brief Use script image in EEPROM (executed directly from EEPROM, no RAM copy). Image header and CRC are checked.
+     * @brief Requires MTD2A_CONFIG > 0 (default AVR, ESP32 and ESP8266). Otherwise error 24. ESP32 / ESP8266: call EEPROM.begin (size) first.
+     * @name object_name.initialize_EEPROM
+     * @param ( EEPROMaddress {0 - EEPROM.length () - 6} );
+     * @return none
+     */
+    void initialize_EEPROM (const uint16_t &setEEPROMAddress = 0);
+
+
+    /**
+     * @brief Receive a script image (extras/MTD2A_script_assembler.py --upload) and write it to EEPROM. Blocking, use in setup ().
+     * @brief Requires MTD2A_CONFIG > 0 (default AVR, ESP32 and ESP8266). Only changed EEPROM bytes are written.
+     * @name object_name.upload_EEPROM
+     * @param ( {Serial | Serial1 | any Stream}, EEPROMaddress, timeOutMS {1 - 4294967295} );
+     * @return none
+     */
+    void upload_EEPROM (Stream &uploadPort, const uint16_t &setEEPROMAddress = 0, const uint32_t &setTimeOutMS = 10000);
+
+
+    /**
+     * @brief Start script from address 0 (also restart while running). Registers are not cleared.
+     * @name object_name.start ();
+     * @param none
+     * @return none
+     */
+    void start ();
+
+
+    /**
+     * @brief Stop script, clear registers. Ready to start.
+     * @name object_name.reset ();
+     * @param none
+     * @return none
+     */
+    void reset ();
+
+
+    /**
+     * @brief print configuration parameters, registers and state logic.
+     * @name object_name.print_conf ();
+     * @param none
+     * @return none
+     */
+    void print_conf ();
+
+    // setters -------------------------------------------------------------
+
+
+    /**
+     * @brief Set max instructions executed per MTD2A_loop_execute (). Scripts can't exceed the loop cadence.
+     * @name object_name.set_maxSteps
+     * @param ( {1 - 255} );
+     * @return none
+     */
+    void set_maxSteps (const uint8_t &setMaxSteps);
+
+
+    /**
+     * @brief Set register value (script parameter).
+     * @name object_name.set_register
+     * @param ( register {0 - 7}, value );
+     * @return none
+     */
+    void set_register (const uint8_t &setRegister, const int32_t &setValue);
+
+
+    /**
+     * @brief Enable print phase state number, phase state text and error text.
+     * @name object_name.set_debugPrint
+     * @param ( {ENABLE | DISABLE} );
+     * @return none
+     */
+    void set_debugPrint (const bool &setEnableOrDisable = ENABLE);
+
+
+    /**
+     * @brief Enable error print text.
+     * @name object_name.set_errorPrint
+     * @param ( {ENABLE | DISABLE} );
+     * @return none
+     */
+    void set_errorPrint (const bool &setEnableOrDisable = ENABLE);
+
+
+    // getters -------------------------------------------------------------
+
+
+    /**
+     * @brief Get register value (script result).
+     * @name object_name.get_register
+     * @param ( register {0 - 7} );
+     * @return int32_t value
+     */
+    int32_t get_register (const uint8_t &getRegister) const;
+
+
+    /**
+     * @brief Get address of next instruction
+     * @name object_name.get_programCounter ();
+     * @param none
+     * @return uint16_t address
+     */
+    uint16_t const &get_programCounter () const;
+
+
+    /**
+     * @brief Get number of instructions executed in the last loop (benchmark)
+     * @name object_name.get_tickSteps ();
+     * @param none
+     * @return uint8_t instructions
+     */
+    uint8_t const &get_tickSteps () const;
+
+
+    /**
+     * @brief Get total number of executed instructions (benchmark)
+     * @name object_name.get_instructionCount ();
+     * @param none
+     * @return uint32_t instructions
+     */
+    uint32_t const &get_instructionCount () const;
+
+
+    /**
+     * @brief Get processState
+     * @name object_name.get_processState ();
+     * @param none
+     * @return bool {ACTIVE | COMPLETE}
+     */
+    bool const &get_processState () const;
+
+
+    /**
+     * @brief get phaseChange
+     * @name object_name.get_phaseChange ();
+     * @param none
+     * @return bool {true | false}
+     */
+    bool const &get_phaseChange () const;
+
+
+    /**
+     * @brief get phase number.
+     * @name object_name.get_phaseNumber ();
+     * @param none
+     * @return uint8_t RESET_PHASE = 0, RUN_PHASE = 1, COMPLETE_PHASE = 4
+     */
+    uint8_t const &get_phaseNumber () const;
+
+
+    /**
+     * @brief Get and reset error number to zero
+     * @name object_name.get_reset_error ();
+     * @param none
+     * @return uint8_t Error number. Error {1-127} and Warning {128-255}
+     */
+    uint8_t const get_reset_error ();
+
+
+  private: // Internal functions
+
+    // Execute
+    void     loop_fast          ();
+    bool     execute_step       ();
+    uint8_t  fetch_byte         ();
+    uint16_t fetch_word         ();
+    uint8_t  fetch_register     ();
+    MTD2A   *find_object        (const uint8_t &findObjectIndex) const;
+    bool     check_image        (const uint16_t &checkAddress);
+    void     set_phase          (const uint8_t &setPhaseNumber, const bool &setProcessState);
+#if MTD2A_OBJECT_STATE > 0
+    void     MTD2A_snapshot_state (MTD2A_snapshot_record &snapshotRecord) const override;
+#endif
+    bool     MTD2A_link_action    (const uint8_t &linkAction, const uint8_t &actionValue, const bool &executeAction) override;
+    // print
+    void     print_phase_line   ();
+    void     print_phase_text   ();
+    void     print_error_text   (const uint8_t setErrorNumber);
+
+};  // MTD2A_script
+
+
+#endif
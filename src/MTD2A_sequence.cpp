@@ -0,0 +1,384 @@
+/**
+ ******************************************************************************
+ * @file    MTD2A_sequence.cpp
+ * @author  Joergen Bo Madsen
+ * @version 1.0.0
+ * @date    18. October 2026
+ * @brief   functions for MTD2A_sequence.h (Model Train Detection And Action)
+ *
+ * Supporting a vast variety of input sensors and output devices
+ * Simple to use to build complex solutions
+ * Non blocking, simple, yet efficient event-driven state machine
+ * Comprehensive control, state and debug information
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Open source free for all</center></h2>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ ******************************************************************************
+ */
+
+
+
+
+#include "Arduino.h"
+#include "MTD2A_base.h"
+#include "MTD2A_sequence.h"
+
+
+// Specific global constants from MTD2A_sequence.h (MTD2A_const.h)
+constexpr bool    MTD2A_sequence::FLASH_TABLE;
+constexpr bool    MTD2A_sequence::RAM_TABLE;
+// Phases
+constexpr uint8_t MTD2A_sequence::RESET_PHASE;
+constexpr uint8_t MTD2A_sequence::RUN_PHASE;
+constexpr uint8_t MTD2A_sequence::PAUSE_PHASE;
+constexpr uint8_t MTD2A_sequence::COMPLETE_PHASE;
+// MTD2A_base
+constexpr uint8_t MTD2A_sequence::NO_PRINT_PIN;
+
+
+// Constructor
+MTD2A_sequence::MTD2A_sequence
+  (const char *setObjectName)
+  : // Instatiated funtion pointer
+    MTD2A{[](MTD2A* funcPtr) { static_cast<MTD2A_sequence*>(funcPtr)->loop_fast(); }}
+  {
+    MTD2A_add_function_pointer_loop_fast(this);
+    MTD2A_set_object_name(setObjectName);
+  }
+// MTD2A_sequence
+
+
+// Constructor F("Object name")
+MTD2A_sequence::MTD2A_sequence
+  (const __FlashStringHelper *setObjectName)
+  : MTD2A_sequence ((const char *)nullptr)
+  {
+    MTD2A_set_object_name(setObjectName);
+  }
+// MTD2A_sequence
+
+
+void MTD2A_sequence::initialize (const MTD2A_sequence_step *setStepTable, const uint16_t &setStepCount, const bool &setTableFlash) {
+  if (setStepTable == nullptr  ||  setStepCount == 0) {
+    print_error_text (22);
+    return;
+  }
+  stepTable  = setStepTable;
+  stepCount  = setStepCount;
+  tableFlash = setTableFlash;
+  // The cursor only moves forward
+  MTD2A_sequence_step checkStep;
+  uint32_t lastOffsetMS {0};
+  for (uint16_t checkIndex {0}; checkIndex < stepCount; checkIndex++) {
+    read_step (checkIndex, checkStep);
+    if (checkStep.offsetMS < lastOffsetMS) {
+      // The forward only cursor would skip steps. Table not used
+      print_error_text (23);
+      stepTable = nullptr;
+      stepCount = 0;
+      return;
+    }
+    lastOffsetMS = checkStep.offsetMS;
+  }
+  reset ();
+} // initialize
+
+
+void MTD2A_sequence::start () {
+  if (stepTable == nullptr) {
+    print_error_text (22);
+    return;
+  }
+  startTimeMS   = globalSyncTimeMS;
+  elapsedTimeMS = 0;
+  loopCount     = 0;
+  seek_step (0);
+  pendingPhase  = RUN_PHASE;
+} // start
+
+
+void MTD2A_sequence::pause () {
+  if (request_phase () != RUN_PHASE) {
+    print_error_text (16);
+    return;
+  }
+  pauseTimeMS  = globalSyncTimeMS;
+  pendingPhase = PAUSE_PHASE;
+} // pause
+
+
+void MTD2A_sequence::resume () {
+  if (request_phase () != PAUSE_PHASE) {
+    print_error_text (16);
+    return;
+  }
+  // Pause time is not part of the sequence time
+  startTimeMS += globalSyncTimeMS - pauseTimeMS;
+  pendingPhase = RUN_PHASE;
+} // resume
+
+
+void MTD2A_sequence::jump (const uint32_t &setOffsetMS) {
+  if (stepTable == nullptr) {
+    print_error_text (22);
+    return;
+  }
+  const uint8_t jumpPhase = request_phase ();
+  if (jumpPhase == PAUSE_PHASE)
+    startTimeMS = pauseTimeMS - setOffsetMS;
+  else
+    startTimeMS = globalSyncTimeMS - setOffsetMS;
+  elapsedTimeMS = setOffsetMS;
+  seek_step (setOffsetMS);
+  if (jumpPhase != RUN_PHASE  &&  jumpPhase != PAUSE_PHASE)
+    pendingPhase = RUN_PHASE;
+} // jump
+
+
+void MTD2A_sequence::reset () {
+  startTimeMS   = 0;
+  pauseTimeMS   = 0;
+  elapsedTimeMS = 0;
+  loopCount     = 0;
+  errorNumber   = 0;
+  seek_step (0);
+  pendingPhase  = RESET_PHASE;
+} // reset
+
+
+// Setters -------------------------------------------------------------
+
+
+void MTD2A_sequence::set_loopMode (const bool &setEnableOrDisable, const uint32_t &setCycleMS) {
+  loopMode = setEnableOrDisable;
+  cycleMS  = setCycleMS;
+} // set_loopMode
+
+
+void MTD2A_sequence::set_debugPrint (const bool &setEnableOrDisable) {
+  debugPrint = setEnableOrDisable;
+} // set_debugPrint
+
+
+void MTD2A_sequence::set_errorPrint (const bool &setEnableOrDisable) {
+  errorPrint = setEnableOrDisable;
+} // set_errorPrint
+
+
+// getters -------------------------------------------------------------
+
+
+uint32_t const &MTD2A_sequence::get_elapsedTimeMS () const {
+  return elapsedTimeMS;
+}
+
+
+uint16_t const &MTD2A_sequence::get_stepIndex () const {
+  return stepIndex;
+}
+
+
+uint16_t const &MTD2A_sequence::get_loopCount () const {
+  return loopCount;
+}
+
+
+bool const &MTD2A_sequence::get_processState () const {
+  return processState;
+}
+
+
+bool const &MTD2A_sequence::get_phaseChange () const {
+  return phaseChange;
+}
+
+
+uint8_t const &MTD2A_sequence::get_phaseNumber () const {
+  return phaseNumber;
+}
+
+
+uint8_t const MTD2A_sequence::get_reset_error () {
+  uint8_t tempErrorNumber = errorNumber;
+  errorNumber = 0;
+  return tempErrorNumber;
+} // get_reset_error
+
+
+// Internal -------------------------------------------------------------
+
+
+void MTD2A_sequence::loop_fast () {
+  phaseChange = false;
+  // Phase requested since the last loop (user code, links and steps). One loop phase change, same as other objects
+  if (pendingPhase != MAX_BYTE_VALUE) {
+    const bool pendingState = (pendingPhase == RUN_PHASE  ||  pendingPhase == PAUSE_PHASE) ? ACTIVE : COMPLETE;
+    set_phase (pendingPhase, pendingState);
+    pendingPhase = MAX_BYTE_VALUE;
+  }
+  if (phaseNumber != RUN_PHASE)
+    return;
+  elapsedTimeMS = globalSyncTimeMS - startTimeMS;
+  // Next cycle. nextOffsetMS is the offset of the last step when all steps are executed
+  if (stepIndex >= stepCount  &&  loopMode == ENABLE) {
+    const uint32_t cycleEndMS = max(cycleMS, nextOffsetMS);
+    if (elapsedTimeMS >= cycleEndMS) {
+      loopCount++;
+      startTimeMS   += cycleEndMS;
+      elapsedTimeMS -= cycleEndMS;
+      seek_step (0);
+    }
+  }
+  // Cursor: one compare per loop when no step is due
+  MTD2A_sequence_step dueStep;
+  while (stepIndex < stepCount  &&  nextOffsetMS <= elapsedTimeMS) {
+    read_step (stepIndex, dueStep);
+    if (dueStep.targetObject != nullptr)
+      dueStep.targetObject->MTD2A_link_action (dueStep.linkAction, dueStep.actionValue, true);
+    stepIndex++;
+    if (stepIndex < stepCount) {
+      read_step (stepIndex, dueStep);
+      nextOffsetMS = dueStep.offsetMS;
+    }
+    // A step may pause, reset or restart this sequence (continue next loop)
+    if (pendingPhase != MAX_BYTE_VALUE)
+      return;
+  }
+  // All steps done. RUN_PHASE started in this loop is visible for one loop first (all steps at offset 0)
+  if (stepIndex >= stepCount  &&  loopMode == DISABLE  &&  phaseChange == false)
+    set_phase (COMPLETE_PHASE, COMPLETE);
+} // loop_fast
+
+
+void MTD2A_sequence::read_step (const uint16_t &readStepIndex, MTD2A_sequence_step &readStep) const {
+  if (tableFlash == FLASH_TABLE)
+    memcpy_P (&readStep, &stepTable[readStepIndex], sizeof(MTD2A_sequence_step));
+  else
+    readStep = stepTable[readStepIndex];
+} // read_step
+
+
+void MTD2A_sequence::seek_step (const uint32_t &seekOffsetMS) {
+  // First step at or after the offset. Skipped steps are not executed
+  MTD2A_sequence_step seekStep;
+  stepIndex    = 0;
+  nextOffsetMS = 0;
+  while (stepIndex < stepCount) {
+    read_step (stepIndex, seekStep);
+    nextOffsetMS = seekStep.offsetMS;
+    if (seekStep.offsetMS >= seekOffsetMS)
+      break;
+    stepIndex++;
+  }
+} // seek_step
+
+
+uint8_t MTD2A_sequence::request_phase () const {
+  // Phase after the pending request (several requests within one loop)
+  return (pendingPhase != MAX_BYTE_VALUE) ? pendingPhase : phaseNumber;
+} // request_phase
+
+
+void MTD2A_sequence::set_phase (const uint8_t &setPhaseNumber, const bool &setProcessState) {
+  processState = setProcessState;
+  phaseChange  = true;
+  phaseNumber  = setPhaseNumber;
+  print_phase_line ();
+} // set_phase
+
+
+#if MTD2A_OBJECT_STATE > 0
+void MTD2A_sequence::MTD2A_snapshot_state (MTD2A_snapshot_record &snapshotRecord) const {
+  // pinValue: Next step index (low byte). timeMS: RUN_PHASE: Sequence start (globalSyncTimeMS). Otherwise elapsed sequence time
+  snapshotRecord.objectType  = SNAPSHOT_SEQUENCE;
+  snapshotRecord.phaseNumber = phaseNumber;
+  snapshotRecord.stateFlags  = (uint8_t)(processState | (phaseChange << 1));
+  snapshotRecord.errorNumber = errorNumber;
+  snapshotRecord.pinNumber   = PIN_ERROR_NO;
+  snapshotRecord.pinValue    = (uint8_t)stepIndex;
+  snapshotRecord.timeMS      = (phaseNumber == RUN_PHASE) ? startTimeMS : elapsedTimeMS;
+} // MTD2A_snapshot_state
+#endif
+
+
+bool MTD2A_sequence::MTD2A_link_action (const uint8_t &linkAction, const uint8_t &actionValue, const bool &executeAction) {
+  (void)actionValue;
+  switch (linkAction) {
+    case LINK_ACTIVATE: if (executeAction) start ();  return true;
+    case LINK_RESET:    if (executeAction) reset ();  return true;
+    case LINK_STOP:     if (executeAction) reset ();  return true;
+    case LINK_PAUSE:    if (executeAction) pause ();  return true;
+  }
+  return false;
+} // MTD2A_link_action
+
+
+void MTD2A_sequence::print_phase_line () {
+  MTD2A_trace_phase (phaseNumber);
+#if MTD2A_LOG_LEVEL >= MTD2A_LOG_DEBUG
+  if (globalTraceMode == TRACE_OFF  &&  (debugPrint == ENABLE  ||  globalDebugPrint == ENABLE)) {
+    MTD2A_print_object_name ();
+    PortPrint(F(" "));
+    print_phase_text ();
+    if (phaseNumber == RUN_PHASE  ||  phaseNumber == PAUSE_PHASE) {
+      PortPrint(F(" > ")); PortPrint(elapsedTimeMS); PortPrint(F(" ms"));
+    }
+    PortPrintln();
+  }
+#endif
+} // print_phase_line
+
+
+void MTD2A_sequence::print_phase_text () {
+#if MTD2A_LOG_LEVEL >= MTD2A_LOG_DEBUG
+  switch(phaseNumber) {
+    case 0: PortPrint(F("[0] Reset"));     break;
+    case 1: PortPrint(F("[1] Run"));       break;
+    case 2: PortPrint(F("[2] Pause"));     break;
+    case 4: PortPrint(F("[4] Complete"));  break;
+  }
+#endif
+} // print_phase_text
+
+
+void MTD2A_sequence::print_error_text (const uint8_t setErrorNumber) {
+  errorNumber = setErrorNumber;
+  MTD2A_trace_phase (phaseNumber, errorNumber);
+  if (globalTraceMode == TRACE_OFF) {
+    MTD2A_print_object_name ();
+    MTD2A_print_error_text ((debugPrint == ENABLE || errorPrint == ENABLE), errorNumber, NO_PRINT_PIN);
+  }
+} // print_error_text
+
+
+void MTD2A_sequence::print_conf () {
+#if MTD2A_LOG_LEVEL >= MTD2A_LOG_DEBUG
+  PortPrintln(F("MTD2A_sequence: "));
+  MTD2A_print_name_state (processState);
+  PortPrint  (F("  phaseText    : ")); print_phase_text (); PortPrintln();
+  MTD2A_print_debug_error (debugPrint, errorPrint, errorNumber);
+  // Setup
+  PortPrint  (F("  stepCount    : ")); PortPrintln(stepCount);
+  PortPrint  (F("  tableFlash   : ")); MTD2A_print_enable_disable (tableFlash);
+  PortPrint  (F("  loopMode     : ")); MTD2A_print_enable_disable (loopMode);
+  PortPrint  (F("  cycleMS      : ")); PortPrintln(cycleMS);
+  // Cursor
+  PortPrint  (F("  stepIndex    : ")); PortPrintln(stepIndex);
+  PortPrint  (F("  nextOffsetMS : ")); PortPrintln(nextOffsetMS);
+  PortPrint  (F("  elapsedTimeMS: ")); PortPrintln(elapsedTimeMS);
+  PortPrint  (F("  loopCount    : ")); PortPrintln(loopCount);
+#endif
+} // print_conf
@@ -0,0 +1,292 @@
+/*
+ ******************************************************************************
+ * @file    MTD2A_sequence.h
+ * @author  Joergen Bo Madsen
+ * @version 1.0.0
+ * @date    18. October 2026
+ * @brief   Timeline sequencer. Time stamped actions on MTD2A objects (RAM or PROGMEM step table)
+ *
+ * Supporting a vast variety of input sensors and output devices
+ * Simple to use to build complex solutions
+ * Non blocking, simple, yet efficient event-driven state machine
+ * Comprehensive control, state and debug information
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Open source free for all</center></h2>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ ******************************************************************************
+ */
+
+
+
+#ifndef _MTD2A_sequence_H_
+#define _MTD2A_sequence_H_
+
+
+#include "Arduino.h"
+#include "MTD2A_base.h"
+
+
+// One step in a sequence table. Table sorted by offsetMS. Can be stored in PROGMEM
+struct MTD2A_sequence_step {
+  uint32_t offsetMS;      // Milliseconds from sequence start
+  MTD2A   *targetObject;  // Any MTD2A object
+  uint8_t  linkAction;    // LINK_ACTIVATE | LINK_RESET | LINK_STOP | LINK_PAUSE | LINK_WRITE
+  uint8_t  actionValue;   // LINK_WRITE pin value {0 - 255}
+};
+
+
+class MTD2A_sequence: public MTD2A
+{
+  private:
+    // Specific global constants from MTD2A_sequence.h (MTD2A_const.h)
+    static constexpr bool     FLASH_TABLE    {MTD2A_const::FLASH_TABLE};
+    static constexpr bool     RAM_TABLE      {MTD2A_const::RAM_TABLE};
+    // Phases
+    static constexpr uint8_t  RESET_PHASE    {MTD2A_const::RESET_PHASE};
+    static constexpr uint8_t  RUN_PHASE      {MTD2A_const::RUN_PHASE};
+    static constexpr uint8_t  PAUSE_PHASE    {MTD2A_const::PAUSE_PHASE};
+    static constexpr uint8_t  COMPLETE_PHASE {MTD2A_const::COMPLETE_PHASE};
+    // MTD2A_base
+    static constexpr uint8_t  NO_PRINT_PIN   {MTD2A::NO_PRINT_PIN};
+
+    // Arguments
+    const MTD2A_sequence_step *stepTable {nullptr}; // initialize () Step table
+    uint16_t stepCount      {0};              // initialize () Number of steps
+    bool     tableFlash     {RAM_TABLE};      // initialize () default argument / FLASH_TABLE (PROGMEM)
+    bool     loopMode       {DISABLE};        // set_loopMode () default argument / ENABLE
+    uint32_t cycleMS        {0};              // set_loopMode () Minimum offsetMS of last step
+    // Timers
+    uint32_t startTimeMS    {0};              // Sequence start (moved forward by pause time)
+    uint32_t pauseTimeMS    {0};              // Pause begin
+    uint32_t elapsedTimeMS  {0};              // get_elapsedTimeMS () Milliseconds since start (pause excluded)
+    uint32_t nextOffsetMS   {0};              // Offset of next step (cursor cache)
+    // Cursor
+    uint16_t stepIndex      {0};              // get_stepIndex () Next step to execute
+    uint16_t loopCount      {0};              // get_loopCount () Completed cycles (uint16_t wrap around)
+    // Debug and error
+    bool     debugPrint     {DISABLE};        // set_debugPrint  () default argument / ENABLE
+    bool     errorPrint     {DISABLE};        // set_errorPrint  () default argument / ENABLE
+    uint8_t  errorNumber    {0};              // get_reset_error () Error {1-127} and Warning {128-255}
+    // State control
+    bool     processState   {COMPLETE};       // get_processState () / ACTIVE
+    bool     phaseChange    {false};          // true = change in phase state (one loop)
+    uint8_t  phaseNumber    {COMPLETE_PHASE}; // Reset = 0, Run = 1, Pause = 2, Complete = 4
+    uint8_t  pendingPhase   {MAX_BYTE_VALUE}; // Phase requested by start (), pause () etc. Set by loop_fast (). MAX_BYTE_VALUE = none
+
+  public:
+    // Constructor inittializers
+    /**
+     * @class MTD2A_sequence
+     * @brief Create object. Set the step table with initialize ()
+     * @param ( "Object Name" );
+     * @return none
+     */
+    MTD2A_sequence (
+      const char    *setObjectName  = "Object name"
+    );
+    // F("Object name") flash memory name (only legal inside functions). Names are not copied, see set_objectName ()
+    MTD2A_sequence (
+      const __FlashStringHelper *setObjectName
+    );
+
+    // Destructor
+    ~MTD2A_sequence () {
+      if (globalObjectCount > 0 )
+        globalObjectCount--;
+    };
+
+    public: // Functions
+
+    /**
+     * @brief Set step table. Steps must be sorted by offsetMS (otherwise error 23, table not used). Use FLASH_TABLE for: const MTD2A_sequence_step name[] PROGMEM {...};
+     * @name object_name.initialize
+     * @param ( step_table, stepCount {1 - 65535}, {RAM_TABLE | FLASH_TABLE} );
+     * @return none
+     */
+    void initialize (const MTD2A_sequence_step *setStepTable, const uint16_t &setStepCount, const bool &setTableFlash = RAM_TABLE);
+
+
+    /**
+     * @brief Start sequence from offset 0 (also restart while running).
+     * @brief start (), pause (), resume (), jump () and reset () change phase in the next MTD2A_loop_execute () (visible to get_phaseChange ()).
+     * @name object_name.start ();
+     * @param none
+     * @return none
+     */
+    void start ();
+
+
+    /**
+     * @brief Pause sequence. No steps are executed until resume ().
+     * @name object_name.pause ();
+     * @param none
+     * @return none
+     */
+    void pause ();
+
+
+    /**
+     * @brief Resume a paused sequence. Pause time is not counted.
+     * @name object_name.resume ();
+     * @param none
+     * @return none
+     */
+    void resume ();
+
+
+    /**
+     * @brief Continue from offset (milliseconds). Steps before the offset are skipped (not executed).
+     * @name object_name.jump
+     * @param ( offsetMS {0 - 4294967295} );
+     * @return none
+     */
+    void jump (const uint32_t &setOffsetMS);
+
+
+    /**
+     * @brief Stop sequence and reset cursor. Ready to start.
+     * @name object_name.reset ();
+     * @param none
+     * @return none
+     */
+    void reset ();
+
+
+    /**
+     * @brief print configuration parameters, cursor and state logic.
+     * @name object_name.print_conf ();
+     * @param none
+     * @return none
+     */
+    void print_conf ();
+
+    // setters -------------------------------------------------------------
+
+
+    /**
+     * @brief Restart sequence after each cycle. Cycle time 0 (or less than offsetMS of last step) = offsetMS of last step.
+     * @name object_name.set_loopMode
+     * @param ( {ENABLE | DISABLE}, cycleMS {0 - 4294967295} );
+     * @return none
+     */
+    void set_loopMode (const bool &setEnableOrDisable = ENABLE, const uint32_t &setCycleMS = 0);
+
+
+    /**
+     * @brief Enable print phase state number, phase state text and error text.
+     * @name object_name.set_debugPrint
+     * @param ( {ENABLE | DISABLE} );
+     * @return none
+     */
+    void set_debugPrint (const bool &setEnableOrDisable = ENABLE);
+
+
+    /**
+     * @brief Enable error print text.
+     * @name object_name.set_errorPrint
+     * @param ( {ENABLE | DISABLE} );
+     * @return none
+     */
+    void set_errorPrint (const bool &setEnableOrDisable = ENABLE);
+
+
+    // getters -------------------------------------------------------------
+
+
+    /**
+     * @brief Get milliseconds since sequence start (pause time excluded)
+     * @name object_name.get_elapsedTimeMS ();
+     * @param none
+     * @return uint32_t milliseconds
+     */
+    uint32_t const &get_elapsedTimeMS () const;
+
+
+    /**
+     * @brief Get index of the next step to execute
+     * @name object_name.get_stepIndex ();
+     * @param none
+     * @return uint16_t step index
+     */
+    uint16_t const &get_stepIndex () const;
+
+
+    /**
+     * @brief Get number of completed cycles (loop mode)
+     * @name object_name.get_loopCount ();
+     * @param none
+     * @return uint16_t count
+     */
+    uint16_t const &get_loopCount () const;
+
+
+    /**
+     * @brief Get processState
+     * @name object_name.get_processState ();
+     * @param none
+     * @return bool {ACTIVE | COMPLETE}
+     */
+    bool const &get_processState () const;
+
+
+    /**
+     * @brief get phaseChange
+     * @name object_name.get_phaseChange ();
+     * @param none
+     * @return bool {true | false}
+     */
+    bool const &get_phaseChange () const;
+
+
+    /**
+     * @brief get phase number.
+     * @name object_name.get_phaseNumber ();
+     * @param none
+     * @return uint8_t RESET_PHASE = 0, RUN_PHASE = 1, PAUSE_PHASE = 2, COMPLETE_PHASE = 4
+     */
+    uint8_t const &get_phaseNumber () const;
+
+
+    /**
+     * @brief Get and reset error number to zero
+     * @name object_name.get_reset_error ();
+     * @param none
+     * @return uint8_t Error number. Error {1-127} and Warning {128-255}
+     */
+    uint8_t const get_reset_error ();
+
+
+  private: // Internal functions
+
+    // Execute
+    void     loop_fast          ();
+    void     read_step          (const uint16_t &readStepIndex, MTD2A_sequence_step &readStep) const;
+    void     seek_step          (const uint32_t &seekOffsetMS);
+    uint8_t  request_phase      () const;
+    void     set_phase          (const uint8_t &setPhaseNumber, const bool &setProcessState);
+#if MTD2A_OBJECT_STATE > 0
+    void     MTD2A_snapshot_state (MTD2A_snapshot_record &snapshotRecord) const override;
+#endif
+    bool     MTD2A_link_action    (const uint8_t &linkAction, const uint8_t &actionValue, const bool &executeAction) override;
+    // print
+    void     print_phase_line   ();
+    void     print_phase_text   ();
+    void     print_error_text   (const uint8_t setErrorNumber);
+
+};  // MTD2A_sequence
+
+
+#endif
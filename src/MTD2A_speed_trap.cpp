@@ -0,0 +1,437 @@
+/**
+ ******************************************************************************
+ * @file    MTD2A_speed_trap.cpp
+ * @author  Joergen Bo Madsen
+ * @version 1.0.0
+ * @date    18. October 2026
+ * @brief   functions for MTD2A_speed_trap.h (Model Train Detection And Action)
+ *
+ * Supporting a vast variety of input sensors and output devices
+ * Simple to use to build complex solutions
+ * Non blocking, simple, yet efficient event-driven state machine
+ * Comprehensive control, state and debug information
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Open source free for all</center></h2>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ ******************************************************************************
+ */
+
+
+#include "Arduino.h"
+#include "MTD2A_base.h"
+#include "MTD2A_speed_trap.h"
+
+
+// Specific global constants from MTD2A_speed_trap.h (MTD2A_const.h)
+constexpr uint8_t MTD2A_speed_trap::NO_DIRECTION;
+constexpr uint8_t MTD2A_speed_trap::LEFT_TO_RIGHT;
+constexpr uint8_t MTD2A_speed_trap::RIGHT_TO_LEFT;
+// Phases
+constexpr uint8_t MTD2A_speed_trap::RESET_PHASE;
+constexpr uint8_t MTD2A_speed_trap::ENTRY_PHASE;
+constexpr uint8_t MTD2A_speed_trap::SPEED_PHASE;
+constexpr uint8_t MTD2A_speed_trap::LENGTH_PHASE;
+constexpr uint8_t MTD2A_speed_trap::COMPLETE_PHASE;
+// MTD2A_base
+constexpr uint8_t MTD2A_speed_trap::NO_PRINT_PIN;
+
+
+// Constructor
+MTD2A_speed_trap::MTD2A_speed_trap
+  (const char *setObjectName, const uint32_t setDistanceMM, const uint32_t setTimeOutMS)
+  : distanceMM {setDistanceMM},
+    timeOutMS  {setTimeOutMS},
+    // Instatiated funtion pointer
+    MTD2A{[](MTD2A* funcPtr) { static_cast<MTD2A_speed_trap*>(funcPtr)->loop_fast(); }}
+  {
+    MTD2A_add_function_pointer_loop_fast(this);
+    MTD2A_set_object_name(setObjectName);
+  }
+// MTD2A_speed_trap
+
+
+// Constructor F("Object name")
+MTD2A_speed_trap::MTD2A_speed_trap
+  (const __FlashStringHelper *setObjectName, const uint32_t setDistanceMM, const uint32_t setTimeOutMS)
+  : MTD2A_speed_trap ((const char *)nullptr, setDistanceMM, setTimeOutMS)
+  {
+    MTD2A_set_object_name(setObjectName);
+  }
+// MTD2A_speed_trap
+
+
+void MTD2A_speed_trap::initialize (MTD2A_binary_input &setLeftInput, MTD2A_binary_input &setRightInput) {
+  if (distanceMM == 0)
+    print_error_text (170);
+  leftInput  = &setLeftInput;
+  rightInput = &setRightInput;
+  reset ();
+} // initialize
+
+
+void MTD2A_speed_trap::reset () {
+  direction     = NO_DIRECTION;
+  speedMMS      = 0.0;
+  trainLengthMM = 0;
+  travelTimeUS  = 0;
+  occupyTimeUS  = 0;
+  entryTimeMS   = 0;
+  entryTimeUS   = 0;
+  entryComplete = false;
+  exitActivated = false;
+  exitComplete  = false;
+  rearTiming    = false;
+  errorNumber   = 0;
+  processState  = COMPLETE;
+  phaseChange   = true;
+  phaseNumber   = RESET_PHASE;
+  // Events before reset are ignored
+  if (leftInput != nullptr  &&  rightInput != nullptr) {
+    leftActivate  = leftInput->get_activateCount();
+    rightActivate = rightInput->get_activateCount();
+    leftComplete  = leftInput->get_completeCount();
+    rightComplete = rightInput->get_completeCount();
+  }
+  print_phase_line ();
+} // reset
+
+
+// Setters -------------------------------------------------------------
+
+
+void MTD2A_speed_trap::set_distanceMM (const uint32_t &setDistanceMM) {
+  if (setDistanceMM == 0)
+    print_error_text (170);
+  else
+    distanceMM = setDistanceMM;
+} // set_distanceMM
+
+
+void MTD2A_speed_trap::set_timeOutMS (const uint32_t &setTimeOutMS) {
+  timeOutMS = setTimeOutMS;
+} // set_timeOutMS
+
+
+void MTD2A_speed_trap::set_debugPrint (const bool &setEnableOrDisable) {
+  debugPrint = setEnableOrDisable;
+} // set_debugPrint
+
+
+void MTD2A_speed_trap::set_errorPrint (const bool &setEnableOrDisable) {
+  errorPrint = setEnableOrDisable;
+} // set_errorPrint
+
+
+// getters -------------------------------------------------------------
+
+
+uint8_t const &MTD2A_speed_trap::get_direction () const {
+  return direction;
+}
+
+
+double const &MTD2A_speed_trap::get_speedMMS () const {
+  return speedMMS;
+}
+
+
+double MTD2A_speed_trap::get_scaleSpeedKMH (const uint16_t &setScale) const {
+  // mm/s -> km/h = 3600 / 1000000
+  return speedMMS * 0.0036 * (double)setScale;
+} // get_scaleSpeedKMH
+
+
+uint32_t const &MTD2A_speed_trap::get_trainLengthMM () const {
+  return trainLengthMM;
+}
+
+
+uint32_t const &MTD2A_speed_trap::get_travelTimeUS () const {
+  return travelTimeUS;
+}
+
+
+bool const &MTD2A_speed_trap::get_processState () const {
+  return processState;
+}
+
+
+bool const &MTD2A_speed_trap::get_phaseChange () const {
+  return phaseChange;
+}
+
+
+uint8_t const &MTD2A_speed_trap::get_phaseNumber () const {
+  return phaseNumber;
+}
+
+
+uint8_t const MTD2A_speed_trap::get_reset_error () {
+  uint8_t tempErrorNumber = errorNumber;
+  errorNumber = 0;
+  return tempErrorNumber;
+} // get_reset_error
+
+
+// Internal -------------------------------------------------------------
+
+
+void MTD2A_speed_trap::loop_fast () {
+  phaseChange = false;
+  if (leftInput == nullptr  ||  rightInput == nullptr)
+    return;
+  // Activate and complete counters change once per event, no matter the object execution order
+  bool leftEntry  = (leftInput->get_activateCount()  != leftActivate);
+  bool rightEntry = (rightInput->get_activateCount() != rightActivate);
+  bool leftDone   = (leftInput->get_completeCount()  != leftComplete);
+  bool rightDone  = (rightInput->get_completeCount() != rightComplete);
+  leftActivate  = leftInput->get_activateCount();
+  rightActivate = rightInput->get_activateCount();
+  leftComplete  = leftInput->get_completeCount();
+  rightComplete = rightInput->get_completeCount();
+  //
+  if (processState == COMPLETE) {
+    if (leftEntry  &&  rightEntry) {
+      // Both sensors within one loop. Time stamps decide
+      microTiming = (leftInput->get_microTiming()  &&  rightInput->get_microTiming());
+      int32_t diffTimeUS = (int32_t)(get_input_firstUS (rightInput) - get_input_firstUS (leftInput));
+      if (diffTimeUS == 0) {
+        // Same time stamp (no micro timing). Keep the train: the sensor left first is the entry sensor
+        print_error_text (172);
+        entry_state ((direction != NO_DIRECTION) ? direction : LEFT_TO_RIGHT);
+        rearTiming = true;
+      }
+      else
+        entry_state ((diffTimeUS > 0) ? LEFT_TO_RIGHT : RIGHT_TO_LEFT);
+      exitActivated = true;
+    }
+    else if (leftEntry)
+      entry_state (LEFT_TO_RIGHT);
+    else if (rightEntry)
+      entry_state (RIGHT_TO_LEFT);
+    return;
+  }
+  // Same entry time: direction from the sensor that completes first (both in one loop keeps the previous direction)
+  if (rearTiming == true  &&  entryComplete == false  &&  leftDone != rightDone)
+    direction = leftDone ? LEFT_TO_RIGHT : RIGHT_TO_LEFT;
+  //
+  MTD2A_binary_input *entryInput = (direction == LEFT_TO_RIGHT) ? leftInput  : rightInput;
+  bool entryDone = (direction == LEFT_TO_RIGHT) ? leftDone   : rightDone;
+  bool exitEntry = (direction == LEFT_TO_RIGHT) ? rightEntry : leftEntry;
+  bool exitDone  = (direction == LEFT_TO_RIGHT) ? rightDone  : leftDone;
+  if (entryDone) {
+    entryComplete = true;
+    occupyTimeUS  = get_input_lastUS (entryInput) - get_input_firstUS (entryInput);
+  }
+  if (exitEntry)
+    exitActivated = true;
+  if (exitDone  &&  exitActivated)
+    exitComplete = true;
+  // One phase per loop. Every phase is visible to get_phaseChange ()
+  switch (phaseNumber) {
+    case ENTRY_PHASE:
+      // Same entry time: speed from the rear of the train (exit sensor complete)
+      if (exitActivated  &&  (rearTiming == false  ||  exitComplete))
+        speed_state ();
+      else if (rearTiming == false  &&  timeOutMS > 0  &&  (globalSyncTimeMS - entryTimeMS) >= timeOutMS) {
+        print_error_text (171);
+        complete_state ();
+      }
+    break;
+    case SPEED_PHASE:
+      if (entryComplete)
+        length_state ();
+    break;
+    case LENGTH_PHASE:
+      if (exitComplete)
+        complete_state ();
+    break;
+  }
+} // loop_fast
+
+
+void MTD2A_speed_trap::entry_state (const uint8_t &setDirection) {
+  MTD2A_binary_input *entryInput = (setDirection == LEFT_TO_RIGHT) ? leftInput : rightInput;
+  microTiming   = (leftInput->get_microTiming()  &&  rightInput->get_microTiming());
+  direction     = setDirection;
+  entryTimeMS   = globalSyncTimeMS;
+  entryTimeUS   = get_input_firstUS (entryInput);
+  speedMMS      = 0.0;
+  trainLengthMM = 0;
+  travelTimeUS  = 0;
+  occupyTimeUS  = 0;
+  entryComplete = false;
+  exitActivated = false;
+  exitComplete  = false;
+  rearTiming    = false;
+  processState  = ACTIVE;
+  phaseChange   = true;
+  phaseNumber   = ENTRY_PHASE;
+  print_phase_line ();
+} // entry_state
+
+
+void MTD2A_speed_trap::speed_state () {
+  MTD2A_binary_input *exitInput = (direction == LEFT_TO_RIGHT) ? rightInput : leftInput;
+  if (rearTiming == true) {
+    MTD2A_binary_input *entryInput = (direction == LEFT_TO_RIGHT) ? leftInput : rightInput;
+    travelTimeUS = get_input_lastUS (exitInput) - get_input_lastUS (entryInput);
+  }
+  else
+    travelTimeUS = get_input_firstUS (exitInput) - entryTimeUS;
+  if (travelTimeUS > 0)
+    speedMMS = (double)distanceMM * 1000000.0 / (double)travelTimeUS;
+  else
+    speedMMS = 0.0;
+  phaseChange = true;
+  phaseNumber = SPEED_PHASE;
+  print_phase_line ();
+} // speed_state
+
+
+void MTD2A_speed_trap::length_state () {
+  // FIRST_TRIGGER and binary inputs have no last time. Last time equals first time (occupyTimeUS = 0)
+  trainLengthMM = (uint32_t)(speedMMS * (double)occupyTimeUS / 1000000.0 + 0.5);
+  phaseChange   = true;
+  phaseNumber   = LENGTH_PHASE;
+  print_phase_line ();
+} // length_state
+
+
+void MTD2A_speed_trap::complete_state () {
+  phaseChange  = true;
+  processState = COMPLETE;
+  phaseNumber  = COMPLETE_PHASE;
+  print_phase_line ();
+} // complete_state
+
+
+uint32_t MTD2A_speed_trap::get_input_firstUS (const MTD2A_binary_input *getInput) const {
+  if (microTiming == ENABLE)
+    return getInput->get_firstTimeUS();
+  else
+    return getInput->get_firstTimeMS() * MS_to_US;
+} // get_input_firstUS
+
+
+uint32_t MTD2A_speed_trap::get_input_lastUS (const MTD2A_binary_input *getInput) const {
+  if (microTiming == ENABLE)
+    return getInput->get_lastTimeUS();
+  else
+    return getInput->get_lastTimeMS() * MS_to_US;
+} // get_input_lastUS
+
+
+#if MTD2A_OBJECT_STATE > 0
+void MTD2A_speed_trap::MTD2A_snapshot_state (MTD2A_snapshot_record &snapshotRecord) const {
+  // pinValue: Direction. timeMS: Travel time entry sensor to exit sensor
+  snapshotRecord.objectType  = SNAPSHOT_SPEED_TRAP;
+  snapshotRecord.phaseNumber = phaseNumber;
+  snapshotRecord.stateFlags  = (uint8_t)(processState | (phaseChange << 1));
+  snapshotRecord.errorNumber = errorNumber;
+  snapshotRecord.pinNumber   = PIN_ERROR_NO;
+  snapshotRecord.pinValue    = direction;
+  snapshotRecord.timeMS      = travelTimeUS / MS_to_US;
+} // MTD2A_snapshot_state
+#endif
+
+
+bool MTD2A_speed_trap::MTD2A_link_action (const uint8_t &linkAction, const uint8_t &actionValue, const bool &executeAction) {
+  (void)actionValue;
+  switch (linkAction) {
+    case LINK_RESET:    if (executeAction) reset (); return true;
+  }
+  return false;
+} // MTD2A_link_action
+
+
+#if MTD2A_CONFIG > 0
+bool MTD2A_speed_trap::MTD2A_config_field (const uint8_t &fieldId, const uint32_t &fieldValue, const bool &applyField) {
+  // Values are validated by MTD2A_config_check ()
+  switch (fieldId) {
+    case CONFIG_DISTANCE: if (applyField) distanceMM = fieldValue; return true;
+    case CONFIG_TIME_OUT: if (applyField) timeOutMS  = fieldValue; return true;
+  }
+  return false;
+} // MTD2A_config_field
+#endif
+
+
+void MTD2A_speed_trap::print_phase_line () {
+  MTD2A_trace_phase (phaseNumber);
+#if MTD2A_LOG_LEVEL >= MTD2A_LOG_DEBUG
+  if (globalTraceMode == TRACE_OFF  &&  (debugPrint == ENABLE  ||  globalDebugPrint == ENABLE)) {
+    MTD2A_print_object_name ();
+    PortPrint(F(" "));
+    print_phase_text ();
+    switch (phaseNumber) {
+      case ENTRY_PHASE:
+        if (direction == LEFT_TO_RIGHT) PortPrint(F(" > Left to right")); else PortPrint(F(" > Right to left"));
+      break;
+      case SPEED_PHASE:
+        PortPrint(F(" > ")); PortPrint(speedMMS); PortPrint(F(" mm/s"));
+      break;
+      case LENGTH_PHASE:
+        PortPrint(F(" > ")); PortPrint(trainLengthMM); PortPrint(F(" mm"));
+      break;
+    }
+    PortPrintln();
+  }
+#endif
+} // print_phase_line
+
+
+void MTD2A_speed_trap::print_phase_text () {
+#if MTD2A_LOG_LEVEL >= MTD2A_LOG_DEBUG
+  switch(phaseNumber) {
+    case 0: PortPrint(F("[0] Reset"));     break;
+    case 1: PortPrint(F("[1] Entry"));     break;
+    case 2: PortPrint(F("[2] Speed"));     break;
+    case 3: PortPrint(F("[3] Length"));    break;
+    case 4: PortPrint(F("[4] Complete"));  break;
+  }
+#endif
+} // print_phase_text
+
+
+void MTD2A_speed_trap::print_error_text (const uint8_t setErrorNumber) {
+  errorNumber = setErrorNumber;
+  MTD2A_trace_phase (phaseNumber, errorNumber);
+  if (globalTraceMode == TRACE_OFF) {
+    MTD2A_print_object_name ();
+    MTD2A_print_error_text ((debugPrint == ENABLE || errorPrint == ENABLE), errorNumber, NO_PRINT_PIN);
+  }
+} // print_error_text
+
+
+void MTD2A_speed_trap::print_conf () {
+#if MTD2A_LOG_LEVEL >= MTD2A_LOG_DEBUG
+  PortPrintln(F("MTD2A_speed_trap: "));
+  MTD2A_print_name_state (processState);
+  PortPrint  (F("  phaseText    : ")); print_phase_text (); PortPrintln();
+  MTD2A_print_debug_error (debugPrint, errorPrint, errorNumber);
+  // Setup
+  PortPrint  (F("  distanceMM   : ")); PortPrintln(distanceMM);
+  PortPrint  (F("  timeOutMS    : ")); PortPrintln(timeOutMS);
+  PortPrint  (F("  microTiming  : ")); MTD2A_print_enable_disable (microTiming);
+  // Measurements
+  PortPrint  (F("  direction    : ")); PortPrintln(direction);
+  PortPrint  (F("  travelTimeUS : ")); PortPrintln(travelTimeUS);
+  PortPrint  (F("  speedMMS     : ")); PortPrintln(speedMMS);
+  PortPrint  (F("  occupyTimeUS : ")); PortPrintln(occupyTimeUS);
+  PortPrint  (F("  trainLengthMM: ")); PortPrintln(trainLengthMM);
+#endif
+} // print_conf
@@ -0,0 +1,292 @@
+/*
+ ******************************************************************************
+ * @file    MTD2A_speed_trap.h
+ * @author  Joergen Bo Madsen
+ * @version 1.0.0
+ * @date    18. October 2026
+ * @brief   Train direction, speed and length from two MTD2A_binary_input objects
+ *
+ * Supporting a vast variety of input sensors and output devices
+ * Simple to use to build complex solutions
+ * Non blocking, simple, yet efficient event-driven state machine
+ * Comprehensive control, state and debug information
+ *
+ ******************************************************************************
+ * @attention
+ *
+ * <h2><center>&copy; Open source free for all</center></h2>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ ******************************************************************************
+ */
+
+
+#ifndef _MTD2A_speed_trap_H_
+#define _MTD2A_speed_trap_H_
+
+
+#include "Arduino.h"
+#include "MTD2A_base.h"
+#include "MTD2A_binary_input.h"
+
+
+class MTD2A_speed_trap: public MTD2A
+{
+  private:
+    // Specific global constants from MTD2A_speed_trap.h (MTD2A_const.h)
+    static constexpr uint8_t  NO_DIRECTION   {MTD2A_const::NO_DIRECTION};
+    static constexpr uint8_t  LEFT_TO_RIGHT  {MTD2A_const::LEFT_TO_RIGHT};
+    static constexpr uint8_t  RIGHT_TO_LEFT  {MTD2A_const::RIGHT_TO_LEFT};
+    // Phases
+    static constexpr uint8_t  RESET_PHASE    {MTD2A_const::RESET_PHASE};
+    static constexpr uint8_t  ENTRY_PHASE    {MTD2A_const::ENTRY_PHASE};
+    static constexpr uint8_t  SPEED_PHASE    {MTD2A_const::SPEED_PHASE};
+    static constexpr uint8_t  LENGTH_PHASE   {MTD2A_const::LENGTH_PHASE};
+    static constexpr uint8_t  COMPLETE_PHASE {MTD2A_const::COMPLETE_PHASE};
+    // MTD2A_base
+    static constexpr uint8_t  NO_PRINT_PIN   {MTD2A::NO_PRINT_PIN};
+
+    // Arguments
+    uint32_t distanceMM     {0};              // Constructor default argument. Millimeters between the two sensors
+    uint32_t timeOutMS      {0};              // Constructor default argument. Max time from entry to exit sensor (0 = none)
+    MTD2A_binary_input *leftInput  {nullptr}; // initialize () Left sensor
+    MTD2A_binary_input *rightInput {nullptr}; // initialize () Right sensor
+    // Measurements
+    uint8_t  direction      {NO_DIRECTION};   // get_direction () LEFT_TO_RIGHT / RIGHT_TO_LEFT
+    double   speedMMS       {0.0};            // get_speedMMS () Millimeters per second
+    uint32_t trainLengthMM  {0};              // get_trainLengthMM () Millimeters
+    uint32_t travelTimeUS   {0};              // get_travelTimeUS () Entry sensor to exit sensor
+    uint32_t occupyTimeUS   {0};              // Entry sensor first to last time
+    uint32_t entryTimeMS    {0};              // Timeout reference
+    uint32_t entryTimeUS    {0};              // Entry sensor activated (micros () or millis () * 1000)
+    bool     microTiming    {DISABLE};        // Both inputs use set_microTiming (ENABLE)
+    // Debug and error
+    bool     debugPrint     {DISABLE};        // set_debugPrint  () default argument / ENABLE
+    bool     errorPrint     {DISABLE};        // set_errorPrint  () default argument / ENABLE
+    uint8_t  errorNumber    {0};              // get_reset_error () Error {1-127} and Warning {128-255}
+    // State control
+    bool     processState   {COMPLETE};       // get_processState () / ACTIVE
+    bool     phaseChange    {false};          // true = change in phase state (one loop)
+    uint8_t  phaseNumber    {COMPLETE_PHASE}; // Reset = 0, Entry = 1, Speed = 2, Length = 3, Complete = 4
+    bool     entryComplete  {false};          // Entry sensor COMPLETE after ENTRY_PHASE
+    bool     exitActivated  {false};          // Exit sensor FIRST_TIME_PHASE after ENTRY_PHASE
+    bool     exitComplete   {false};          // Exit sensor COMPLETE after exit sensor activated
+    bool     rearTiming     {false};          // Both sensors activated in one loop. Direction and speed from the exit order
+    // Input counters seen last loop (order independent event detection)
+    uint16_t leftActivate   {0};
+    uint16_t rightActivate  {0};
+    uint16_t leftComplete   {0};
+    uint16_t rightComplete  {0};
+
+  public:
+    // Constructor inittializers
+    /**
+     * @class MTD2A_speed_trap
+     * @brief Create object and set configuration parameter or use defaults
+     * @param ( "Object Name", distanceMM {1 - 4294967295}, timeOutMS {0 - 4294967295} );
+     * @return none
+     */
+    MTD2A_speed_trap (
+      const char    *setObjectName  = "Object name",
+      const uint32_t setDistanceMM  = 0,
+      const uint32_t setTimeOutMS   = 0
+    );
+    // F("Object name") flash memory name (only legal inside functions). Names are not copied, see set_objectName ()
+    MTD2A_speed_trap (
+      const __FlashStringHelper *setObjectName,
+      const uint32_t setDistanceMM = 0,
+      const uint32_t setTimeOutMS  = 0
+    );
+
+    // Destructor
+    ~MTD2A_speed_trap () {
+      if (globalObjectCount > 0 )
+        globalObjectCount--;
+    };
+
+    public: // Functions
+
+    /**
+     * @brief Set left and right sensor objects. Use LAST_TRIGGER and a delay time that bridges gaps between wagons.
+     * @name object_name.initialize
+     * @param ( left_sensor_object, right_sensor_object );
+     * @return none
+     */
+    void initialize (MTD2A_binary_input &setLeftInput, MTD2A_binary_input &setRightInput);
+
+
+    /**
+     * @brief Reset measurements and state logic. Ready to start.
+     * @name object_name.reset ();
+     * @param none
+     * @return none
+     */
+    void reset ();
+
+
+    /**
+     * @brief print configuration parameters, measurements and state logic.
+     * @name object_name.print_conf ();
+     * @param none
+     * @return none
+     */
+    void print_conf ();
+
+    // setters -------------------------------------------------------------
+
+
+    /**
+     * @brief Set distance between the two sensors in millimeters
+     * @name object_name.set_distanceMM
+     * @param ( {1 - 4294967295} );
+     * @return none
+     */
+    void set_distanceMM (const uint32_t &setDistanceMM);
+
+
+    /**
+     * @brief Set max time from entry sensor to exit sensor in milliseconds. 0 = no timeout
+     * @name object_name.set_timeOutMS
+     * @param ( {0 - 4294967295} );
+     * @return none
+     */
+    void set_timeOutMS (const uint32_t &setTimeOutMS);
+
+
+    /**
+     * @brief Enable print phase state number, phase state text and error text.
+     * @name object_name.set_debugPrint
+     * @param ( {ENABLE | DISABLE} );
+     * @return none
+     */
+    void set_debugPrint (const bool &setEnableOrDisable = ENABLE);
+
+
+    /**
+     * @brief Enable error print text.
+     * @name object_name.set_errorPrint
+     * @param ( {ENABLE | DISABLE} );
+     * @return none
+     */
+    void set_errorPrint (const bool &setEnableOrDisable = ENABLE);
+
+
+    // getters -------------------------------------------------------------
+
+
+    /**
+     * @brief Get direction of travel. Valid from ENTRY_PHASE
+     * @name object_name.get_direction ();
+     * @param none
+     * @return uint8_t NO_DIRECTION = 0, LEFT_TO_RIGHT = 1, RIGHT_TO_LEFT = 2
+     */
+    uint8_t const &get_direction () const;
+
+
+    /**
+     * @brief Get speed in millimeters per second. Valid from SPEED_PHASE
+     * @name object_name.get_speedMMS ();
+     * @param none
+     * @return double millimeters per second
+     */
+    double const &get_speedMMS () const;
+
+
+    /**
+     * @brief Get scale speed in kilometers per hour. Valid from SPEED_PHASE
+     * @name object_name.get_scaleSpeedKMH
+     * @param ( {1 - 65535} ); Model scale. H0 = 87, N = 160, G = 22
+     * @return double kilometers per hour
+     */
+    double get_scaleSpeedKMH (const uint16_t &setScale = 87) const;
+
+
+    /**
+     * @brief Get train length in millimeters. Valid from LENGTH_PHASE
+     * @name object_name.get_trainLengthMM ();
+     * @param none
+     * @return uint32_t millimeters
+     */
+    uint32_t const &get_trainLengthMM () const;
+
+
+    /**
+     * @brief Get time from entry sensor to exit sensor in microseconds. Valid from SPEED_PHASE
+     * @name object_name.get_travelTimeUS ();
+     * @param none
+     * @return uint32_t microseconds
+     */
+    uint32_t const &get_travelTimeUS () const;
+
+
+    /**
+     * @brief Get processState
+     * @name object_name.get_processState ();
+     * @param none
+     * @return bool {ACTIVE | COMPLETE}
+     */
+    bool const &get_processState () const;
+
+
+    /**
+     * @brief get phaseChange
+     * @name object_name.get_phaseChange ();
+     * @param none
+     * @return bool {true | false}
+     */
+    bool const &get_phaseChange () const;
+
+
+    /**
+     * @brief get phase number.
+     * @name object_name.get_phaseNumber ();
+     * @param none
+     * @return uint8_t RESET_PHASE = 0, ENTRY_PHASE = 1, SPEED_PHASE = 2, LENGTH_PHASE = 3, COMPLETE_PHASE = 4
+     */
+    uint8_t const &get_phaseNumber () const;
+
+
+    /**
+     * @brief Get and reset error number to zero
+     * @name object_name.get_reset_error ();
+     * @param none
+     * @return uint8_t Error number. Error {1-127} and Warning {128-255}
+     */
+    uint8_t const get_reset_error ();
+
+
+  private: // Internal functions
+
+    // Execute
+    void     loop_fast          ();
+    void     entry_state        (const uint8_t &setDirection);
+    void     speed_state        ();
+    void     length_state       ();
+    void     complete_state     ();
+    uint32_t get_input_firstUS  (const MTD2A_binary_input *getInput) const;
+    uint32_t get_input_lastUS   (const MTD2A_binary_input *getInput) const;
+#if MTD2A_OBJECT_STATE > 0
+    void     MTD2A_snapshot_state (MTD2A_snapshot_record &snapshotRecord) const override;
+#endif
+    bool     MTD2A_link_action    (const uint8_t &linkAction, const uint8_t &actionValue, const bool &executeAction) override;
+#if MTD2A_CONFIG > 0
+    bool     MTD2A_config_field   (const uint8_t &fieldId, const uint32_t &fieldValue, const bool &applyField) override;
+#endif
+    // print
+    void     print_phase_line   ();
+    void     print_phase_text   ();
+    void     print_error_text   (const uint8_t setErrorNumber);
+
+};  // MTD2A_speed_trap
+
+
+#endif
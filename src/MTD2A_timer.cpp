@@ -42,6 +42,15 @@ constexpr uint8_t  MTD2A_timer::PAUSE_TIMER;
 constexpr uint8_t  MTD2A_timer::STOP_TIMER;
 // MTD2A_base
 constexpr uint8_t  MTD2A_timer::NO_PRINT_PIN;
+#if MTD2A_TIMER_WHEEL > 0
+// Timing wheel
+constexpr uint8_t  MTD2A_timer::WHEEL_LEVELS;
+constexpr uint8_t  MTD2A_timer::WHEEL_SLOTS;
+constexpr uint8_t  MTD2A_timer::WHEEL_BITS;
+MTD2A_timer *MTD2A_timer::wheelSlot[WHEEL_LEVELS][WHEEL_SLOTS] {};
+uint32_t     MTD2A_timer::wheelTimeMS {0};
+uint16_t     MTD2A_timer::wheelCount  {0};
+#endif
 
 
 // Constructor
@@ -53,7 +62,17 @@ MTD2A_timer::MTD2A_timer
   { 
     remainTimeMS  = countDownMS;
     MTD2A_add_function_pointer_loop_fast(this);
-    objectName = MTD2A_set_object_name(setObjectName);
+    MTD2A_set_object_name(setObjectName);
+  }
+// MTD2A_timer
+
+
+// Constructor F("Object name")
+MTD2A_timer::MTD2A_timer
+  (const __FlashStringHelper *setObjectName, const uint32_t setCountDownMS)
+  : MTD2A_timer ((const char *)nullptr, setCountDownMS)
+  {
+    MTD2A_set_object_name(setObjectName);
   }
 // MTD2A_timer
 
@@ -120,7 +139,8 @@ void MTD2A_timer::reset_timer () {
 
 void MTD2A_timer::pause_timer () {
   if (processState == ACTIVE) {
-    if (phaseNumber == START_TIMER  ||  phaseNumber == RESET_TIMER) {
+    // STOP_TIMER while ACTIVE: Periodic mode period end
+    if (phaseNumber == START_TIMER  ||  phaseNumber == RESET_TIMER  ||  phaseNumber == STOP_TIMER) {
       beginPause = true;
     }
   }
@@ -155,6 +175,11 @@ void MTD2A_timer::set_countDownMS (const uint32_t &setCountDownMS) {
 } // set_countDownMS
 
 
+void MTD2A_timer::set_periodic (const bool &setEnableOrDisable) {
+  periodicMode = setEnableOrDisable;
+} // set_periodic
+
+
 void MTD2A_timer::set_debugPrint (const bool &setEnableOrDisable) {
   debugPrint = setEnableOrDisable;
 } // set_debugPrint
@@ -182,15 +207,26 @@ uint32_t const &MTD2A_timer::get_pauseTimeMS () const {
 }
 
 uint32_t const &MTD2A_timer::get_remainTimeMS () const {
+#if MTD2A_TIMER_WHEEL > 0
+  wheel_calc_time ();
+#endif
   return remainTimeMS;
 }
 
 
 uint32_t const &MTD2A_timer::get_elapsedTimeMS () const {
+#if MTD2A_TIMER_WHEEL > 0
+  wheel_calc_time ();
+#endif
   return elapsedTimeMS;
 }
 
 
+uint32_t const &MTD2A_timer::get_overrunCount () const {
+  return overrunCount;
+}
+
+
 bool const &MTD2A_timer::get_processState () const {
   return processState; 
 }
@@ -206,6 +242,14 @@ uint8_t const &MTD2A_timer::get_phaseNumber () const {
 }
 
 
+uint16_t MTD2A_timer::get_phaseCount (const uint8_t &getPhaseNumber) const {
+  if (getPhaseNumber <= STOP_TIMER)
+    return phaseCount[getPhaseNumber];
+  else
+    return 0;
+} // get_phaseCount
+
+
 uint8_t const MTD2A_timer::get_reset_error () {
   uint8_t tempErrorNumber = errorNumber;
   errorNumber = 0;
@@ -224,7 +268,9 @@ void MTD2A_timer::loop_fast () {
     case RESET_TIMER:
          loop_fast_start_reset ();
          loop_fast_pause_end   ();
+#if MTD2A_TIMER_WHEEL == 0
          loop_fast_calc_time   ();
+#endif
          loop_fast_timer_stop  ();
     break;
     case PAUSE_TIMER:
@@ -232,7 +278,9 @@ void MTD2A_timer::loop_fast () {
     break;
     case STOP_TIMER:
          loop_fast_pause_end   ();
+#if MTD2A_TIMER_WHEEL == 0
          loop_fast_calc_time   ();
+#endif
          loop_fast_timer_stop  ();
     break;
  }
@@ -246,12 +294,17 @@ void MTD2A_timer::loop_fast_start_reset () {
     beginPause    = false;
     endPause      = false;
     phaseChange   = true;
+    phaseCount[phaseNumber]++;
     processState  = ACTIVE;
     startTimeMS   = globalSyncTimeMS;
     remainTimeMS  = countDownMS;
     elapsedTimeMS = 0;
     pauseTimeMS   = 0;
     stopTimeMS    = 0;
+    overrunCount  = 0;
+#if MTD2A_TIMER_WHEEL > 0
+    wheel_insert (this, countDownMS);
+#endif
     print_phase_line ();
   }
 } // loop_fast_start
@@ -261,7 +314,11 @@ void MTD2A_timer::loop_fast_pause_begin () {
   if (beginPause == true) {
     beginPause    = false;
     phaseChange   = true;
+    phaseCount[phaseNumber]++;
     pauseBeginMS  = globalSyncTimeMS;
+#if MTD2A_TIMER_WHEEL > 0
+    wheel_remove (this);
+#endif
     print_phase_line ();
   }
 } // loop_fast_begin_pause
@@ -271,8 +328,17 @@ void MTD2A_timer::loop_fast_pause_end () {
   if (endPause == true) {
     endPause   = false;
     phaseChange = true;
+    if (phaseNumber != STOP_TIMER)  // Counted by loop_fast_timer_stop
+      phaseCount[phaseNumber]++;
     pauseEndMS  = globalSyncTimeMS;
     pauseTimeMS = pauseTimeMS + pauseEndMS - pauseBeginMS;
+#if MTD2A_TIMER_WHEEL > 0
+    // Continue with the remaining time (stop is handled by loop_fast_timer_stop)
+    if (phaseNumber != STOP_TIMER) {
+      wheel_calc_time ();
+      wheel_insert (this, remainTimeMS);
+    }
+#endif
     print_phase_line ();
   }
 } // loop_fast_end_pause
@@ -300,12 +366,28 @@ void MTD2A_timer::loop_fast_calc_time () {
 
 
 void MTD2A_timer::loop_fast_timer_stop () {
-  if ((remainTimeMS) == 0  ||  phaseNumber == STOP_TIMER ) {
+#if MTD2A_TIMER_WHEEL > 0
+  const bool timerExpired = wheelExpire;
+#else
+  const bool timerExpired = (remainTimeMS == 0);
+#endif
+  if (timerExpired == true  ||  phaseNumber == STOP_TIMER) {
     if (stopProcess == true) {
+      // Periodic mode continues unless stopped (STOP_TIMER) or no count down time
+      if (periodicMode == ENABLE  &&  phaseNumber != STOP_TIMER  &&  countDownMS > 0) {
+        loop_fast_period_reload ();
+        return;
+      }
+#if MTD2A_TIMER_WHEEL > 0
+      // Final remaining and elapsed time
+      wheel_calc_time ();
+      wheel_remove (this);
+#endif
       stopProcess  = false;
       phaseChange  = true;
       processState = COMPLETE;
       phaseNumber  = STOP_TIMER; 
+      phaseCount[phaseNumber]++;
       stopTimeMS   = globalSyncTimeMS;
       print_phase_line ();
     }
@@ -313,6 +395,129 @@ void MTD2A_timer::loop_fast_timer_stop () {
 } // loop_fast_timer
 
 
+void MTD2A_timer::loop_fast_period_reload () {
+  // The next period begins at the deadline, not at this loop: No drift. Whole periods passed are overruns
+  const uint32_t expiredMS   = globalSyncTimeMS - startTimeMS - pauseTimeMS;
+  const uint32_t periodCount = (expiredMS >= countDownMS) ? expiredMS / countDownMS : 1;
+  overrunCount  = overrunCount + periodCount - 1;
+  startTimeMS   = startTimeMS + periodCount * countDownMS;
+  elapsedTimeMS = globalSyncTimeMS - startTimeMS - pauseTimeMS;
+  if (elapsedTimeMS >= countDownMS)
+    elapsedTimeMS = 0;
+  remainTimeMS  = countDownMS - elapsedTimeMS;
+#if MTD2A_TIMER_WHEEL > 0
+  // Deadline: startTimeMS + pauseTimeMS + countDownMS
+  wheel_insert (this, remainTimeMS);
+#endif
+  // One loop STOP_TIMER phase. The timer stays ACTIVE and returns to the running phase next loop
+  phaseChange  = true;
+  phaseNumber  = STOP_TIMER;
+  phaseCount[phaseNumber]++;
+  stopTimeMS   = globalSyncTimeMS;
+  print_phase_line ();
+} // loop_fast_period_reload
+
+
+#if MTD2A_TIMER_WHEEL > 0
+// ========== Timing wheel
+
+
+void MTD2A_timer::wheel_calc_time () const {
+  // Remaining and elapsed time on demand. Frozen at pause begin and at stop
+  if (processState == ACTIVE  &&  stopProcess == true) {
+    const uint32_t calcTimeMS = (phaseNumber == PAUSE_TIMER) ? pauseBeginMS : globalSyncTimeMS;
+    elapsedTimeMS = calcTimeMS - startTimeMS - pauseTimeMS;
+    if (elapsedTimeMS >= countDownMS) {
+      remainTimeMS  = 0;
+      elapsedTimeMS = countDownMS;
+    }
+    else {
+      remainTimeMS = countDownMS - elapsedTimeMS;
+    }
+  }
+} // wheel_calc_time
+
+
+void MTD2A_timer::wheel_advance () {
+  // Empty wheel: Nothing to cascade or expire
+  if (wheelCount == 0) {
+    wheelTimeMS = globalSyncTimeMS;
+    return;
+  }
+  while (wheelTimeMS != globalSyncTimeMS  &&  wheelCount > 0) {
+    wheelTimeMS++;
+    // Cascade: A higher level slot moves down when the slot index of the level below wraps around to 0
+    for (uint8_t level {1}; level < WHEEL_LEVELS  &&  ((wheelTimeMS >> (WHEEL_BITS * (level - 1))) & (WHEEL_SLOTS - 1)) == 0; level++) {
+      MTD2A_timer **slotHead = &wheelSlot[level][(wheelTimeMS >> (WHEEL_BITS * level)) & (WHEEL_SLOTS - 1)];
+      MTD2A_timer *cascadeTimer = *slotHead;
+      *slotHead = nullptr;
+      while (cascadeTimer != nullptr) {
+        MTD2A_timer *nextTimer = cascadeTimer->wheelNext;
+        wheel_link (cascadeTimer);
+        cascadeTimer = nextTimer;
+      }
+    }
+    // Expire: Every timer in the level 0 slot has its deadline now
+    MTD2A_timer **slotHead = &wheelSlot[0][wheelTimeMS & (WHEEL_SLOTS - 1)];
+    MTD2A_timer *expireTimer = *slotHead;
+    *slotHead = nullptr;
+    while (expireTimer != nullptr) {
+      MTD2A_timer *nextTimer = expireTimer->wheelNext;
+      expireTimer->wheelNext   = nullptr;
+      expireTimer->wheelPrev   = nullptr;
+      expireTimer->wheelExpire = true;
+      wheelCount--;
+      expireTimer = nextTimer;
+    }
+  }
+  wheelTimeMS = globalSyncTimeMS;
+} // wheel_advance
+
+
+void MTD2A_timer::wheel_insert (MTD2A_timer *insertTimer, const uint32_t &insertRemainMS) {
+  wheel_remove (insertTimer);
+  if (insertRemainMS == 0) {
+    insertTimer->wheelExpire = true;
+    return;
+  }
+  if (wheelCount == 0)
+    wheelTimeMS = globalSyncTimeMS;
+  insertTimer->wheelDeadlineMS = globalSyncTimeMS + insertRemainMS;
+  wheelCount++;
+  wheel_link (insertTimer);
+} // wheel_insert
+
+
+void MTD2A_timer::wheel_link (MTD2A_timer *linkTimer) {
+  // Level by time to deadline, slot by deadline bits of the level
+  const uint32_t deltaMS = linkTimer->wheelDeadlineMS - wheelTimeMS;
+  uint8_t level {0};
+  while (level < WHEEL_LEVELS - 1  &&  (deltaMS >> (WHEEL_BITS * (level + 1))) != 0)
+    level++;
+  MTD2A_timer **slotHead = &wheelSlot[level][(linkTimer->wheelDeadlineMS >> (WHEEL_BITS * level)) & (WHEEL_SLOTS - 1)];
+  linkTimer->wheelNext = *slotHead;
+  if (*slotHead != nullptr)
+    (*slotHead)->wheelPrev = &linkTimer->wheelNext;
+  linkTimer->wheelPrev = slotHead;
+  *slotHead = linkTimer;
+} // wheel_link
+
+
+void MTD2A_timer::wheel_remove (MTD2A_timer *removeTimer) {
+  removeTimer->wheelExpire = false;
+  if (removeTimer->wheelPrev != nullptr) {
+    *removeTimer->wheelPrev = removeTimer->wheelNext;
+    if (removeTimer->wheelNext != nullptr)
+      removeTimer->wheelNext->wheelPrev = removeTimer->wheelPrev;
+    removeTimer->wheelNext = nullptr;
+    removeTimer->wheelPrev = nullptr;
+    wheelCount--;
+  }
+} // wheel_remove
+// ========== Timing wheel
+#endif
+
+
 uint32_t MTD2A_timer::check_set_time (const uint32_t &setCheckTimeMS) {
   if (countDownMS == 0) {
     print_error_text (140);
@@ -326,16 +531,95 @@ uint32_t MTD2A_timer::check_set_time (const uint32_t &setCheckTimeMS) {
 } // check_set_time
 
 
+#if MTD2A_OBJECT_STATE > 0
+void MTD2A_timer::MTD2A_snapshot_state (MTD2A_snapshot_record &snapshotRecord) const {
+  // timeMS: Running: Deadline (globalSyncTimeMS at expiry). Otherwise remaining count down time (frozen)
+  snapshotRecord.objectType  = SNAPSHOT_TIMER;
+  snapshotRecord.phaseNumber = phaseNumber;
+  snapshotRecord.stateFlags  = (uint8_t)(processState | (phaseChange << 1));
+  snapshotRecord.errorNumber = errorNumber;
+  snapshotRecord.pinNumber   = PIN_ERROR_NO;
+  if (processState == ACTIVE  &&  stopProcess == true  &&  phaseNumber != PAUSE_TIMER)
+    snapshotRecord.timeMS    = startTimeMS + pauseTimeMS + countDownMS;
+  else {
+#if MTD2A_TIMER_WHEEL > 0
+    wheel_calc_time ();
+#endif
+    snapshotRecord.timeMS    = remainTimeMS;
+  }
+} // MTD2A_snapshot_state
+#endif
+
+
+bool MTD2A_timer::MTD2A_link_action (const uint8_t &linkAction, const uint8_t &actionValue, const bool &executeAction) {
+  (void)actionValue;
+  switch (linkAction) {
+    case LINK_ACTIVATE: if (executeAction) timer (START_TIMER); return true;
+    case LINK_RESET:    if (executeAction) timer (RESET_TIMER); return true;
+    case LINK_STOP:     if (executeAction) timer (STOP_TIMER);  return true;
+    case LINK_PAUSE:    if (executeAction) timer (PAUSE_TIMER); return true;
+  }
+  return false;
+} // MTD2A_link_action
+
+
+#if MTD2A_CONFIG > 0
+bool MTD2A_timer::MTD2A_config_field (const uint8_t &fieldId, const uint32_t &fieldValue, const bool &applyField) {
+  // Values are validated by MTD2A_config_check ()
+  switch (fieldId) {
+    case CONFIG_COUNT_DOWN: if (applyField) countDownMS = fieldValue; return true;
+  }
+  return false;
+} // MTD2A_config_field
+#endif
+
+
+#if MTD2A_WARM > 0
+bool MTD2A_timer::MTD2A_warm_restore (const MTD2A_snapshot_record &warmRecord) {
+  // timeMS: Deadline on the clock of the last warm save. PAUSE_TIMER: Remaining count down time
+  // ACTIVE in STOP_TIMER phase: Periodic mode period end
+  if ((warmRecord.stateFlags & 1) != ACTIVE)
+    return false;
+  if (warmRecord.phaseNumber == PAUSE_TIMER)
+    remainTimeMS = min(warmRecord.timeMS, countDownMS);
+  else {
+    const int32_t deadlineMS = (int32_t)(warmRecord.timeMS - MTD2A_warm_time ());
+    remainTimeMS = (deadlineMS > 0) ? min((uint32_t)deadlineMS, countDownMS) : 0;
+  }
+  elapsedTimeMS  = countDownMS - remainTimeMS;
+  startTimeMS    = globalSyncTimeMS - elapsedTimeMS;
+  pauseTimeMS    = 0;
+  processState   = ACTIVE;
+  startProcess   = false;
+  stopProcess    = true;
+  beginPause     = false;
+  endPause       = false;
+  phaseNumber    = (warmRecord.phaseNumber == PAUSE_TIMER) ? PAUSE_TIMER : START_TIMER;
+  setPhaseNumber = phaseNumber;
+  pauseBeginMS   = globalSyncTimeMS;
+#if MTD2A_TIMER_WHEEL > 0
+  if (phaseNumber == START_TIMER)
+    wheel_insert (this, remainTimeMS);
+#endif
+  return true;
+} // MTD2A_warm_restore
+#endif
+
+
 void MTD2A_timer::print_phase_line () {
-  if (debugPrint == ENABLE  ||  globalDebugPrint == ENABLE) {
-    MTD2A_print_object_name (objectName);
+  MTD2A_trace_phase (phaseNumber);
+#if MTD2A_LOG_LEVEL >= MTD2A_LOG_DEBUG
+  if (globalTraceMode == TRACE_OFF  &&  (debugPrint == ENABLE  ||  globalDebugPrint == ENABLE)) {
+    MTD2A_print_object_name ();
     PortPrint(F(" "));
     print_phase_text ();
   }
+#endif
 } // print_phase_line
 
 
 void MTD2A_timer::print_phase_text () {
+#if MTD2A_LOG_LEVEL >= MTD2A_LOG_DEBUG
   switch(phaseNumber) {
     case 0: PortPrint(F("[0] Reset"));  break;
     case 1: PortPrint(F("[1] Start"));  break;
@@ -343,23 +627,33 @@ void MTD2A_timer::print_phase_text () {
     case 3: PortPrint(F("[3] Stop"));   break;
   }
   PortPrintln(F(" timer"));    
+#endif
 } // print_phase_text
 
 
 void MTD2A_timer::print_error_text (const uint8_t setErrorNumber) {
   errorNumber = setErrorNumber;
-  MTD2A_print_object_name (objectName);
-  MTD2A_print_error_text ((debugPrint == ENABLE || errorPrint == ENABLE), errorNumber, NO_PRINT_PIN);
+  MTD2A_trace_phase (phaseNumber, errorNumber);
+  if (globalTraceMode == TRACE_OFF) {
+    MTD2A_print_object_name ();
+    MTD2A_print_error_text ((debugPrint == ENABLE || errorPrint == ENABLE), errorNumber, NO_PRINT_PIN);
+  }
 } // print_error_text
 
 
 void MTD2A_timer::print_conf () {
+#if MTD2A_LOG_LEVEL >= MTD2A_LOG_DEBUG
+#if MTD2A_TIMER_WHEEL > 0
+  wheel_calc_time ();
+#endif
   PortPrintln(F("MTD2A_timer: "));
-  MTD2A_print_name_state (objectName, processState);
+  MTD2A_print_name_state (processState);
   PortPrint  (F("  phaseText    : ")); print_phase_text ();
   MTD2A_print_debug_error (debugPrint, errorPrint, errorNumber);
   // timers
   PortPrint  (F("  countDownMS  : ")); PortPrintln(countDownMS);
+  PortPrint  (F("  periodicMode : ")); PortPrintln(periodicMode);
+  PortPrint  (F("  overrunCount : ")); PortPrintln(overrunCount);
   PortPrint  (F("  remainTimeMS : ")); PortPrintln(remainTimeMS);
   PortPrint  (F("  elapsedTimeMS: ")); PortPrintln(elapsedTimeMS);
   PortPrint  (F("  startTimeMS  : ")); PortPrintln(startTimeMS);
@@ -367,5 +661,6 @@ void MTD2A_timer::print_conf () {
   PortPrint  (F("  pauseTimeMS  : ")); PortPrintln(pauseTimeMS);
   PortPrint  (F("  pauseBeginMS : ")); PortPrintln(pauseBeginMS);
   PortPrint  (F("  pauseEndMS   : ")); PortPrintln(pauseEndMS);
+#endif
 } // print_conf 
 
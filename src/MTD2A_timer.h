@@ -40,6 +40,8 @@
 
 class MTD2A_timer: public MTD2A
 { 
+  friend class MTD2A;  // MTD2A_loop_execute () advances the timing wheel
+
   private:
     // Specific global constants from MTD2A_binary_output.h (MTD2A_const.h)
     static constexpr uint8_t  RESET_TIMER  {MTD2A_const::RESET_TIMER};
@@ -48,16 +50,26 @@ class MTD2A_timer: public MTD2A
     static constexpr uint8_t  STOP_TIMER   {MTD2A_const::STOP_TIMER};
     // MTD2A_base
     static constexpr uint8_t  NO_PRINT_PIN {MTD2A::NO_PRINT_PIN};
+#if MTD2A_TIMER_WHEEL > 0
+    // Hierarchical timing wheel. Level 0: 1 ms slots. Each level 16 times the slot time of the level below (32 bit range)
+    static constexpr uint8_t  WHEEL_LEVELS {8};
+    static constexpr uint8_t  WHEEL_SLOTS  {16};
+    static constexpr uint8_t  WHEEL_BITS   {4};
+    static MTD2A_timer *wheelSlot[WHEEL_LEVELS][WHEEL_SLOTS]; // Timers linked per slot
+    static uint32_t     wheelTimeMS;  // Last advanced millisecond
+    static uint16_t     wheelCount;   // Timers in the wheel
+#endif
 
     // Arguments
-    char    *objectName    {nullptr};     // Constructor initialized (User defined name to display identification)
     uint32_t countDownMS   {0};           // Constructor default argument. Milliseconds
+    bool     periodicMode  {DISABLE};     // set_periodic () ENABLE = reload from the deadline at expiry
     // Timers
     uint32_t startTimeMS   {0};           // get_startTimeMS   () Milliseconds
     uint32_t stopTimeMS    {0};           // get_stopTimeMS    () Milliseconds
-    uint32_t remainTimeMS  {0};           // get_remainTimeMS  () Milliseconds
-    uint32_t elapsedTimeMS {0};           // get_elapsedTimeMS () Milliseconds
+    mutable uint32_t remainTimeMS  {0};   // get_remainTimeMS  () Milliseconds (timing wheel: calculated by the getter)
+    mutable uint32_t elapsedTimeMS {0};   // get_elapsedTimeMS () Milliseconds (timing wheel: calculated by the getter)
     uint32_t pauseTimeMS   {0};           // get_pauseTimeMS   () Milliseconds
+    uint32_t overrunCount  {0};           // get_overrunCount  () Missed periods (periodic mode)
     // Debug and error
     bool     debugPrint    {DISABLE};     // set_debugPrint  () default argument / ENABLE
     bool     errorPrint    {DISABLE};     // set_errorPrint  () default argument / ENABLE
@@ -67,6 +79,7 @@ class MTD2A_timer: public MTD2A
     bool     phaseChange   {false};       // true = change in timing state (one loop)
     uint8_t  phaseNumber   {STOP_TIMER};  // RESET_TIMER = 0, START_TIMER = 1, PAUSE_TIMER = 2, STOP_TIMER = 3
     uint8_t  setPhaseNumber{STOP_TIMER};  // Set phase number to execute (loop_fast ();)
+    uint16_t phaseCount[STOP_TIMER + 1] {0}; // get_phaseCount () Phase transitions per phase (uint16_t wrap around)
     // Pause timers
     uint32_t pauseBeginMS  {0};           // Timer begin pause milliseconds
     uint32_t pauseEndMS    {0};           // Timer end pause milliseconds
@@ -75,6 +88,13 @@ class MTD2A_timer: public MTD2A
     bool     stopProcess   {false};       // Control executing flags
     bool     beginPause    {false};       // Control executing flags
     bool     endPause      {false};       // Control executing flags
+#if MTD2A_TIMER_WHEEL > 0
+    // Timing wheel
+    uint32_t      wheelDeadlineMS {0};       // Expiry time
+    MTD2A_timer  *wheelNext       {nullptr}; // Next timer in slot
+    MTD2A_timer **wheelPrev       {nullptr}; // Slot head or previous timer next pointer. nullptr = not in the wheel
+    bool          wheelExpire     {false};   // Deadline reached (wheel_advance)
+#endif
 
  public:
     // Constructor inittializers
@@ -88,13 +108,17 @@ class MTD2A_timer: public MTD2A
       const char    *setObjectName  = "Object name", 
       const uint32_t setCountDownMS = 0
     );
+    // F("Object name") flash memory name (only legal inside functions). Names are not copied, see set_objectName ()
+    MTD2A_timer (
+      const __FlashStringHelper *setObjectName,
+      const uint32_t setCountDownMS = 0
+    );
 
     // Destructor
     ~MTD2A_timer () { 
-      if (objectName != nullptr) {
-        delete [] objectName; 
-        objectName = nullptr;
-      }
+#if MTD2A_TIMER_WHEEL > 0
+      wheel_remove (this);
+#endif
       if (globalObjectCount > 0 )
         globalObjectCount--;
     };    
@@ -154,6 +178,16 @@ class MTD2A_timer: public MTD2A
     void set_countDownMS (const uint32_t &setCountDownMS);
 
 
+    /**
+     * @brief Periodic mode: At expiry the timer reloads from its own deadline (no drift) and continues ACTIVE.
+     * @brief Each period ends with a STOP_TIMER phase change (one loop) and set_callback (..., (1 << STOP_TIMER)) is called.
+     * @name object_name.set_periodic
+     * @param ( {ENABLE | DISABLE} );
+     * @return none
+     */
+    void set_periodic (const bool &setEnableOrDisable = ENABLE);
+
+
     /**
      * @brief Enable print phase state number, phase state text and error text.
      * @name object_name.set_debugPrint
@@ -219,6 +253,15 @@ class MTD2A_timer: public MTD2A
     uint32_t const &get_elapsedTimeMS () const;
 
 
+    /**
+     * @brief get number of missed periods in periodic mode (a loop later than one or more whole periods). Reset by start and reset
+     * @name object_name.get_overrunCount ();
+     * @param none
+     * @return unit32_t count
+     */
+    uint32_t const &get_overrunCount () const;
+
+
     /**
      * @brief Get processState  
      * @name object_name.get_processState ();
@@ -246,6 +289,15 @@ class MTD2A_timer: public MTD2A
     uint8_t const &get_phaseNumber () const;
 
 
+    /**
+     * @brief get number of transitions to a phase. Counter wraps around at 65535
+     * @name object_name.get_phaseCount
+     * @param ( {RESET_TIMER | START_TIMER | PAUSE_TIMER | STOP_TIMER} );
+     * @return uint16_t count
+     */  
+    uint16_t get_phaseCount (const uint8_t &getPhaseNumber) const;
+
+
     /**
      * @brief Get and reset error number to zero 
      * @name object_name.get_reset_error ();
@@ -271,6 +323,25 @@ class MTD2A_timer: public MTD2A
     void     loop_fast_pause_end   ();
     void     loop_fast_calc_time   ();
     void     loop_fast_timer_stop  ();
+    void     loop_fast_period_reload ();
+#if MTD2A_TIMER_WHEEL > 0
+    // Timing wheel
+    void        wheel_calc_time () const;
+    static void wheel_advance   ();
+    static void wheel_insert    (MTD2A_timer *insertTimer, const uint32_t &insertRemainMS);
+    static void wheel_link      (MTD2A_timer *linkTimer);
+    static void wheel_remove    (MTD2A_timer *removeTimer);
+#endif
+#if MTD2A_OBJECT_STATE > 0
+    void     MTD2A_snapshot_state (MTD2A_snapshot_record &snapshotRecord) const override;
+#endif
+    bool     MTD2A_link_action    (const uint8_t &linkAction, const uint8_t &actionValue, const bool &executeAction) override;
+#if MTD2A_CONFIG > 0
+    bool     MTD2A_config_field   (const uint8_t &fieldId, const uint32_t &fieldValue, const bool &applyField) override;
+#endif
+#if MTD2A_WARM > 0
+    bool     MTD2A_warm_restore   (const MTD2A_snapshot_record &warmRecord) override;
+#endif
     // print
     void     print_phase_line ();
     void     print_phase_text ();